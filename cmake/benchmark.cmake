@@ -0,0 +1,16 @@
+if (WITH_BENCHMARK)
+    add_definitions(/DXMRIG_FEATURE_BENCHMARK)
+
+    list(APPEND HEADERS
+        src/core/bench/BenchConfig.h
+        src/core/bench/Benchmark.h
+        src/core/bench/interfaces/IBenchListener.h
+    )
+
+    list(APPEND SOURCES
+        src/core/bench/BenchConfig.cpp
+        src/core/bench/Benchmark.cpp
+    )
+else()
+    remove_definitions(/DXMRIG_FEATURE_BENCHMARK)
+endif()
@@ -0,0 +1,15 @@
+if (WITH_POOL_SIM)
+    add_definitions(/DXMRIG_FEATURE_POOL_SIM)
+
+    list(APPEND HEADERS
+        src/net/sim/SimConfig.h
+        src/net/sim/SimPool.h
+    )
+
+    list(APPEND SOURCES
+        src/net/sim/SimConfig.cpp
+        src/net/sim/SimPool.cpp
+    )
+else()
+    remove_definitions(/DXMRIG_FEATURE_POOL_SIM)
+endif()
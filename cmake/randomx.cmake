@@ -69,6 +69,15 @@ if (WITH_RANDOMX)
         set_source_files_properties(src/crypto/randomx/jit_compiler_x86.cpp PROPERTIES COMPILE_FLAGS -Wno-unused-const-variable)
     endif()
 
+    if (WITH_PROFILING)
+        add_definitions(/DXMRIG_FEATURE_PROFILING)
+
+        list(APPEND HEADERS_CRYPTO src/crypto/rx/RxProfiler.h)
+        list(APPEND SOURCES_CRYPTO src/crypto/rx/RxProfiler.cpp)
+    else()
+        remove_definitions(/DXMRIG_FEATURE_PROFILING)
+    endif()
+
     if (WITH_HWLOC)
         list(APPEND HEADERS_CRYPTO
              src/crypto/rx/RxNUMAStorage.h
@@ -0,0 +1,16 @@
+if (WITH_ZLIB AND WITH_HTTP)
+    set(ZLIB_ROOT ${XMRIG_DEPS})
+
+    find_package(ZLIB)
+
+    if (ZLIB_FOUND)
+        include_directories(${ZLIB_INCLUDE_DIRS})
+    else()
+        message(FATAL_ERROR "zlib NOT found: use `-DWITH_ZLIB=OFF` to build without HTTP API compression")
+    endif()
+
+    add_definitions(/DXMRIG_FEATURE_ZLIB)
+else()
+    set(ZLIB_LIBRARIES "")
+    remove_definitions(/DXMRIG_FEATURE_ZLIB)
+endif()
@@ -40,6 +40,14 @@
 #include "net/Network.h"
 #include "Summary.h"
 #include "version.h"
+
+
+#ifdef XMRIG_FEATURE_BENCHMARK
+#   include "core/bench/BenchConfig.h"
+#   include "core/bench/Benchmark.h"
+#endif
+
+
 #include <utmpx.h>
 #include <unistd.h>
 #include <thread>
@@ -57,6 +65,10 @@ xmrig::App::App(Process *process)
 
 xmrig::App::~App()
 {
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    delete m_benchmark;
+#   endif
+
     delete m_signals;
     delete m_console;
     delete m_controller;
@@ -131,9 +143,22 @@ int xmrig::App::exec()
 
     m_controller->start();
 
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    if (m_controller->config()->benchmark().isEnabled()) {
+        m_benchmark = new Benchmark(m_controller, this);
+        m_benchmark->start();
+    }
+#   endif
+
     rc = uv_run(uv_default_loop(), UV_RUN_DEFAULT);
     uv_loop_close(uv_default_loop());
 
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    if (m_benchmark) {
+        return m_rc;
+    }
+#   endif
+
     return rc;
 }
 
@@ -174,8 +199,24 @@ void xmrig::App::onSignal(int signum)
 }
 
 
+#ifdef XMRIG_FEATURE_BENCHMARK
+void xmrig::App::onBenchDone(int rc)
+{
+    m_rc = rc;
+
+    close();
+}
+#endif
+
+
 void xmrig::App::close()
 {
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    if (m_benchmark) {
+        m_benchmark->stop();
+    }
+#   endif
+
     m_signals->stop();
 
     if (m_console) {
@@ -32,9 +32,15 @@
 #include "base/tools/Object.h"
 
 
+#ifdef XMRIG_FEATURE_BENCHMARK
+#   include "core/bench/interfaces/IBenchListener.h"
+#endif
+
+
 namespace xmrig {
 
 
+class Benchmark;
 class Console;
 class Controller;
 class Network;
@@ -43,6 +49,9 @@ class Signals;
 
 
 class App : public IConsoleListener, public ISignalListener
+#ifdef XMRIG_FEATURE_BENCHMARK
+    , public IBenchListener
+#endif
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(App)
@@ -56,6 +65,10 @@ protected:
     void onConsoleCommand(char command) override;
     void onSignal(int signum) override;
 
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    void onBenchDone(int rc) override;
+#   endif
+
 private:
     bool background(int &rc);
     void close();
@@ -63,6 +76,11 @@ private:
     Console *m_console          = nullptr;
     Controller *m_controller    = nullptr;
     Signals *m_signals          = nullptr;
+
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    Benchmark *m_benchmark      = nullptr;
+    int m_rc                    = 0;
+#   endif
 };
 
 
@@ -25,11 +25,13 @@
 
 #include <cinttypes>
 #include <cstdio>
+#include <string>
 #include <uv.h>
 
 
 #include "backend/cpu/Cpu.h"
 #include "base/io/log/Log.h"
+#include "base/kernel/Cgroup.h"
 #include "base/net/stratum/Pool.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
@@ -119,6 +121,23 @@ static void print_memory()
 }
 
 
+static void print_cgroup()
+{
+    if (!Cgroup::isLimited()) {
+        return;
+    }
+
+    constexpr uint64_t oneMiB = 1024U * 1024U;
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") "v%d" BLACK_BOLD(" cpus:") CYAN_BOLD("%s") BLACK_BOLD(" memory:") CYAN_BOLD("%s"),
+               "CGROUP",
+               Cgroup::version(),
+               Cgroup::cpus() ? std::to_string(Cgroup::cpus()).c_str() : "max",
+               Cgroup::memoryLimit() ? (std::to_string(Cgroup::memoryLimit() / oneMiB) + " MB").c_str() : "max"
+               );
+}
+
+
 static void print_threads(Config *config)
 {
     Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") WHITE_BOLD("%s%d%%"),
@@ -140,15 +159,24 @@ static void print_threads(Config *config)
 }
 
 
-static void print_commands(Config *)
+static void print_commands(Config *config)
 {
+#   ifdef XMRIG_FEATURE_PERF
+    const bool counters = config->cpu().isPerfCounters();
+#   else
+    const bool counters = false;
+    (void) config;
+#   endif
+
     if (Log::colors) {
         Log::print(GREEN_BOLD(" * ") WHITE_BOLD("COMMANDS     ") MAGENTA_BG(WHITE_BOLD_S "h") WHITE_BOLD("ashrate, ")
                                                                      MAGENTA_BG(WHITE_BOLD_S "p") WHITE_BOLD("ause, ")
-                                                                     MAGENTA_BG(WHITE_BOLD_S "r") WHITE_BOLD("esume"));
+                                                                     MAGENTA_BG(WHITE_BOLD_S "r") WHITE_BOLD("esume%s") "%s",
+                   counters ? ", " : "",
+                   counters ? MAGENTA_BG(WHITE_BOLD_S "c") WHITE_BOLD("ounters") : "");
     }
     else {
-        Log::print(" * COMMANDS     'h' hashrate, 'p' pause, 'r' resume");
+        Log::print(" * COMMANDS     'h' hashrate, 'p' pause, 'r' resume%s", counters ? ", 'c' counters" : "");
     }
 }
 
@@ -162,6 +190,7 @@ void xmrig::Summary::print(Controller *controller)
     print_memory(controller->config());
     print_cpu(controller->config());
     print_memory();
+    print_cgroup();
     print_threads(controller->config());
     controller->config()->pools().print();
 
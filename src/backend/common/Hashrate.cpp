@@ -23,6 +23,7 @@
  */
 
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <memory.h>
@@ -150,6 +151,15 @@ void xmrig::Hashrate::add(size_t threadId, uint64_t count, uint64_t timestamp)
 }
 
 
+void xmrig::Hashrate::reset(size_t threadId)
+{
+    std::fill_n(m_counts[threadId], kBucketSize, 0);
+    std::fill_n(m_timestamps[threadId], kBucketSize, 0);
+
+    m_top[threadId] = 0;
+}
+
+
 const char *xmrig::Hashrate::format(double h, char *buf, size_t size)
 {
     return ::format(h, buf, size);
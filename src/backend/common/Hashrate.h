@@ -53,6 +53,7 @@ public:
     double calc(size_t ms) const;
     double calc(size_t threadId, size_t ms) const;
     void add(size_t threadId, uint64_t count, uint64_t timestamp);
+    void reset(size_t threadId);
 
     inline size_t threads() const { return m_threads; }
 
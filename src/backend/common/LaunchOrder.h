@@ -0,0 +1,76 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_LAUNCHORDER_H
+#define XMRIG_LAUNCHORDER_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <condition_variable>
+#include <mutex>
+
+
+namespace xmrig {
+
+
+/**
+ * Lets threads started together create their workers one after another in a fixed order, so adjacent cores get
+ * adjacent scratchpads, while thread creation, self-test and everything after it run in parallel.
+ */
+class LaunchOrder
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(LaunchOrder)
+
+    LaunchOrder() = default;
+
+    inline void wait(size_t turn)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this, turn] { return m_turn >= turn; });
+    }
+
+    inline void next()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_turn;
+        }
+
+        m_cv.notify_all();
+    }
+
+private:
+    size_t m_turn = 0;
+    std::condition_variable m_cv;
+    std::mutex m_mutex;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_LAUNCHORDER_H */
@@ -0,0 +1,78 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018      Lee Clagett <https://github.com/vtnerd>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_NUMALOCALITY_H
+#define XMRIG_NUMALOCALITY_H
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class NUMALocality
+{
+public:
+    enum Region : uint32_t {
+        Scratchpad,
+        Code,
+        RegionMax
+    };
+
+    enum Node : int32_t {
+        Unknown = -1,
+        Mixed   = -2
+    };
+
+    static inline const char *name(Region region)
+    {
+        static const char *names[RegionMax] = { "scratchpad", "code" };
+
+        return region < RegionMax ? names[region] : nullptr;
+    }
+
+    inline bool isValid() const { return node >= 0; }
+
+    inline bool isLocal() const
+    {
+        for (int32_t value : regions) {
+            if (value != Unknown && value != node) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    int32_t node                = Unknown;
+    int32_t regions[RegionMax]  = { Unknown, Unknown };
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_NUMALOCALITY_H */
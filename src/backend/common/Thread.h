@@ -27,9 +27,13 @@
 
 
 #include "backend/common/interfaces/IWorker.h"
+#include "backend/common/LaunchOrder.h"
+#include "backend/common/Worker.h"
 #include "base/tools/Object.h"
 
 
+#include <atomic>
+#include <memory>
 #include <thread>
 
 
@@ -46,20 +50,118 @@ public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Thread)
 
     inline Thread(IBackend *backend, size_t id, const T &config) : m_id(id), m_config(config), m_backend(backend) {}
-    inline ~Thread() { m_thread.join(); delete m_worker; }
+    inline ~Thread() { join(); delete m_worker; }
 
+    inline bool isStopped() const                   { return m_stopped; }
     inline const T &config() const                  { return m_config; }
     inline IBackend *backend() const                { return m_backend; }
     inline IWorker *worker() const                  { return m_worker; }
+    inline LaunchOrder *order() const               { return m_order.get(); }
     inline size_t id() const                        { return m_id; }
-    inline void setWorker(IWorker *worker)          { m_worker = worker; }
+    inline size_t turn() const                      { return m_turn; }
     inline void start(void (*callback) (void *))    { m_thread = std::thread(callback, this); }
 
+    // Runtime state is kept by the handle, a worker that is still being created picks it up in setWorker().
+    inline void retune(int64_t affinity, int priority)
+    {
+        m_affinity = affinity;
+        m_priority = priority;
+        m_retuned  = true;
+
+        IWorker *worker = m_worker;
+        if (worker) {
+            worker->retune(affinity, priority);
+        }
+    }
+
+    inline void setDuty(uint32_t duty)
+    {
+        m_duty = duty;
+
+        IWorker *worker = m_worker;
+        if (worker) {
+            worker->setDuty(duty);
+        }
+    }
+
+    inline void setParked(bool parked)
+    {
+        m_parked = parked;
+
+        IWorker *worker = m_worker;
+        if (worker) {
+            worker->setParked(parked);
+        }
+    }
+
+    // Carries duty, park state and retuned affinity over to a replacement of the same thread.
+    inline void restore(const Thread &other)
+    {
+        m_duty   = other.m_duty.load();
+        m_parked = other.m_parked.load();
+
+        if (other.m_retuned) {
+            retune(other.m_affinity, other.m_priority);
+        }
+    }
+
+    inline void setOrder(const std::shared_ptr<LaunchOrder> &order, size_t turn)
+    {
+        m_order = order;
+        m_turn  = turn;
+    }
+
+    inline void setWorker(IWorker *worker)
+    {
+        m_worker = worker;
+        worker->setDuty(m_duty);
+
+        if (m_parked) {
+            worker->setParked(true);
+        }
+
+        if (m_retuned) {
+            worker->retune(m_affinity, m_priority);
+        }
+
+        if (m_stopped) {
+            worker->stop();
+        }
+    }
+
+    // Stop only this thread, the worker pointer is stable after return.
+    inline void stop()
+    {
+        m_stopped = true;
+
+        IWorker *worker = m_worker;
+        if (worker) {
+            worker->stop();
+        }
+
+        join();
+    }
+
 private:
+    inline void join()
+    {
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
     const size_t m_id    = 0;
     const T m_config;
     IBackend *m_backend;
-    IWorker *m_worker       = nullptr;
+    size_t m_turn        = 0;
+    std::shared_ptr<LaunchOrder> m_order;
+    std::atomic<bool> m_parked{ false };
+    std::atomic<bool> m_retuned{ false };
+    std::atomic<bool> m_stopped{ false };
+    std::atomic<int> m_priority{ -1 };
+    std::atomic<int64_t> m_affinity{ -1 };
+    std::atomic<uint32_t> m_duty{ Worker::kMaxDuty };
+    std::atomic<IWorker *> m_worker{ nullptr };
     std::thread m_thread;
 };
 
@@ -24,6 +24,11 @@
  */
 
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+
 #include "backend/common/Worker.h"
 #include "base/kernel/Platform.h"
 #include "base/tools/Chrono.h"
@@ -33,6 +38,12 @@
 xmrig::Worker::Worker(size_t id, int64_t affinity, int priority) :
     m_affinity(affinity),
     m_id(id),
+    m_parked(false),
+    m_retune(false),
+    m_stopped(false),
+    m_duty(kMaxDuty),
+    m_nextPriority(priority),
+    m_nextAffinity(affinity),
     m_hashCount(0),
     m_timestamp(0)
 {
@@ -43,8 +54,71 @@ xmrig::Worker::Worker(size_t id, int64_t affinity, int priority) :
 }
 
 
+void xmrig::Worker::retune(int64_t affinity, int priority)
+{
+    m_nextAffinity.store(affinity, std::memory_order_relaxed);
+    m_nextPriority.store(priority, std::memory_order_relaxed);
+    m_retune.store(true, std::memory_order_release);
+}
+
+
+void xmrig::Worker::applyRetune()
+{
+    if (!m_retune.exchange(false, std::memory_order_acquire)) {
+        return;
+    }
+
+    const int64_t affinity = m_nextAffinity.load(std::memory_order_relaxed);
+    if (affinity != m_affinity) {
+        m_affinity = affinity;
+        Platform::trySetThreadAffinity(affinity);
+    }
+
+    Platform::setThreadPriority(m_nextPriority.load(std::memory_order_relaxed));
+}
+
+
 void xmrig::Worker::storeStats()
 {
     m_hashCount.store(m_count, std::memory_order_relaxed);
     m_timestamp.store(Chrono::highResolutionMSecs(), std::memory_order_relaxed);
 }
+
+
+/**
+ * Sleeps in proportion to the time spent hashing since the previous pause, so the thread is busy only duty/1000 of the time.
+ * Called after every hash, work is accumulated for at least 50 ms to keep pauses long enough for the millisecond clock
+ * and the scheduler. The pause is not capped, it is slept in short slices to stay responsive to stop requests.
+ */
+void xmrig::Worker::throttle()
+{
+    const uint32_t duty = m_duty.load(std::memory_order_relaxed);
+    if (duty >= kMaxDuty) {
+        m_busyTs = 0;
+
+        return;
+    }
+
+    const uint64_t now = Chrono::highResolutionMSecs();
+    if (m_busyTs == 0) {
+        m_busyTs = now;
+
+        return;
+    }
+
+    const uint64_t busy = now - m_busyTs;
+    if (busy < 50) {
+        return;
+    }
+
+    uint64_t pause = (busy * (kMaxDuty - duty) + duty / 2) / std::max(duty, 1U);
+
+    while (pause > 0 && !isStopped()) {
+        const uint64_t slice = std::min<uint64_t>(pause, 100);
+        std::this_thread::sleep_for(std::chrono::milliseconds(slice));
+
+        pause -= slice;
+    }
+
+    m_busyTs = Chrono::highResolutionMSecs();
+}
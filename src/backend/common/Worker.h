@@ -40,21 +40,43 @@ namespace xmrig {
 class Worker : public IWorker
 {
 public:
+    static constexpr uint32_t kMaxDuty = 1000;
+
     Worker(size_t id, int64_t affinity, int priority);
 
-    inline const VirtualMemory *memory() const override { return nullptr; }
-    inline size_t id() const override                   { return m_id; }
-    inline uint64_t hashCount() const override          { return m_hashCount.load(std::memory_order_relaxed); }
-    inline uint64_t timestamp() const override          { return m_timestamp.load(std::memory_order_relaxed); }
+    inline const PerfCounters *counters() const override { return nullptr; }
+    inline const VirtualMemory *memory() const override  { return nullptr; }
+    inline NUMALocality locality() const override        { return NUMALocality(); }
+    inline size_t id() const override                    { return m_id; }
+    inline uint64_t hashCount() const override           { return m_hashCount.load(std::memory_order_relaxed); }
+    inline uint64_t timestamp() const override           { return m_timestamp.load(std::memory_order_relaxed); }
+    inline void setDuty(uint32_t duty) override          { m_duty.store(duty, std::memory_order_relaxed); }
+    inline void setParked(bool parked) override          { m_parked.store(parked, std::memory_order_relaxed); }
+    inline void stop() override                          { m_stopped.store(true, std::memory_order_relaxed); }
+
+    void retune(int64_t affinity, int priority) override;
 
 protected:
+    inline bool isParked() const                         { return m_parked.load(std::memory_order_relaxed); }
+    inline bool isRetune() const                         { return m_retune.load(std::memory_order_relaxed); }
+    inline bool isStopped() const                        { return m_stopped.load(std::memory_order_relaxed); }
+
+    void applyRetune();
     void storeStats();
+    void throttle();
 
-    const int64_t m_affinity;
+    int64_t m_affinity;
     const size_t m_id;
+    std::atomic<bool> m_parked;
+    std::atomic<bool> m_retune;
+    std::atomic<bool> m_stopped;
+    std::atomic<uint32_t> m_duty;
+    std::atomic<int> m_nextPriority;
+    std::atomic<int64_t> m_nextAffinity;
     std::atomic<uint64_t> m_hashCount;
     std::atomic<uint64_t> m_timestamp;
     uint32_t m_node     = 0;
+    uint64_t m_busyTs   = 0;
     uint64_t m_count    = 0;
 };
 
@@ -32,6 +32,9 @@
 #include "base/tools/Object.h"
 
 
+#include <algorithm>
+
+
 #ifdef XMRIG_FEATURE_OPENCL
 #   include "backend/opencl/OclWorker.h"
 #endif
@@ -62,6 +65,13 @@ public:
 
     Hashrate *hashrate = nullptr;
     IBackend *backend  = nullptr;
+    uint32_t duty      = Worker::kMaxDuty;
+    std::vector<NUMALocality> locality;
+
+#   ifdef XMRIG_FEATURE_PERF
+    std::vector<PerfCounters::Sample> counters;
+    std::vector<PerfCounters::Sample> recent;
+#   endif
 };
 
 
@@ -90,6 +100,99 @@ const xmrig::Hashrate *xmrig::Workers<T>::hashrate() const
 }
 
 
+template<class T>
+const std::vector<xmrig::NUMALocality> &xmrig::Workers<T>::locality() const
+{
+    return d_ptr->locality;
+}
+
+
+#ifdef XMRIG_FEATURE_PERF
+template<class T>
+const std::vector<xmrig::PerfCounters::Sample> &xmrig::Workers<T>::counters() const
+{
+    return d_ptr->counters;
+}
+
+
+template<class T>
+const std::vector<xmrig::PerfCounters::Sample> &xmrig::Workers<T>::recentCounters() const
+{
+    return d_ptr->recent;
+}
+#endif
+
+
+/**
+ * Replaces a single thread with a new worker for the same configuration, with new memory and hash context.
+ */
+template<class T>
+bool xmrig::Workers<T>::restart(size_t id)
+{
+    if (id >= m_workers.size()) {
+        return false;
+    }
+
+    Thread<T> *handle = new Thread<T>(d_ptr->backend, id, m_workers[id]->config());
+    handle->restore(*m_workers[id]);
+
+    remove(m_workers[id]);
+    m_workers[id] = handle;
+
+    // Hash counter of the new worker starts from zero, previous samples of this thread are no longer comparable.
+    if (d_ptr->hashrate) {
+        d_ptr->hashrate->reset(id);
+        d_ptr->locality[id] = NUMALocality();
+
+#       ifdef XMRIG_FEATURE_PERF
+        d_ptr->counters[id] = PerfCounters::Sample();
+        d_ptr->recent[id]   = PerfCounters::Sample();
+#       endif
+    }
+
+    launch({ handle });
+
+    return true;
+}
+
+
+template<class T>
+bool xmrig::Workers<T>::retune(size_t id, int64_t affinity, int priority)
+{
+    if (id >= m_workers.size() || !m_workers[id]->worker()) {
+        return false;
+    }
+
+    m_workers[id]->retune(affinity, priority);
+
+    return true;
+}
+
+
+template<class T>
+bool xmrig::Workers<T>::setParked(size_t id, bool parked)
+{
+    if (id >= m_workers.size() || !m_workers[id]->worker()) {
+        return false;
+    }
+
+    m_workers[id]->setParked(parked);
+
+    return true;
+}
+
+
+template<class T>
+void xmrig::Workers<T>::setDuty(uint32_t duty)
+{
+    d_ptr->duty = duty;
+
+    for (Thread<T> *handle : m_workers) {
+        handle->setDuty(duty);
+    }
+}
+
+
 template<class T>
 void xmrig::Workers<T>::setBackend(IBackend *backend)
 {
@@ -104,17 +207,9 @@ void xmrig::Workers<T>::start(const std::vector<T> &data)
         m_workers.push_back(new Thread<T>(d_ptr->backend, m_workers.size(), item));
     }
 
-    d_ptr->hashrate = new Hashrate(m_workers.size());
+    reset();
     Nonce::touch(T::backend());
-
-    for (Thread<T> *worker : m_workers) {
-        worker->start(Workers<T>::onReady);
-
-        // This sleep is important for optimal caching!
-        // Threads must allocate scratchpads in order so that adjacent cores will use adjacent scratchpads
-        // Sub-optimal caching can result in up to 0.5% hashrate penalty
-        std::this_thread::sleep_for(std::chrono::milliseconds(20));
-    }
+    launch(m_workers);
 }
 
 
@@ -132,6 +227,12 @@ void xmrig::Workers<T>::stop()
 
     delete d_ptr->hashrate;
     d_ptr->hashrate = nullptr;
+    d_ptr->locality.clear();
+
+#   ifdef XMRIG_FEATURE_PERF
+    d_ptr->counters.clear();
+    d_ptr->recent.clear();
+#   endif
 }
 
 
@@ -148,10 +249,75 @@ void xmrig::Workers<T>::tick(uint64_t)
         }
 
         d_ptr->hashrate->add(handle->id(), handle->worker()->hashCount(), handle->worker()->timestamp());
+        d_ptr->locality[handle->id()] = handle->worker()->locality();
+
+#       ifdef XMRIG_FEATURE_PERF
+        // Per hash values and IPC are taken from the two latest distinct snapshots, so they follow the current job and profile.
+        if (handle->worker()->counters()) {
+            const PerfCounters::Sample sample = handle->worker()->counters()->snapshot();
+            PerfCounters::Sample &previous    = d_ptr->counters[handle->id()];
+
+            if (sample.isValid() && sample.hashes != previous.hashes) {
+                d_ptr->recent[handle->id()] = sample.since(previous);
+                previous                    = sample;
+            }
+        }
+#       endif
     }
 }
 
 
+/**
+ * Apply a new thread configuration without a full restart: threads with unchanged configuration keep running,
+ * threads that differ only in priority or affinity are retuned in place, other threads are replaced one by one.
+ */
+template<class T>
+void xmrig::Workers<T>::update(const std::vector<T> &previous, const std::vector<T> &data)
+{
+    assert(previous.size() == m_workers.size());
+
+    const size_t count = std::min(m_workers.size(), data.size());
+    std::vector<Thread<T> *> pending;
+
+    for (size_t i = count; i < m_workers.size(); ++i) {
+        remove(m_workers[i]);
+    }
+
+    m_workers.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (previous[i] == data[i] || retune(m_workers[i], previous[i], data[i])) {
+            continue;
+        }
+
+        remove(m_workers[i]);
+
+        m_workers[i] = new Thread<T>(d_ptr->backend, i, data[i]);
+        pending.push_back(m_workers[i]);
+    }
+
+    for (size_t i = count; i < data.size(); ++i) {
+        m_workers.push_back(new Thread<T>(d_ptr->backend, i, data[i]));
+        pending.push_back(m_workers.back());
+    }
+
+    if (pending.empty() && m_workers.size() == previous.size()) {
+        return;
+    }
+
+    // Hash counters of new threads start from zero, previous samples are no longer comparable.
+    reset();
+    launch(pending);
+}
+
+
+template<class T>
+bool xmrig::Workers<T>::retune(Thread<T> *, const T &, const T &)
+{
+    return false;
+}
+
+
 template<class T>
 xmrig::IWorker *xmrig::Workers<T>::create(Thread<T> *)
 {
@@ -164,9 +330,17 @@ void xmrig::Workers<T>::onReady(void *arg)
 {
     auto handle = static_cast<Thread<T>* >(arg);
 
+    if (handle->order()) {
+        handle->order()->wait(handle->turn());
+    }
+
     IWorker *worker = create(handle);
     assert(worker != nullptr);
 
+    if (handle->order()) {
+        handle->order()->next();
+    }
+
     if (!worker || !worker->selfTest()) {
         LOG_ERR("%s " RED("thread ") RED_BOLD("#%zu") RED(" self-test failed"), T::tag(), worker ? worker->id() : 0);
 
@@ -183,9 +357,70 @@ void xmrig::Workers<T>::onReady(void *arg)
 }
 
 
+/**
+ * Starts all threads at once. CPU workers are still created in thread order: scratchpads must be allocated in order
+ * so that adjacent cores will use adjacent scratchpads, sub-optimal caching can result in up to 0.5% hashrate penalty.
+ */
+template<class T>
+void xmrig::Workers<T>::launch(const std::vector<Thread<T> *> &threads)
+{
+    if (T::backend() == Nonce::CPU) {
+        auto order = std::make_shared<LaunchOrder>();
+
+        for (size_t i = 0; i < threads.size(); ++i) {
+            threads[i]->setOrder(order, i);
+        }
+    }
+
+    // New threads run with the current duty, the throttler only pushes changes.
+    for (Thread<T> *worker : threads) {
+        worker->setDuty(d_ptr->duty);
+        worker->start(Workers<T>::onReady);
+    }
+}
+
+
+template<class T>
+void xmrig::Workers<T>::remove(Thread<T> *handle)
+{
+    handle->stop();
+    d_ptr->backend->stop(handle->worker());
+
+    delete handle;
+}
+
+
+template<class T>
+void xmrig::Workers<T>::reset()
+{
+    delete d_ptr->hashrate;
+
+    d_ptr->hashrate = new Hashrate(m_workers.size());
+    d_ptr->locality.assign(m_workers.size(), NUMALocality());
+
+#   ifdef XMRIG_FEATURE_PERF
+    d_ptr->counters.assign(m_workers.size(), PerfCounters::Sample());
+    d_ptr->recent.assign(m_workers.size(), PerfCounters::Sample());
+#   endif
+}
+
+
 namespace xmrig {
 
 
+template<>
+bool xmrig::Workers<CpuLaunchData>::retune(Thread<CpuLaunchData> *handle, const CpuLaunchData &previous, const CpuLaunchData &data)
+{
+    if (!handle->worker() || !previous.isRetunable(data)) {
+        return false;
+    }
+
+    handle->retune(data.affinity, data.priority);
+
+    return true;
+}
+
+
 template<>
 xmrig::IWorker *xmrig::Workers<CpuLaunchData>::create(Thread<CpuLaunchData> *handle)
 {
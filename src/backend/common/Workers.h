@@ -42,6 +42,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_PERF
+#   include "backend/cpu/platform/PerfCounters.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -59,20 +64,38 @@ public:
     ~Workers();
 
     const Hashrate *hashrate() const;
+    bool restart(size_t id);
+    bool retune(size_t id, int64_t affinity, int priority);
+    bool setParked(size_t id, bool parked);
+    void setDuty(uint32_t duty);
+    const std::vector<NUMALocality> &locality() const;
     void setBackend(IBackend *backend);
     void start(const std::vector<T> &data);
     void stop();
     void tick(uint64_t ticks);
+    void update(const std::vector<T> &previous, const std::vector<T> &data);
+
+#   ifdef XMRIG_FEATURE_PERF
+    const std::vector<PerfCounters::Sample> &counters() const;
+    const std::vector<PerfCounters::Sample> &recentCounters() const;
+#   endif
 
 private:
+    static bool retune(Thread<T> *handle, const T &previous, const T &data);
     static IWorker *create(Thread<T> *handle);
     static void onReady(void *arg);
 
+    void launch(const std::vector<Thread<T> *> &threads);
+    void remove(Thread<T> *handle);
+    void reset();
+
     std::vector<Thread<T> *> m_workers;
     WorkersPrivate *d_ptr;
 };
 
 
+template<>
+bool Workers<CpuLaunchData>::retune(Thread<CpuLaunchData> *handle, const CpuLaunchData &previous, const CpuLaunchData &data);
 template<>
 IWorker *Workers<CpuLaunchData>::create(Thread<CpuLaunchData> *handle);
 extern template class Workers<CpuLaunchData>;
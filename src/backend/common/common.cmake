@@ -6,6 +6,7 @@ set(HEADERS_BACKEND_COMMON
     src/backend/common/interfaces/IRxStorage.h
     src/backend/common/interfaces/IThread.h
     src/backend/common/interfaces/IWorker.h
+    src/backend/common/LaunchOrder.h
     src/backend/common/misc/PciTopology.h
     src/backend/common/Thread.h
     src/backend/common/Threads.h
@@ -40,6 +40,7 @@ class Hashrate;
 class IApiRequest;
 class IWorker;
 class Job;
+class Metrics;
 class String;
 
 
@@ -59,11 +60,13 @@ public:
     virtual void setJob(const Job &job)                                 = 0;
     virtual void start(IWorker *worker, bool ready)                     = 0;
     virtual void stop()                                                 = 0;
+    virtual void stop(IWorker *worker)                                  = 0;
     virtual void tick(uint64_t ticks)                                   = 0;
 
 #   ifdef XMRIG_FEATURE_API
     virtual rapidjson::Value toJSON(rapidjson::Document &doc) const     = 0;
     virtual void handleRequest(IApiRequest &request)                    = 0;
+    virtual void toMetrics(Metrics &metrics) const                      = 0;
 #   endif
 };
 
@@ -30,9 +30,13 @@
 #include <cstddef>
 
 
+#include "backend/common/NUMALocality.h"
+
+
 namespace xmrig {
 
 
+class PerfCounters;
 class VirtualMemory;
 
 
@@ -42,12 +46,18 @@ public:
     virtual ~IWorker() = default;
 
     virtual bool selfTest()                         = 0;
+    virtual const PerfCounters *counters() const    = 0;
+    virtual NUMALocality locality() const           = 0;
     virtual const VirtualMemory *memory() const     = 0;
     virtual size_t id() const                       = 0;
     virtual size_t intensity() const                = 0;
     virtual uint64_t hashCount() const              = 0;
     virtual uint64_t timestamp() const              = 0;
+    virtual void retune(int64_t affinity, int priority) = 0;
+    virtual void setDuty(uint32_t duty)             = 0;
+    virtual void setParked(bool parked)             = 0;
     virtual void start()                            = 0;
+    virtual void stop()                             = 0;
 };
 
 
@@ -28,10 +28,12 @@
 
 #include "backend/common/Hashrate.h"
 #include "backend/common/interfaces/IWorker.h"
+#include "backend/common/Worker.h"
 #include "backend/common/Tags.h"
 #include "backend/common/Workers.h"
 #include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuBackend.h"
+#include "backend/cpu/CpuVerifier.h"
 #include "base/io/log/Log.h"
 #include "base/net/stratum/Job.h"
 #include "base/tools/Chrono.h"
@@ -46,6 +48,7 @@
 
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/interfaces/IApiRequest.h"
+#   include "base/api/Metrics.h"
 #endif
 
 
@@ -54,6 +57,20 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_PROFILING
+#   include "crypto/rx/RxProfiler.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_REBALANCE
+#   include "backend/cpu/platform/CpuRebalancer.h"
+#endif
+
+#ifdef XMRIG_FEATURE_THROTTLE
+#   include "backend/cpu/platform/CpuThrottle.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -103,6 +120,28 @@ public:
         return (m_started + m_errors) == m_threads;
     }
 
+    inline void stopped(IWorker *worker)
+    {
+        if (!worker) {
+            m_errors--;
+
+            return;
+        }
+
+        auto hugePages = worker->memory()->hugePages();
+
+        m_started--;
+        m_hugePages -= hugePages.first;
+        m_pages     -= hugePages.second;
+        m_ways      -= worker->intensity();
+    }
+
+    inline void update(const std::vector<CpuLaunchData> &threads)
+    {
+        m_threads   = threads.size();
+        m_ts        = Chrono::steadyMSecs();
+    }
+
     inline void print() const
     {
         if (m_started == 0) {
@@ -139,13 +178,93 @@ class CpuBackendPrivate
 {
 public:
     inline CpuBackendPrivate(Controller *controller) :
-        controller(controller)
+        controller(controller),
+        verifier(workers)
+    {
+    }
+
+
+#   if defined(XMRIG_FEATURE_REBALANCE) || defined(XMRIG_FEATURE_THROTTLE)
+    inline ~CpuBackendPrivate()
+    {
+#       ifdef XMRIG_FEATURE_REBALANCE
+        delete rebalancer;
+#       endif
+
+#       ifdef XMRIG_FEATURE_THROTTLE
+        delete throttler;
+#       endif
+    }
+#   endif
+
+
+#   ifdef XMRIG_FEATURE_REBALANCE
+
+    inline void rebalance()
+    {
+        if (!controller->config()->cpu().isRebalance() || threads.empty()) {
+            return resetRebalancer(true);
+        }
+
+        if (!rebalancer) {
+            rebalancer = new CpuRebalancer(threads);
+        }
+
+        rebalancer->tick(workers);
+    }
+
+
+    inline void resetRebalancer(bool restore)
+    {
+        if (rebalancer && restore) {
+            rebalancer->restore(workers);
+        }
+
+        delete rebalancer;
+        rebalancer = nullptr;
+    }
+#   endif
+
+
+#   ifdef XMRIG_FEATURE_THROTTLE
+    inline void throttle()
     {
+        const CpuConfig &cpu = controller->config()->cpu();
+
+        if ((!cpu.maxTemp() && !cpu.maxPower()) || threads.empty()) {
+            return resetThrottle();
+        }
+
+        if (throttler && !throttler->isEqual(cpu.maxTemp(), cpu.maxPower())) {
+            resetThrottle();
+        }
+
+        if (!throttler) {
+            throttler = new CpuThrottle(cpu.maxTemp(), cpu.maxPower());
+        }
+
+        throttler->tick(workers);
+    }
+
+
+    inline void resetThrottle()
+    {
+        if (throttler) {
+            throttler->restore(workers);
+        }
+
+        delete throttler;
+        throttler = nullptr;
     }
+#   endif
 
 
     inline void start()
     {
+#       ifdef XMRIG_FEATURE_REBALANCE
+        resetRebalancer(false);
+#       endif
+
         LOG_INFO("%s use profile " BLUE_BG(WHITE_BOLD_S " %s ") WHITE_BOLD_S " (" CYAN_BOLD("%zu") WHITE_BOLD(" thread%s)") " scratchpad " CYAN_BOLD("%zu KB"),
                  tag,
                  profileName.data(),
@@ -155,10 +274,34 @@ public:
                  );
 
         status.start(threads, algo.l3());
+        verifier.reset(threads.size());
         workers.start(threads);
     }
 
 
+    inline void update(std::vector<CpuLaunchData> &&next)
+    {
+        LOG_INFO("%s update profile " BLUE_BG(WHITE_BOLD_S " %s ") WHITE_BOLD_S " (" CYAN_BOLD("%zu") WHITE_BOLD(" -> ") CYAN_BOLD("%zu") WHITE_BOLD(" threads)"),
+                 tag,
+                 profileName.data(),
+                 threads.size(),
+                 next.size()
+                 );
+
+        mutex.lock();
+        status.update(next);
+        mutex.unlock();
+
+#       ifdef XMRIG_FEATURE_REBALANCE
+        resetRebalancer(true);
+#       endif
+
+        verifier.update(threads, next);
+        workers.update(threads, next);
+        threads = std::move(next);
+    }
+
+
     size_t ways()
     {
         std::lock_guard<std::mutex> lock(mutex);
@@ -167,7 +310,7 @@ public:
     }
 
 
-    rapidjson::Value hugePages(int version, rapidjson::Document &doc)
+    std::pair<unsigned, unsigned> hugePages()
     {
         std::pair<unsigned, unsigned> pages(0, 0);
 
@@ -184,6 +327,14 @@ public:
 
         mutex.unlock();
 
+        return pages;
+    }
+
+
+    rapidjson::Value hugePages(int version, rapidjson::Document &doc)
+    {
+        const auto pages = hugePages();
+
         rapidjson::Value hugepages;
 
         if (version > 1) {
@@ -199,12 +350,131 @@ public:
     }
 
 
+#   ifdef XMRIG_FEATURE_PERF
+    void printCounters()
+    {
+        const auto &counters = workers.recentCounters();
+        if (counters.empty()) {
+            return;
+        }
+
+        if (!controller->config()->cpu().isPerfCounters()) {
+            LOG_WARN("%s " YELLOW("hardware performance counters disabled, use ") YELLOW_BOLD("\"perf-counters\": true"), tag);
+
+            return;
+        }
+
+        char buf[5][16] = {};
+
+        Log::print(WHITE_BOLD_S "|    CPU # | AFFINITY |  IPC | CYCLES/H |  INSTR/H | LLC MISS/H | DTLB MISS/H | BR MISS/H |");
+
+        for (size_t i = 0; i < counters.size() && i < threads.size(); ++i) {
+            const PerfCounters::Sample &sample = counters[i];
+
+            for (uint32_t id = 0; id < PerfCounters::Max; ++id) {
+                if (sample.has(static_cast<PerfCounters::Id>(id))) {
+                    snprintf(buf[id], sizeof buf[id], "%.0f", sample.perHash(static_cast<PerfCounters::Id>(id)));
+                }
+                else {
+                    strncpy(buf[id], "n/a", sizeof buf[id]);
+                }
+            }
+
+            Log::print("| %8zu | %8" PRId64 " | %4.2f | %8s | %8s | %10s | %11s | %9s |",
+                       i,
+                       threads[i].affinity,
+                       sample.ipc(),
+                       buf[PerfCounters::Cycles],
+                       buf[PerfCounters::Instructions],
+                       buf[PerfCounters::LLCMisses],
+                       buf[PerfCounters::DTLBMisses],
+                       buf[PerfCounters::BranchMisses]
+                       );
+        }
+    }
+
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value counters(size_t index, rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+
+        const auto &counters = workers.counters();
+        if (index >= counters.size() || !counters[index].isValid()) {
+            return Value(kNullType);
+        }
+
+        auto &allocator                     = doc.GetAllocator();
+        const PerfCounters::Sample &sample  = counters[index];
+
+        Value out(kObjectType);
+        out.AddMember("hashes", sample.hashes, allocator);
+
+        for (uint32_t i = 0; i < PerfCounters::Max; ++i) {
+            const auto id = static_cast<PerfCounters::Id>(i);
+
+            out.AddMember(StringRef(PerfCounters::name(id)), sample.has(id) ? Value(sample.value(id)) : Value(kNullType), allocator);
+        }
+
+        out.AddMember("ipc", workers.recentCounters()[index].ipc(), allocator);
+
+        return out;
+    }
+#   endif
+#   endif
+
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value numa(size_t index, rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+
+        const auto &locality = workers.locality();
+        if (index >= locality.size() || !locality[index].isValid()) {
+            return Value(kNullType);
+        }
+
+        auto &allocator             = doc.GetAllocator();
+        const NUMALocality &numa    = locality[index];
+
+        Value out(kObjectType);
+        out.AddMember("node",  numa.node, allocator);
+        out.AddMember("local", numa.isLocal(), allocator);
+
+        for (uint32_t i = 0; i < NUMALocality::RegionMax; ++i) {
+            const int32_t node = numa.regions[i];
+            Value value(kNullType);
+
+            if (node == NUMALocality::Mixed) {
+                value = StringRef("mixed");
+            }
+            else if (node >= 0) {
+                value = node;
+            }
+
+            out.AddMember(StringRef(NUMALocality::name(static_cast<NUMALocality::Region>(i))), value, allocator);
+        }
+
+        return out;
+    }
+#   endif
+
+
     Algorithm algo;
     Controller *controller;
     CpuLaunchStatus status;
     std::vector<CpuLaunchData> threads;
     String profileName;
     Workers<CpuLaunchData> workers;
+    CpuVerifier verifier;
+
+#   ifdef XMRIG_FEATURE_REBALANCE
+    CpuRebalancer *rebalancer = nullptr;
+#   endif
+
+#   ifdef XMRIG_FEATURE_THROTTLE
+    CpuThrottle *throttler = nullptr;
+#   endif
 };
 
 
@@ -278,6 +548,16 @@ const xmrig::String &xmrig::CpuBackend::type() const
 }
 
 
+void xmrig::CpuBackend::execCommand(char command)
+{
+#   ifdef XMRIG_FEATURE_PERF
+    if (command == 'c' || command == 'C') {
+        d_ptr->printCounters();
+    }
+#   endif
+}
+
+
 void xmrig::CpuBackend::prepare(const Job &nextJob)
 {
 #   ifdef XMRIG_ALGO_ARGON2
@@ -338,6 +618,7 @@ void xmrig::CpuBackend::setJob(const Job &job)
         return;
     }
 
+    const bool update   = !d_ptr->threads.empty() && d_ptr->algo.l3() == job.algorithm().l3();
     d_ptr->algo         = job.algorithm();
     d_ptr->profileName  = cpu.threads().profileName(job.algorithm());
 
@@ -347,6 +628,10 @@ void xmrig::CpuBackend::setJob(const Job &job)
         return stop();
     }
 
+    if (update) {
+        return d_ptr->update(std::move(threads));
+    }
+
     stop();
 
     d_ptr->threads = std::move(threads);
@@ -380,14 +665,34 @@ void xmrig::CpuBackend::stop()
 
     d_ptr->workers.stop();
     d_ptr->threads.clear();
+    d_ptr->verifier.reset(0);
 
     LOG_INFO("%s" YELLOW(" stopped") BLACK_BOLD(" (%" PRIu64 " ms)"), tag, Chrono::steadyMSecs() - ts);
 }
 
 
+void xmrig::CpuBackend::stop(IWorker *worker)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    d_ptr->status.stopped(worker);
+}
+
+
 void xmrig::CpuBackend::tick(uint64_t ticks)
 {
     d_ptr->workers.tick(ticks);
+
+    const CpuConfig &cpu = d_ptr->controller->config()->cpu();
+    d_ptr->verifier.tick(cpu.verifyInterval(), cpu.isHwAES());
+
+#   ifdef XMRIG_FEATURE_REBALANCE
+    d_ptr->rebalance();
+#   endif
+
+#   ifdef XMRIG_FEATURE_THROTTLE
+    d_ptr->throttle();
+#   endif
 }
 
 
@@ -420,6 +725,10 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("hugepages", d_ptr->hugePages(2, doc), allocator);
     out.AddMember("memory",    static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * d_ptr->algo.l3()) : 0), allocator);
 
+#   ifdef XMRIG_FEATURE_THROTTLE
+    out.AddMember("throttle",  d_ptr->throttler ? d_ptr->throttler->toJSON(doc) : Value(kNullType), allocator);
+#   endif
+
     if (d_ptr->threads.empty() || !hashrate()) {
         return out;
     }
@@ -435,6 +744,15 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
         thread.AddMember("affinity",    data.affinity, allocator);
         thread.AddMember("av",          data.av(), allocator);
         thread.AddMember("hashrate",    hashrate()->toJSON(i, doc), allocator);
+        thread.AddMember("verify",      d_ptr->verifier.toJSON(i, doc), allocator);
+
+        if (Cpu::info()->nodes() > 1) {
+            thread.AddMember("numa",    d_ptr->numa(i, doc), allocator);
+        }
+
+#       ifdef XMRIG_FEATURE_PERF
+        thread.AddMember("counters",    d_ptr->counters(i, doc), allocator);
+#       endif
 
         i++;
         threads.PushBack(thread, allocator);
@@ -442,6 +760,10 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 
     out.AddMember("threads", threads, allocator);
 
+#   ifdef XMRIG_FEATURE_PROFILING
+    out.AddMember("randomx-profile", RxProfiler::toJSON(doc), allocator);
+#   endif
+
     return out;
 }
 
@@ -452,4 +774,33 @@ void xmrig::CpuBackend::handleRequest(IApiRequest &request)
         request.reply().AddMember("hugepages", d_ptr->hugePages(request.version(), request.doc()), request.doc().GetAllocator());
     }
 }
+
+
+void xmrig::CpuBackend::toMetrics(Metrics &metrics) const
+{
+    const auto pages = d_ptr->hugePages();
+
+    metrics.family("xmrig_hugepages", "gauge", "Huge pages used by the CPU backend, including RandomX dataset and cache.");
+    metrics.add("xmrig_hugepages", "backend=\"cpu\",state=\"allocated\"", static_cast<uint64_t>(pages.first));
+    metrics.add("xmrig_hugepages", "backend=\"cpu\",state=\"requested\"", static_cast<uint64_t>(pages.second));
+
+    metrics.family("xmrig_memory_bytes", "gauge", "Scratchpad memory of CPU threads.");
+    metrics.add("xmrig_memory_bytes", "backend=\"cpu\"", static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * d_ptr->algo.l3()) : 0));
+
+    metrics.family("xmrig_cpu_hash_errors_total", "counter", "Wrong hashes found by re-computing samples of CPU thread hashes.");
+    metrics.add("xmrig_cpu_hash_errors_total", nullptr, d_ptr->verifier.errors());
+
+#   ifdef XMRIG_FEATURE_THROTTLE
+    if (d_ptr->throttler) {
+        metrics.family("xmrig_cpu_duty_ratio", "gauge", "Fraction of time CPU threads are allowed to hash by max-temp and max-power.");
+        metrics.add("xmrig_cpu_duty_ratio", nullptr, static_cast<double>(d_ptr->throttler->duty()) / Worker::kMaxDuty);
+
+        metrics.family("xmrig_cpu_temperature_celsius", "gauge", "CPU package temperature.");
+        metrics.add("xmrig_cpu_temperature_celsius", nullptr, d_ptr->throttler->temperature());
+
+        metrics.family("xmrig_cpu_power_watts", "gauge", "CPU package power from RAPL energy counters.");
+        metrics.add("xmrig_cpu_power_watts", nullptr, d_ptr->throttler->power());
+    }
+#   endif
+}
 #endif
@@ -50,23 +50,24 @@ public:
     ~CpuBackend() override;
 
 protected:
-    inline void execCommand(char) override {}
-
     bool isEnabled() const override;
     bool isEnabled(const Algorithm &algorithm) const override;
     const Hashrate *hashrate() const override;
     const String &profileName() const override;
     const String &type() const override;
+    void execCommand(char command) override;
     void prepare(const Job &nextJob) override;
     void printHashrate(bool details) override;
     void setJob(const Job &job) override;
     void start(IWorker *worker, bool ready) override;
     void stop() override;
+    void stop(IWorker *worker) override;
     void tick(uint64_t ticks) override;
 
 #   ifdef XMRIG_FEATURE_API
     rapidjson::Value toJSON(rapidjson::Document &doc) const override;
     void handleRequest(IApiRequest &request) override;
+    void toMetrics(Metrics &metrics) const override;
 #   endif
 
 private:
@@ -23,10 +23,14 @@
  */
 
 
+#include <algorithm>
+
+
 #include "backend/cpu/CpuConfig.h"
 #include "backend/cpu/CpuConfig_gen.h"
 #include "backend/cpu/Cpu.h"
 #include "base/io/json/Json.h"
+#include "base/kernel/Cgroup.h"
 #include "rapidjson/document.h"
 
 
@@ -35,9 +39,15 @@ namespace xmrig {
 static const char *kEnabled             = "enabled";
 static const char *kHugePages           = "huge-pages";
 static const char *kHwAes               = "hw-aes";
+static const char *kMaxPower            = "max-power";
+static const char *kMaxTemp             = "max-temp";
 static const char *kMaxThreadsHint      = "max-threads-hint";
 static const char *kMemoryPool          = "memory-pool";
+static const char *kPerfCounters        = "perf-counters";
 static const char *kPriority            = "priority";
+static const char *kRebalance           = "rebalance";
+static const char *kStrictWX            = "strict-wx";
+static const char *kVerifyInterval      = "verify-interval";
 static const char *kYield               = "yield";
 
 #ifdef XMRIG_FEATURE_ASM
@@ -72,6 +82,12 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kPriority),     priority() != -1 ? Value(priority()) : Value(kNullType), allocator);
     obj.AddMember(StringRef(kMemoryPool),   m_memoryPool < 1 ? Value(m_memoryPool < 0) : Value(m_memoryPool), allocator);
     obj.AddMember(StringRef(kYield),        m_yield, allocator);
+    obj.AddMember(StringRef(kStrictWX),     m_strictWX, allocator);
+    obj.AddMember(StringRef(kPerfCounters), m_perfCounters, allocator);
+    obj.AddMember(StringRef(kRebalance),    m_rebalance, allocator);
+    obj.AddMember(StringRef(kMaxTemp),      m_maxTemp ? Value(m_maxTemp) : Value(kNullType), allocator);
+    obj.AddMember(StringRef(kMaxPower),     m_maxPower ? Value(m_maxPower) : Value(kNullType), allocator);
+    obj.AddMember(StringRef(kVerifyInterval), m_verifyInterval, allocator);
 
     if (m_threads.isEmpty()) {
         obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
@@ -93,7 +109,11 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
 
 size_t xmrig::CpuConfig::memPoolSize() const
 {
-    return m_memoryPool < 0 ? Cpu::info()->threads() : m_memoryPool;
+    if (m_memoryPool >= 0) {
+        return m_memoryPool;
+    }
+
+    return Cgroup::cpus() ? std::min<size_t>(Cgroup::cpus(), Cpu::info()->threads()) : Cpu::info()->threads();
 }
 
 
@@ -119,10 +139,16 @@ std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, cons
 void xmrig::CpuConfig::read(const rapidjson::Value &value)
 {
     if (value.IsObject()) {
-        m_enabled   = Json::getBool(value, kEnabled, m_enabled);
-        m_hugePages = Json::getBool(value, kHugePages, m_hugePages);
-        m_limit     = Json::getUint(value, kMaxThreadsHint, m_limit);
-        m_yield     = Json::getBool(value, kYield, m_yield);
+        m_enabled      = Json::getBool(value, kEnabled, m_enabled);
+        m_hugePages    = Json::getBool(value, kHugePages, m_hugePages);
+        m_limit        = Json::getUint(value, kMaxThreadsHint, m_limit);
+        m_yield        = Json::getBool(value, kYield, m_yield);
+        m_strictWX     = Json::getBool(value, kStrictWX, m_strictWX);
+        m_perfCounters = Json::getBool(value, kPerfCounters, m_perfCounters);
+        m_rebalance    = Json::getBool(value, kRebalance, m_rebalance);
+        m_maxTemp      = Json::getUint(value, kMaxTemp, m_maxTemp);
+        m_maxPower     = Json::getUint(value, kMaxPower, m_maxPower);
+        m_verifyInterval = Json::getUint(value, kVerifyInterval, m_verifyInterval);
 
         setAesMode(Json::getValue(value, kHwAes));
         setPriority(Json::getInt(value,  kPriority, -1));
@@ -157,14 +183,21 @@ void xmrig::CpuConfig::generate()
         return;
     }
 
-    size_t count = 0;
+    size_t count   = 0;
+    uint32_t limit = m_limit;
+
+    // Do not start more threads than the control group quota or cpuset allows to run at once.
+    if (Cgroup::cpus() && Cgroup::cpus() < Cpu::info()->threads()) {
+        const uint32_t allowed = std::max<uint32_t>(static_cast<uint32_t>(Cgroup::cpus() * 100 / Cpu::info()->threads()), 1);
+        limit                  = limit > 0 && limit < 100 ? std::min(limit, allowed) : allowed;
+    }
 
-    count += xmrig::generate<Algorithm::CN>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_LITE>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_HEAVY>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_PICO>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::RANDOM_X>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::ARGON2>(m_threads, m_limit);
+    count += xmrig::generate<Algorithm::CN>(m_threads, limit);
+    count += xmrig::generate<Algorithm::CN_LITE>(m_threads, limit);
+    count += xmrig::generate<Algorithm::CN_HEAVY>(m_threads, limit);
+    count += xmrig::generate<Algorithm::CN_PICO>(m_threads, limit);
+    count += xmrig::generate<Algorithm::RANDOM_X>(m_threads, limit);
+    count += xmrig::generate<Algorithm::ARGON2>(m_threads, limit);
 
     m_shouldSave = count > 0;
 }
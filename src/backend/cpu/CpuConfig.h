@@ -54,12 +54,18 @@ public:
 
     inline bool isEnabled() const                       { return m_enabled; }
     inline bool isHugePages() const                     { return m_hugePages; }
+    inline bool isPerfCounters() const                  { return m_perfCounters; }
+    inline bool isRebalance() const                     { return m_rebalance; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
+    inline bool isStrictWX() const                      { return m_strictWX; }
     inline bool isYield() const                         { return m_yield; }
     inline const Assembly &assembly() const             { return m_assembly; }
     inline const String &argon2Impl() const             { return m_argon2Impl; }
     inline const Threads<CpuThreads> &threads() const   { return m_threads; }
     inline int priority() const                         { return m_priority; }
+    inline uint32_t maxPower() const                    { return m_maxPower; }
+    inline uint32_t maxTemp() const                     { return m_maxTemp; }
+    inline uint32_t verifyInterval() const              { return m_verifyInterval; }
 
 private:
     void generate();
@@ -72,13 +78,19 @@ private:
     Assembly m_assembly;
     bool m_enabled       = true;
     bool m_hugePages     = true;
+    bool m_perfCounters  = false;
+    bool m_rebalance     = false;
     bool m_shouldSave    = false;
+    bool m_strictWX      = false;
     bool m_yield         = true;
     int m_memoryPool     = 0;
     int m_priority       = -1;
     String m_argon2Impl;
     Threads<CpuThreads> m_threads;
     uint32_t m_limit     = 100;
+    uint32_t m_maxPower  = 0;
+    uint32_t m_maxTemp   = 0;
+    uint32_t m_verifyInterval = 60;
 };
 
 
@@ -27,6 +27,7 @@
 #include "backend/cpu/CpuLaunchData.h"
 
 #include "backend/common/Tags.h"
+#include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuConfig.h"
 
 
@@ -38,6 +39,7 @@ xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorit
     assembly(config.assembly()),
     hugePages(config.isHugePages()),
     hwAES(config.isHwAES()),
+    perfCounters(config.isPerfCounters()),
     yield(config.isYield()),
     priority(config.priority()),
     affinity(thread.affinity()),
@@ -53,6 +55,7 @@ bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
             && assembly         == other.assembly
             && hugePages        == other.hugePages
             && hwAES            == other.hwAES
+            && perfCounters     == other.perfCounters
             && intensity        == other.intensity
             && priority         == other.priority
             && affinity         == other.affinity
@@ -60,6 +63,31 @@ bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
 }
 
 
+/**
+ * Returns true if a running worker can switch to the other configuration in place:
+ * only priority or affinity differ and the new value can be applied to the live thread.
+ * Affinity changes between NUMA nodes need a new thread, because memory is bound to the node.
+ */
+bool xmrig::CpuLaunchData::isRetunable(const CpuLaunchData &other) const
+{
+    if (algorithm.l3()     != other.algorithm.l3()
+        || assembly        != other.assembly
+        || hugePages       != other.hugePages
+        || hwAES           != other.hwAES
+        || perfCounters    != other.perfCounters
+        || intensity       != other.intensity
+        ) {
+        return false;
+    }
+
+    if (priority != other.priority && other.priority < 0) {
+        return false;
+    }
+
+    return affinity == other.affinity || (other.affinity >= 0 && Cpu::info()->nodes() < 2);
+}
+
+
 xmrig::CnHash::AlgoVariant xmrig::CpuLaunchData::av() const
 {
     if (intensity <= 2) {
@@ -47,6 +47,7 @@ public:
     CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread);
 
     bool isEqual(const CpuLaunchData &other) const;
+    bool isRetunable(const CpuLaunchData &other) const;
     CnHash::AlgoVariant av() const;
 
     inline constexpr static Nonce::Backend backend() { return Nonce::CPU; }
@@ -60,6 +61,7 @@ public:
     const Assembly assembly;
     const bool hugePages;
     const bool hwAES;
+    const bool perfCounters;
     const bool yield;
     const int priority;
     const int64_t affinity;
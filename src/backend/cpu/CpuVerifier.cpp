@@ -0,0 +1,356 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <atomic>
+#include <cinttypes>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <random>
+#include <uv.h>
+
+
+#include "backend/cpu/CpuVerifier.h"
+#include "backend/common/Workers.h"
+#include "base/io/log/Log.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Baton.h"
+#include "base/tools/Chrono.h"
+#include "crypto/cn/CnCtx.h"
+#include "crypto/cn/CnHash.h"
+#include "crypto/cn/CryptoNight.h"
+#include "crypto/common/VirtualMemory.h"
+#include "rapidjson/document.h"
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/randomx/randomx.h"
+#   include "crypto/rx/Rx.h"
+#   include "crypto/rx/RxVm.h"
+#endif
+
+
+namespace xmrig {
+
+
+static const char *tag                  = CYAN_BG_BOLD(WHITE_BOLD_S " cpu ");
+static constexpr size_t kMaxPending     = 1024;
+static constexpr uint64_t kMaxErrors    = 3;
+
+
+class JobSample
+{
+public:
+    inline JobSample(size_t id, const Job &job, uint32_t nonce, const uint8_t *hash) :
+        job(job),
+        id(id),
+        nonce(nonce)
+    {
+        memcpy(this->hash, hash, sizeof(this->hash));
+    }
+
+    Job job;
+    size_t id;
+    uint32_t nonce;
+    uint8_t hash[32];
+};
+
+
+class JobSampleBaton : public Baton<uv_work_t>
+{
+public:
+    enum Result : uint8_t {
+        Skipped,
+        Valid,
+        Invalid
+    };
+
+    inline JobSampleBaton(CpuVerifier *owner, std::list<JobSample> &&samples, bool hwAES) :
+        hwAES(hwAES),
+        owner(owner),
+        samples(std::move(samples))
+    {}
+
+    const bool hwAES;
+    CpuVerifier *owner;
+    std::list<JobSample> samples;
+    std::vector<Result> results;
+};
+
+
+static CpuVerifier *instance = nullptr;
+static std::atomic<uint64_t> interval(0);
+static std::list<JobSample> pending;
+static std::mutex mutex;
+
+
+static JobSampleBaton::Result verify(JobSample &sample, bool hwAES)
+{
+    const auto &algorithm = sample.job.algorithm();
+    auto memory           = new VirtualMemory(algorithm.l3(), false, false);
+    uint8_t hash[32]{ 0 };
+
+    *sample.job.nonce() = sample.nonce;
+
+    if (algorithm.family() == Algorithm::RANDOM_X) {
+#       ifdef XMRIG_ALGO_RANDOMX
+        RxDataset *dataset = Rx::dataset(sample.job, 0);
+        if (dataset == nullptr) {
+            delete memory;
+
+            return JobSampleBaton::Skipped;
+        }
+
+        // Interpreted VM, so a fault in JIT generated code is not repeated.
+        auto vm = new RxVm(dataset, memory->scratchpad(), !hwAES, false);
+        randomx_calculate_hash(vm->get(), sample.job.blob(), sample.job.size(), hash);
+
+        delete vm;
+#       endif
+    }
+    else {
+        // Generic implementation without assembly, so a fault in an optimized code path is not repeated.
+        cryptonight_ctx *ctx[1];
+        CnCtx::create(ctx, memory->scratchpad(), memory->size(), 1);
+
+        const cn_hash_fun fn = CnHash::fn(algorithm, hwAES ? CnHash::AV_SINGLE : CnHash::AV_SINGLE_SOFT, Assembly::NONE);
+        if (fn) {
+            fn(sample.job.blob(), sample.job.size(), hash, ctx, sample.job.height());
+        }
+
+        CnCtx::release(ctx, 1);
+
+        if (!fn) {
+            delete memory;
+
+            return JobSampleBaton::Skipped;
+        }
+    }
+
+    delete memory;
+
+    return memcmp(hash, sample.hash, sizeof(hash)) == 0 ? JobSampleBaton::Valid : JobSampleBaton::Invalid;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::CpuVerifier::CpuVerifier(Workers<CpuLaunchData> &workers) :
+    m_workers(workers)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    instance = this;
+}
+
+
+xmrig::CpuVerifier::~CpuVerifier()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    instance = nullptr;
+    pending.clear();
+}
+
+
+/**
+ * Called by workers between hash batches, returns true about once per interval. The first call only schedules the
+ * first sample at a random point of the interval, so threads do not submit samples all at the same time.
+ */
+bool xmrig::CpuVerifier::isSampleTime(uint64_t &ts)
+{
+    const uint64_t value = interval.load(std::memory_order_relaxed);
+    if (!value) {
+        ts = 0;
+
+        return false;
+    }
+
+    const uint64_t now = Chrono::steadyMSecs();
+    if (ts && now < ts) {
+        return false;
+    }
+
+    thread_local std::mt19937_64 random(std::random_device{}());
+    std::uniform_int_distribution<uint64_t> jitter(value / 2, value + value / 2);
+
+    const bool first = ts == 0;
+    ts = now + (first ? jitter(random) - value / 2 : jitter(random));
+
+    return !first;
+}
+
+
+void xmrig::CpuVerifier::submit(size_t id, const Job &job, uint32_t nonce, const uint8_t *hash)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (instance && pending.size() < kMaxPending) {
+        pending.emplace_back(id, job, nonce, hash);
+    }
+}
+
+
+uint64_t xmrig::CpuVerifier::errors() const
+{
+    uint64_t errors = 0;
+    for (const State &state : m_threads) {
+        errors += state.errors;
+    }
+
+    return errors;
+}
+
+
+void xmrig::CpuVerifier::reset(size_t threads)
+{
+    m_threads.assign(threads, State());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.clear();
+}
+
+
+/**
+ * Samples are re-computed in the libuv thread pool, outside of pinned mining threads, with a separate context and
+ * scratchpad, in the spirit of GPU results check in JobResults.
+ */
+void xmrig::CpuVerifier::tick(uint32_t seconds, bool hwAES)
+{
+    interval = seconds * 1000ULL;
+
+    if (m_busy) {
+        return;
+    }
+
+    std::list<JobSample> samples;
+
+    mutex.lock();
+    pending.swap(samples);
+    mutex.unlock();
+
+    if (samples.empty() || !seconds) {
+        return;
+    }
+
+    m_busy = true;
+
+    auto baton = new JobSampleBaton(this, std::move(samples), hwAES);
+
+    uv_queue_work(uv_default_loop(), &baton->req,
+        [](uv_work_t *req) {
+            auto baton = static_cast<JobSampleBaton*>(req->data);
+
+            for (JobSample &sample : baton->samples) {
+                baton->results.push_back(verify(sample, baton->hwAES));
+            }
+        },
+        [](uv_work_t *req, int) {
+            auto baton = static_cast<JobSampleBaton*>(req->data);
+
+            if (baton->owner == instance) {
+                baton->owner->onResults(*baton);
+            }
+
+            delete baton;
+        }
+    );
+}
+
+
+void xmrig::CpuVerifier::update(const std::vector<CpuLaunchData> &previous, const std::vector<CpuLaunchData> &next)
+{
+    m_threads.resize(next.size());
+
+    // Replaced threads start with clean counters, like a new thread.
+    for (size_t i = 0; i < next.size() && i < previous.size(); ++i) {
+        if (previous[i] != next[i] && !previous[i].isRetunable(next[i])) {
+            m_threads[i] = State();
+        }
+    }
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::CpuVerifier::toJSON(size_t id, rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+
+    if (id >= m_threads.size()) {
+        return Value(kNullType);
+    }
+
+    auto &allocator     = doc.GetAllocator();
+    const State &state  = m_threads[id];
+
+    Value out(kObjectType);
+    out.AddMember("checked",     state.checked, allocator);
+    out.AddMember("errors",      state.errors, allocator);
+    out.AddMember("quarantined", state.quarantined, allocator);
+
+    return out;
+}
+#endif
+
+
+/**
+ * A thread that produced a wrong hash is restarted with new memory, after kMaxErrors wrong hashes it is parked until
+ * the next profile change.
+ */
+void xmrig::CpuVerifier::onResults(const JobSampleBaton &baton)
+{
+    m_busy = false;
+
+    size_t i = 0;
+    for (const JobSample &sample : baton.samples) {
+        const auto result = baton.results[i++];
+
+        if (result == JobSampleBaton::Skipped || sample.id >= m_threads.size() || m_threads[sample.id].quarantined) {
+            continue;
+        }
+
+        State &state = m_threads[sample.id];
+        state.checked++;
+
+        if (result == JobSampleBaton::Valid) {
+            continue;
+        }
+
+        state.errors++;
+
+        LOG_ERR("%s " RED("thread ") RED_BOLD("#%zu") RED(" computed wrong hash for ") RED_BOLD("%s") RED(" nonce ") RED_BOLD("%08" PRIx32) RED(" (%" PRIu64 "/%" PRIu64 ")"),
+                tag, sample.id, sample.job.algorithm().shortName(), sample.nonce, state.errors, kMaxErrors);
+
+        if (state.errors >= kMaxErrors) {
+            if (m_workers.setParked(sample.id, true)) {
+                state.quarantined = true;
+
+                LOG_ERR("%s " RED("thread ") RED_BOLD("#%zu") RED(" quarantined, check CPU overclocking, voltage and cooling"), tag, sample.id);
+            }
+        }
+        else {
+            m_workers.restart(sample.id);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUVERIFIER_H
+#define XMRIG_CPUVERIFIER_H
+
+
+#include <cstdint>
+#include <vector>
+
+
+#include "backend/cpu/CpuLaunchData.h"
+#include "base/tools/Object.h"
+#include "rapidjson/fwd.h"
+
+
+namespace xmrig {
+
+
+class Job;
+class JobSampleBaton;
+template<class T> class Workers;
+
+
+class CpuVerifier
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(CpuVerifier)
+
+    CpuVerifier(Workers<CpuLaunchData> &workers);
+    ~CpuVerifier();
+
+    static bool isSampleTime(uint64_t &ts);
+    static void submit(size_t id, const Job &job, uint32_t nonce, const uint8_t *hash);
+
+    uint64_t errors() const;
+    void reset(size_t threads);
+    void tick(uint32_t interval, bool hwAES);
+    void update(const std::vector<CpuLaunchData> &previous, const std::vector<CpuLaunchData> &next);
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(size_t id, rapidjson::Document &doc) const;
+#   endif
+
+private:
+    struct State
+    {
+        bool quarantined    = false;
+        uint64_t checked    = 0;
+        uint64_t errors     = 0;
+    };
+
+    void onResults(const JobSampleBaton &baton);
+
+    bool m_busy = false;
+    std::vector<State> m_threads;
+    Workers<CpuLaunchData> &m_workers;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUVERIFIER_H */
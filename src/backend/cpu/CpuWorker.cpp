@@ -25,10 +25,16 @@
 
 
 #include <cassert>
+#include <future>
+#include <map>
+#include <mutex>
 #include <thread>
 
 
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuVerifier.h"
 #include "backend/cpu/CpuWorker.h"
+#include "base/io/log/Log.h"
 #include "core/Miner.h"
 #include "crypto/cn/CnCtx.h"
 #include "crypto/cn/CryptoNight_test.h"
@@ -44,10 +50,25 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_PROFILING
+#   include "crypto/rx/RxProfiler.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_PERF
+#   include "backend/cpu/platform/PerfCounters.h"
+#endif
+
+
 namespace xmrig {
 
 static constexpr uint32_t kReserveCount = 32768;
 
+
+// Self-test results shared by all threads, key is algorithm family, variant and assembly, the mutex guards only the map.
+static std::map<uint64_t, std::shared_future<bool> > selfTestResults;
+static std::mutex selfTestMutex;
+
 } // namespace xmrig
 
 
@@ -58,12 +79,24 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     m_algorithm(data.algorithm),
     m_assembly(data.assembly),
     m_hwAES(data.hwAES),
+    m_numa(data.affinity >= 0 && Cpu::info()->nodes() > 1),
     m_yield(data.yield),
     m_av(data.av()),
     m_miner(data.miner),
     m_ctx()
 {
+    for (auto &node : m_locality) {
+        node.store(NUMALocality::Unknown, std::memory_order_relaxed);
+    }
+
     m_memory = new VirtualMemory(m_algorithm.l3() * N, data.hugePages, true, m_node);
+    bindMemory();
+
+#   ifdef XMRIG_FEATURE_PERF
+    if (data.perfCounters) {
+        m_perf = new PerfCounters();
+    }
+#   endif
 }
 
 
@@ -76,6 +109,10 @@ xmrig::CpuWorker<N>::~CpuWorker()
 
     CnCtx::release(m_ctx, N);
     delete m_memory;
+
+#   ifdef XMRIG_FEATURE_PERF
+    delete m_perf;
+#   endif
 }
 
 
@@ -88,7 +125,7 @@ void xmrig::CpuWorker<N>::allocateRandomX_VM()
     while (dataset == nullptr) {
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
 
-        if (Nonce::sequence(Nonce::CPU) == 0) {
+        if (Nonce::sequence(Nonce::CPU) == 0 || isStopped()) {
             return;
         }
 
@@ -97,11 +134,30 @@ void xmrig::CpuWorker<N>::allocateRandomX_VM()
 
     if (!m_vm) {
         m_vm = new RxVm(dataset, m_memory->scratchpad(), !m_hwAES);
+        bindMemory();
     }
 }
 #endif
 
 
+template<size_t N>
+xmrig::NUMALocality xmrig::CpuWorker<N>::locality() const
+{
+    NUMALocality locality;
+    if (!m_numa) {
+        return locality;
+    }
+
+    locality.node = static_cast<int32_t>(m_node);
+
+    for (size_t i = 0; i < NUMALocality::RegionMax; ++i) {
+        locality.regions[i] = m_locality[i].load(std::memory_order_relaxed);
+    }
+
+    return locality;
+}
+
+
 template<size_t N>
 bool xmrig::CpuWorker<N>::selfTest()
 {
@@ -113,6 +169,39 @@ bool xmrig::CpuWorker<N>::selfTest()
 
     allocateCnCtx();
 
+    const uint64_t key = (static_cast<uint64_t>(m_algorithm.family()) << 32) | (static_cast<uint64_t>(m_av) << 8) | static_cast<Assembly::Id>(m_assembly);
+
+    // Other threads with the same key wait for the first one instead of repeating the test vectors, different keys run in parallel.
+    std::promise<bool> promise;
+    std::shared_future<bool> result;
+    bool owner = false;
+
+    {
+        std::lock_guard<std::mutex> lock(selfTestMutex);
+
+        auto it = selfTestResults.find(key);
+        if (it == selfTestResults.end()) {
+            result = promise.get_future().share();
+            owner  = true;
+
+            selfTestResults.insert({ key, result });
+        }
+        else {
+            result = it->second;
+        }
+    }
+
+    if (owner) {
+        promise.set_value(verifyAll());
+    }
+
+    return result.get();
+}
+
+
+template<size_t N>
+bool xmrig::CpuWorker<N>::verifyAll()
+{
     if (m_algorithm.family() == Algorithm::CN) {
         const bool rc = verify(Algorithm::CN_0,      test_output_v0)   &&
                         verify(Algorithm::CN_1,      test_output_v1)   &&
@@ -172,14 +261,24 @@ bool xmrig::CpuWorker<N>::selfTest()
 template<size_t N>
 void xmrig::CpuWorker<N>::start()
 {
-    while (Nonce::sequence(Nonce::CPU) > 0) {
+#   ifdef XMRIG_FEATURE_PROFILING
+    RxProfiler::setThread(id());
+#   endif
+
+#   ifdef XMRIG_FEATURE_PERF
+    if (m_perf && !m_perf->open() && id() == 0) {
+        LOG_WARN("%s " YELLOW("hardware performance counters unavailable, check ") YELLOW_BOLD("/proc/sys/kernel/perf_event_paranoid"), CpuLaunchData::tag());
+    }
+#   endif
+
+    while (Nonce::sequence(Nonce::CPU) > 0 && !isStopped()) {
         if (Nonce::isPaused()) {
             do {
                 std::this_thread::sleep_for(std::chrono::milliseconds(200));
             }
-            while (Nonce::isPaused() && Nonce::sequence(Nonce::CPU) > 0);
+            while (Nonce::isPaused() && Nonce::sequence(Nonce::CPU) > 0 && !isStopped());
 
-            if (Nonce::sequence(Nonce::CPU) == 0) {
+            if (Nonce::sequence(Nonce::CPU) == 0 || isStopped()) {
                 break;
             }
 
@@ -198,9 +297,31 @@ void xmrig::CpuWorker<N>::start()
         }
 #       endif
 
-        while (!Nonce::isOutdated(Nonce::CPU, m_job.sequence())) {
+        while (!Nonce::isOutdated(Nonce::CPU, m_job.sequence()) && !isStopped()) {
             if ((m_count & storeStatsMask) == 0) {
                 storeStats();
+
+                if (isRetune()) {
+                    applyRetune();
+                }
+
+                while (isParked() && !isStopped() && Nonce::sequence(Nonce::CPU) > 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                }
+
+                if (CpuVerifier::isSampleTime(m_sampleTs)) {
+                    m_sample = true;
+                }
+
+                if (m_verifyMemory && m_count > 0) {
+                    verifyMemory();
+                }
+
+#               ifdef XMRIG_FEATURE_PERF
+                if (m_perf) {
+                    m_perf->sample(m_count);
+                }
+#               endif
             }
 
             const Job &job = m_job.currentJob();
@@ -236,8 +357,15 @@ void xmrig::CpuWorker<N>::start()
                 }
             }
 
+            if (m_sample) {
+                m_sample = false;
+                CpuVerifier::submit(id(), job, current_job_nonces[0], m_hash);
+            }
+
             m_count += N;
 
+            throttle();
+
             if (m_yield) {
                 std::this_thread::yield();
             }
@@ -321,6 +449,29 @@ void xmrig::CpuWorker<N>::allocateCnCtx()
 }
 
 
+template<size_t N>
+void xmrig::CpuWorker<N>::bindMemory()
+{
+    if (!m_numa) {
+        return;
+    }
+
+    // Pool or _mm_malloc memory may have been touched by other threads before, move it to the local node.
+    VirtualMemory::membind(m_memory->scratchpad(), m_memory->size(), m_node, m_memory->pageSize());
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (m_vm) {
+        size_t size   = 0;
+        uint8_t *code = m_vm->code(size);
+
+        VirtualMemory::membind(code, size, m_node);
+    }
+#   endif
+
+    m_verifyMemory = true;
+}
+
+
 template<size_t N>
 void xmrig::CpuWorker<N>::consumeJob()
 {
@@ -342,6 +493,30 @@ void xmrig::CpuWorker<N>::consumeJob()
 }
 
 
+template<size_t N>
+void xmrig::CpuWorker<N>::verifyMemory()
+{
+    m_verifyMemory = false;
+
+    m_locality[NUMALocality::Scratchpad].store(VirtualMemory::memoryNode(m_memory->scratchpad(), m_memory->size()), std::memory_order_relaxed);
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (m_vm) {
+        size_t size   = 0;
+        uint8_t *code = m_vm->code(size);
+
+        m_locality[NUMALocality::Code].store(VirtualMemory::memoryNode(code, size), std::memory_order_relaxed);
+    }
+#   endif
+
+    const NUMALocality numa = locality();
+    if (!numa.isLocal()) {
+        LOG_WARN("%s " YELLOW("thread ") YELLOW_BOLD("#%zu") YELLOW(" memory is not local to NUMA node %d, scratchpad %d code %d"),
+                 CpuLaunchData::tag(), id(), numa.node, numa.regions[NUMALocality::Scratchpad], numa.regions[NUMALocality::Code]);
+    }
+}
+
+
 namespace xmrig {
 
 template class CpuWorker<1>;
@@ -27,6 +27,9 @@
 #define XMRIG_CPUWORKER_H
 
 
+#include <atomic>
+
+
 #include "backend/common/Worker.h"
 #include "backend/common/WorkerJob.h"
 #include "backend/cpu/CpuLaunchData.h"
@@ -37,6 +40,7 @@
 namespace xmrig {
 
 
+class PerfCounters;
 class RxVm;
 
 
@@ -53,8 +57,11 @@ protected:
     bool selfTest() override;
     void start() override;
 
-    inline const VirtualMemory *memory() const override { return m_memory; }
-    inline size_t intensity() const override            { return N; }
+    inline const PerfCounters *counters() const override { return m_perf; }
+    inline const VirtualMemory *memory() const override  { return m_memory; }
+    inline size_t intensity() const override             { return N; }
+
+    NUMALocality locality() const override;
 
 private:
     inline cn_hash_fun fn(const Algorithm &algorithm) const { return CnHash::fn(algorithm, m_av, m_assembly); }
@@ -65,16 +72,25 @@ private:
 
     bool verify(const Algorithm &algorithm, const uint8_t *referenceValue);
     bool verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
+    bool verifyAll();
     void allocateCnCtx();
+    void bindMemory();
     void consumeJob();
+    void verifyMemory();
 
     const Algorithm m_algorithm;
     const Assembly m_assembly;
     const bool m_hwAES;
+    const bool m_numa;
     const bool m_yield;
     const CnHash::AlgoVariant m_av;
     const Miner *m_miner;
     cryptonight_ctx *m_ctx[N];
+    bool m_sample           = false;
+    bool m_verifyMemory     = false;
+    PerfCounters *m_perf    = nullptr;
+    std::atomic<int32_t> m_locality[NUMALocality::RegionMax];
+    uint64_t m_sampleTs     = 0;
     uint8_t m_hash[N * 32]{ 0 };
     VirtualMemory *m_memory = nullptr;
     WorkerJob<N> m_job;
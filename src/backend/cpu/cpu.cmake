@@ -6,8 +6,10 @@ set(HEADERS_BACKEND_CPU
     src/backend/cpu/CpuLaunchData.cpp
     src/backend/cpu/CpuThread.h
     src/backend/cpu/CpuThreads.h
+    src/backend/cpu/CpuVerifier.h
     src/backend/cpu/CpuWorker.h
     src/backend/cpu/interfaces/ICpuInfo.h
+    src/backend/cpu/platform/Rapl.h
    )
 
 set(SOURCES_BACKEND_CPU
@@ -17,10 +19,27 @@ set(SOURCES_BACKEND_CPU
     src/backend/cpu/CpuLaunchData.h
     src/backend/cpu/CpuThread.cpp
     src/backend/cpu/CpuThreads.cpp
+    src/backend/cpu/CpuVerifier.cpp
     src/backend/cpu/CpuWorker.cpp
+    src/backend/cpu/platform/Rapl.cpp
    )
 
 
+if (CMAKE_SYSTEM_NAME STREQUAL Linux)
+    add_definitions(/DXMRIG_FEATURE_PERF)
+
+    add_definitions(/DXMRIG_FEATURE_REBALANCE)
+    add_definitions(/DXMRIG_FEATURE_THROTTLE)
+
+    list(APPEND HEADERS_BACKEND_CPU src/backend/cpu/platform/PerfCounters.h src/backend/cpu/platform/CpuRebalancer.h src/backend/cpu/platform/CpuThrottle.h)
+    list(APPEND SOURCES_BACKEND_CPU src/backend/cpu/platform/PerfCounters.cpp src/backend/cpu/platform/CpuRebalancer.cpp src/backend/cpu/platform/CpuThrottle.cpp)
+else()
+    remove_definitions(/DXMRIG_FEATURE_PERF)
+    remove_definitions(/DXMRIG_FEATURE_REBALANCE)
+    remove_definitions(/DXMRIG_FEATURE_THROTTLE)
+endif()
+
+
 if (WITH_HWLOC)
     if (CMAKE_CXX_COMPILER_ID MATCHES MSVC)
         add_subdirectory(src/3rdparty/hwloc)
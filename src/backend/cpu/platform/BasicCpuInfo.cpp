@@ -23,6 +23,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <string.h>
 #include <thread>
 
@@ -181,7 +182,11 @@ const char *xmrig::BasicCpuInfo::backend() const
 
 xmrig::CpuThreads xmrig::BasicCpuInfo::threads(const Algorithm &algorithm, uint32_t limit) const
 {
-    const size_t count = std::thread::hardware_concurrency();
+    size_t count = std::thread::hardware_concurrency();
+
+    if (limit > 0 && limit < 100) {
+        count = std::max<size_t>(static_cast<size_t>(round(count * (limit / 100.0))), 1);
+    }
 
     if (count == 1) {
         return 1;
@@ -0,0 +1,303 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+
+#include "backend/cpu/platform/CpuRebalancer.h"
+#include "backend/common/Hashrate.h"
+#include "backend/common/Workers.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/log/Log.h"
+#include "base/tools/Chrono.h"
+
+
+namespace xmrig {
+
+
+static const char *tag                  = CYAN_BG_BOLD(WHITE_BOLD_S " cpu ");
+static constexpr double kIdleLoad       = 0.25;     // core counts as free below this load
+static constexpr double kPeakDecay      = 0.99;     // per interval, lets the reference follow slow drifts
+static constexpr double kSlowRatio      = 0.8;      // thread counts as slow below this fraction of its peak
+static constexpr uint32_t kHysteresis   = 3;        // consecutive intervals before any action
+static constexpr uint64_t kInterval     = 10000;
+
+
+// Release builds use -Ofast, which folds std::isnan() to false.
+static inline bool isValid(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    return (bits & 0x7ff0000000000000ULL) != 0x7ff0000000000000ULL && value > 0.0;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::CpuRebalancer::CpuRebalancer(const std::vector<CpuLaunchData> &threads)
+{
+    m_threads.reserve(threads.size());
+
+    for (const CpuLaunchData &data : threads) {
+        m_threads.emplace_back(data);
+    }
+}
+
+
+void xmrig::CpuRebalancer::restore(Workers<CpuLaunchData> &workers)
+{
+    for (size_t i = 0; i < m_threads.size(); ++i) {
+        State &state = m_threads[i];
+
+        if (state.parked) {
+            park(workers, i, false);
+        }
+
+        if (state.current != state.home) {
+            move(workers, i, state.home);
+        }
+    }
+}
+
+
+/**
+ * Compares the hashrate of every pinned thread with its own recent peak and the load of all cores from /proc/stat.
+ * A thread that stays slow is moved to a free core, or parked if there is none. It returns to its configured core
+ * or resumes once that core stays free for the same number of intervals.
+ */
+void xmrig::CpuRebalancer::tick(Workers<CpuLaunchData> &workers)
+{
+    const uint64_t now = Chrono::steadyMSecs();
+    if (now - m_ts < kInterval) {
+        return;
+    }
+
+    m_ts = now;
+
+    const Hashrate *hashrate = workers.hashrate();
+    if (!readStat() || !hashrate || hashrate->threads() != m_threads.size()) {
+        return;
+    }
+
+    for (size_t i = 0; i < m_threads.size(); ++i) {
+        State &state = m_threads[i];
+        if (state.home < 0) {
+            continue;
+        }
+
+        if (state.parked) {
+            if (load(state.current) < kIdleLoad) {
+                if (++state.idle >= kHysteresis) {
+                    park(workers, i, false);
+                }
+
+                continue;
+            }
+
+            state.idle = 0;
+
+            const int64_t cpu = findIdle(i);
+            if (cpu >= 0) {
+                move(workers, i, cpu);
+                park(workers, i, false);
+            }
+
+            continue;
+        }
+
+        const double rate = hashrate->calc(i, Hashrate::ShortInterval);
+        if (!isValid(rate)) {
+            continue;
+        }
+
+        state.peak = std::max(rate, state.peak * kPeakDecay);
+
+        if (rate < state.peak * kSlowRatio) {
+            state.idle = 0;
+
+            if (++state.slow < kHysteresis) {
+                continue;
+            }
+
+            const int64_t cpu = findIdle(i);
+            if (cpu >= 0) {
+                move(workers, i, cpu);
+            }
+            else {
+                park(workers, i, true);
+            }
+
+            continue;
+        }
+
+        state.slow = 0;
+
+        if (state.current != state.home && !isOccupied(state.home, i) && load(state.home) < kIdleLoad) {
+            if (++state.idle >= kHysteresis) {
+                move(workers, i, state.home);
+            }
+        }
+        else {
+            state.idle = 0;
+        }
+    }
+}
+
+
+bool xmrig::CpuRebalancer::isOccupied(int64_t cpu, size_t id) const
+{
+    for (size_t i = 0; i < m_threads.size(); ++i) {
+        if (i != id && (m_threads[i].current == cpu || m_threads[i].home == cpu)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool xmrig::CpuRebalancer::readStat()
+{
+    std::ifstream file("/proc/stat");
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const size_t count = Cpu::info()->threads();
+    bool ready         = false;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (line.compare(0, 3, "cpu") != 0) {
+            break;
+        }
+
+        // The aggregate "cpu  ..." line has no id, %u would skip the blanks and read the total user time instead.
+        if (line.size() < 4 || !isdigit(static_cast<unsigned char>(line[3]))) {
+            continue;
+        }
+
+        unsigned id     = 0;
+        uint64_t v[8]   = {};
+
+        if (sscanf(line.c_str(), "cpu%u %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64,
+                   &id, &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]) < 5 || id >= count) {
+            continue;
+        }
+
+        const uint64_t busy  = v[0] + v[1] + v[2] + v[5] + v[6] + v[7];
+        const uint64_t total = busy + v[3] + v[4];
+
+        if (id >= m_cores.size()) {
+            m_cores.resize(id + 1);
+        }
+
+        Core &core = m_cores[id];
+
+        if (core.total > 0 && total > core.total) {
+            core.load = static_cast<double>(busy - core.busy) / static_cast<double>(total - core.total);
+            ready     = true;
+        }
+
+        core.busy  = busy;
+        core.total = total;
+    }
+
+    return ready;
+}
+
+
+double xmrig::CpuRebalancer::load(int64_t cpu) const
+{
+    return (cpu >= 0 && static_cast<size_t>(cpu) < m_cores.size()) ? m_cores[static_cast<size_t>(cpu)].load : 1.0;
+}
+
+
+int64_t xmrig::CpuRebalancer::findIdle(size_t id) const
+{
+    // Scratchpads are bound to the NUMA node of the original core.
+    if (Cpu::info()->nodes() > 1) {
+        return -1;
+    }
+
+    int64_t cpu = -1;
+    double best = kIdleLoad;
+
+    for (size_t i = 0; i < m_cores.size(); ++i) {
+        if (m_cores[i].load < best && !isOccupied(static_cast<int64_t>(i), id)) {
+            best = m_cores[i].load;
+            cpu  = static_cast<int64_t>(i);
+        }
+    }
+
+    return cpu;
+}
+
+
+void xmrig::CpuRebalancer::move(Workers<CpuLaunchData> &workers, size_t id, int64_t cpu)
+{
+    State &state = m_threads[id];
+
+    if (!workers.retune(id, cpu, state.priority)) {
+        return;
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("thread ") CYAN_BOLD("#%zu") WHITE_BOLD(" moved from CPU #%" PRId64 " to #%" PRId64) BLACK_BOLD(" (load %.0f%%)"),
+             tag, id, state.current, cpu, load(state.current) * 100.0);
+
+    state.current = cpu;
+    state.idle    = 0;
+    state.slow    = 0;
+}
+
+
+void xmrig::CpuRebalancer::park(Workers<CpuLaunchData> &workers, size_t id, bool parked)
+{
+    State &state = m_threads[id];
+
+    if (!workers.setParked(id, parked)) {
+        return;
+    }
+
+    if (parked) {
+        LOG_WARN("%s " YELLOW("thread ") YELLOW_BOLD("#%zu") YELLOW(" parked, CPU #%" PRId64 " is busy and no free CPU found"), tag, id, state.current);
+    }
+    else {
+        LOG_INFO("%s " WHITE_BOLD("thread ") CYAN_BOLD("#%zu") WHITE_BOLD(" resumed on CPU #%" PRId64), tag, id, state.current);
+    }
+
+    state.parked = parked;
+    state.idle   = 0;
+    state.slow   = 0;
+}
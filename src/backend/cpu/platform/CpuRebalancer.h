@@ -0,0 +1,91 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_CPUREBALANCER_H
+#define XMRIG_CPUREBALANCER_H
+
+
+#include <cstdint>
+#include <vector>
+
+
+#include "backend/cpu/CpuLaunchData.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+template<class T> class Workers;
+
+
+class CpuRebalancer
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(CpuRebalancer)
+
+    CpuRebalancer(const std::vector<CpuLaunchData> &threads);
+
+    void restore(Workers<CpuLaunchData> &workers);
+    void tick(Workers<CpuLaunchData> &workers);
+
+private:
+    struct Core
+    {
+        double load     = 1.0;
+        uint64_t busy   = 0;
+        uint64_t total  = 0;
+    };
+
+    struct State
+    {
+        inline State(const CpuLaunchData &data) : current(data.affinity), home(data.affinity), priority(data.priority) {}
+
+        bool parked     = false;
+        double peak     = 0.0;
+        int64_t current;
+        int64_t home;
+        int priority;
+        uint32_t idle   = 0;
+        uint32_t slow   = 0;
+    };
+
+    bool isOccupied(int64_t cpu, size_t id) const;
+    bool readStat();
+    double load(int64_t cpu) const;
+    int64_t findIdle(size_t id) const;
+    void move(Workers<CpuLaunchData> &workers, size_t id, int64_t cpu);
+    void park(Workers<CpuLaunchData> &workers, size_t id, bool parked);
+
+    std::vector<Core> m_cores;
+    std::vector<State> m_threads;
+    uint64_t m_ts = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUREBALANCER_H */
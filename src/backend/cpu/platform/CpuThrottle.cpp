@@ -0,0 +1,224 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+
+#include "backend/cpu/platform/CpuThrottle.h"
+#include "backend/common/Hashrate.h"
+#include "backend/common/Worker.h"
+#include "backend/common/Workers.h"
+#include "base/io/log/Log.h"
+#include "base/tools/Chrono.h"
+#include "rapidjson/document.h"
+
+
+namespace xmrig {
+
+
+static const char *tag                  = CYAN_BG_BOLD(WHITE_BOLD_S " cpu ");
+static constexpr double kDeadBand       = 0.02;     // relative error ignored to avoid oscillation around the target
+static constexpr double kDownGain       = 1.0;      // react quickly when over the limit
+static constexpr double kUpGain         = 0.25;     // and slowly when below it
+static constexpr uint32_t kMaxIndex     = 64;
+static constexpr uint32_t kMinDuty      = 100;
+static constexpr uint64_t kInterval     = 1000;
+
+
+static bool readValue(const std::string &path, uint64_t &value)
+{
+    std::ifstream file(path);
+
+    return static_cast<bool>(file >> value);
+}
+
+
+static bool readString(const std::string &path, std::string &value)
+{
+    std::ifstream file(path);
+
+    return static_cast<bool>(file >> value);
+}
+
+
+static std::string sysfs(const char *format, uint32_t index, const char *file)
+{
+    char buf[128];
+    snprintf(buf, sizeof(buf), format, index);
+
+    return std::string(buf) + file;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::CpuThrottle::CpuThrottle(uint32_t maxTemp, uint32_t maxPower) :
+    m_duty(Worker::kMaxDuty),
+    m_maxPower(maxPower),
+    m_maxTemp(maxTemp)
+{
+    std::string value;
+
+    // Package sensors: x86_pkg_temp thermal zones on Intel, otherwise the first input of the CPU hwmon driver.
+    for (uint32_t i = 0; i < kMaxIndex; ++i) {
+        if (readString(sysfs("/sys/class/thermal/thermal_zone%u/", i, "type"), value) && value == "x86_pkg_temp") {
+            m_sensors.emplace_back(sysfs("/sys/class/thermal/thermal_zone%u/", i, "temp"));
+        }
+    }
+
+    for (uint32_t i = 0; i < kMaxIndex && m_sensors.empty(); ++i) {
+        if (readString(sysfs("/sys/class/hwmon/hwmon%u/", i, "name"), value) && (value == "coretemp" || value == "k10temp" || value == "zenpower")) {
+            m_sensors.emplace_back(sysfs("/sys/class/hwmon/hwmon%u/", i, "temp1_input"));
+        }
+    }
+
+    if (m_maxTemp && m_sensors.empty()) {
+        LOG_WARN("%s " YELLOW("package temperature sensor not found, ") YELLOW_BOLD("max-temp") YELLOW(" ignored"), tag);
+    }
+
+    if (m_maxPower && !m_rapl.isAvailable()) {
+        LOG_WARN("%s " YELLOW("RAPL energy counters unavailable, check permissions of ") YELLOW_BOLD("/sys/class/powercap") YELLOW(", ") YELLOW_BOLD("max-power") YELLOW(" ignored"), tag);
+    }
+
+    m_ts = Chrono::steadyMSecs();
+}
+
+
+void xmrig::CpuThrottle::restore(Workers<CpuLaunchData> &workers)
+{
+    workers.setDuty(Worker::kMaxDuty);
+}
+
+
+/**
+ * Integral controller: the duty cycle of all threads is changed in proportion to the relative distance from the most
+ * violated target, quickly when above it and slowly when below it, so short spikes never exceed the budget for long.
+ */
+void xmrig::CpuThrottle::tick(Workers<CpuLaunchData> &workers)
+{
+    const uint64_t now = Chrono::steadyMSecs();
+    if (now - m_ts < kInterval) {
+        return;
+    }
+
+    const uint64_t elapsed = now - m_ts;
+    m_ts = now;
+
+    const bool temp  = readTemperature();
+    const bool power = readPower(elapsed);
+
+    const Hashrate *hashrate = workers.hashrate();
+    const double hr          = hashrate ? hashrate->calc(Hashrate::ShortInterval) : 0.0;
+    m_efficiency             = power && m_power > 0.0 ? hr / m_power : 0.0;
+
+    double error = 1.0;
+    if (temp && m_maxTemp) {
+        error = std::min(error, (m_maxTemp - m_temp) / m_maxTemp);
+    }
+
+    if (power && m_maxPower) {
+        error = std::min(error, (m_maxPower - m_power) / m_maxPower);
+    }
+
+    if (error >= 1.0 || std::abs(error) < kDeadBand) {
+        return;
+    }
+
+    const uint32_t prev = m_duty;
+    const double next   = m_duty + (error < 0.0 ? kDownGain : kUpGain) * error * Worker::kMaxDuty;
+    m_duty              = static_cast<uint32_t>(std::max<double>(kMinDuty, std::min<double>(Worker::kMaxDuty, next)));
+
+    if (m_duty == prev) {
+        return;
+    }
+
+    workers.setDuty(m_duty);
+
+    if (prev == Worker::kMaxDuty) {
+        LOG_WARN("%s " YELLOW("throttling started ") YELLOW_BOLD("%.0f C %.1f W"), tag, m_temp, m_power);
+    }
+    else if (m_duty == Worker::kMaxDuty) {
+        LOG_INFO("%s " GREEN("throttling stopped ") CYAN_BOLD("%.0f C %.1f W"), tag, m_temp, m_power);
+    }
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::CpuThrottle::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember("duty",              static_cast<double>(m_duty) / Worker::kMaxDuty, allocator);
+    out.AddMember("max-temp",          m_maxTemp ? Value(m_maxTemp) : Value(kNullType), allocator);
+    out.AddMember("max-power",         m_maxPower ? Value(m_maxPower) : Value(kNullType), allocator);
+    out.AddMember("temperature",       m_sensors.empty() ? Value(kNullType) : Value(m_temp), allocator);
+    out.AddMember("power",             !m_rapl.isAvailable() ? Value(kNullType) : Hashrate::normalize(m_power), allocator);
+    out.AddMember("hashes_per_joule",  Hashrate::normalize(m_efficiency), allocator);
+
+    return out;
+}
+#endif
+
+
+bool xmrig::CpuThrottle::readPower(uint64_t elapsed)
+{
+    const uint64_t prev = m_rapl.energy();
+
+    if (elapsed == 0 || !m_rapl.read()) {
+        return false;
+    }
+
+    m_power = static_cast<double>(m_rapl.energy() - prev) / elapsed / 1000.0;
+
+    return true;
+}
+
+
+bool xmrig::CpuThrottle::readTemperature()
+{
+    if (m_sensors.empty()) {
+        return false;
+    }
+
+    uint64_t max = 0;
+
+    for (const std::string &path : m_sensors) {
+        uint64_t value = 0;
+        if (readValue(path, value)) {
+            max = std::max(max, value);
+        }
+    }
+
+    m_temp = max / 1000.0;
+
+    return max > 0;
+}
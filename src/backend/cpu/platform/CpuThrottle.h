@@ -0,0 +1,85 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_CPUTHROTTLE_H
+#define XMRIG_CPUTHROTTLE_H
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+#include "backend/cpu/CpuLaunchData.h"
+#include "backend/cpu/platform/Rapl.h"
+#include "base/tools/Object.h"
+#include "rapidjson/fwd.h"
+
+
+namespace xmrig {
+
+
+template<class T> class Workers;
+
+
+class CpuThrottle
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(CpuThrottle)
+
+    CpuThrottle(uint32_t maxTemp, uint32_t maxPower);
+
+    inline bool isEqual(uint32_t maxTemp, uint32_t maxPower) const { return m_maxTemp == maxTemp && m_maxPower == maxPower; }
+    inline double power() const                                   { return m_power; }
+    inline double temperature() const                             { return m_temp; }
+    inline uint32_t duty() const                                  { return m_duty; }
+
+    void restore(Workers<CpuLaunchData> &workers);
+    void tick(Workers<CpuLaunchData> &workers);
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+#   endif
+
+private:
+    bool readPower(uint64_t elapsed);
+    bool readTemperature();
+
+    double m_efficiency     = 0.0;
+    double m_power          = 0.0;
+    double m_temp           = 0.0;
+    Rapl m_rapl;
+    std::vector<std::string> m_sensors;
+    uint32_t m_duty;
+    uint32_t m_maxPower;
+    uint32_t m_maxTemp;
+    uint64_t m_ts           = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUTHROTTLE_H */
@@ -0,0 +1,324 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2019 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+#include "backend/cpu/platform/PerfCounters.h"
+
+
+namespace xmrig {
+
+
+static const char *kNames[PerfCounters::Max] = {
+    "cycles",
+    "instructions",
+    "llc-misses",
+    "dtlb-misses",
+    "branch-misses"
+};
+
+
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} kEvents[PerfCounters::Max] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+};
+
+
+static inline int perfEventOpen(perf_event_attr *attr, int groupFd)
+{
+    return static_cast<int>(syscall(__NR_perf_event_open, attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+
+
+#if defined(__x86_64__) || defined(__i386__)
+static inline uint64_t rdpmc(uint32_t counter)
+{
+    uint32_t low, high;
+    __asm__ __volatile__("rdpmc" : "=a" (low), "=d" (high) : "c" (counter));
+
+    return (static_cast<uint64_t>(high) << 32) | low;
+}
+#endif
+
+
+} // namespace xmrig
+
+
+double xmrig::PerfCounters::Sample::perHash(Id id) const
+{
+    return (has(id) && hashes) ? static_cast<double>(values[id]) / hashes : 0.0;
+}
+
+
+double xmrig::PerfCounters::Sample::ipc() const
+{
+    return (has(Cycles) && has(Instructions) && values[Cycles]) ? static_cast<double>(values[Instructions]) / values[Cycles] : 0.0;
+}
+
+
+// Counter values and hashes between two snapshots of the same thread, counters missing in either one are dropped.
+xmrig::PerfCounters::Sample xmrig::PerfCounters::Sample::since(const Sample &previous) const
+{
+    Sample out;
+    out.mask   = previous.isValid() ? (mask & previous.mask) : mask;
+    out.hashes = hashes - previous.hashes;
+
+    for (size_t i = 0; i < Max; ++i) {
+        out.values[i] = values[i] - previous.values[i];
+    }
+
+    return out;
+}
+
+
+xmrig::PerfCounters::PerfCounters()
+{
+    for (size_t i = 0; i < Max; ++i) {
+        m_fd[i] = -1;
+        m_values[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+
+xmrig::PerfCounters::~PerfCounters()
+{
+    close();
+}
+
+
+const char *xmrig::PerfCounters::name(Id id)
+{
+    return id < Max ? kNames[id] : nullptr;
+}
+
+
+bool xmrig::PerfCounters::open()
+{
+    if (isOpen()) {
+        return true;
+    }
+
+    // Counters are bound to the calling thread and grouped so that all of them are scheduled
+    // on the PMU together, user space only to work with the default perf_event_paranoid=2.
+    for (uint32_t i = 0; i < Max; ++i) {
+        perf_event_attr attr{};
+        attr.size           = sizeof(attr);
+        attr.type           = kEvents[i].type;
+        attr.config         = kEvents[i].config;
+        attr.disabled       = i == Cycles;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+
+        const int fd = perfEventOpen(&attr, i == Cycles ? -1 : m_fd[Cycles]);
+        if (fd < 0) {
+            if (i == Cycles) {
+                return false;
+            }
+
+            continue;
+        }
+
+        if (ioctl(fd, PERF_EVENT_IOC_ID, &m_ids[i]) != 0) {
+            ::close(fd);
+            continue;
+        }
+
+        m_fd[i]  = fd;
+        m_mask  |= 1U << i;
+    }
+
+#   if defined(__x86_64__) || defined(__i386__)
+    m_pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    m_rdpmc    = true;
+
+    for (uint32_t i = 0; i < Max; ++i) {
+        if (m_fd[i] < 0) {
+            continue;
+        }
+
+        void *page = mmap(nullptr, m_pageSize, PROT_READ, MAP_SHARED, m_fd[i], 0);
+        if (page == MAP_FAILED) {
+            m_rdpmc = false;
+            break;
+        }
+
+        m_pages[i] = page;
+
+        if (!static_cast<perf_event_mmap_page *>(page)->cap_user_rdpmc) {
+            m_rdpmc = false;
+        }
+    }
+#   endif
+
+    if (ioctl(m_fd[Cycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) != 0 || ioctl(m_fd[Cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) != 0) {
+        close();
+
+        return false;
+    }
+
+    return true;
+}
+
+
+xmrig::PerfCounters::Sample xmrig::PerfCounters::snapshot() const
+{
+    Sample sample;
+
+    uint32_t seq;
+    do {
+        seq = m_seq.load(std::memory_order_acquire);
+        if (seq & 1) {
+            continue;
+        }
+
+        sample.mask   = m_sampleMask.load(std::memory_order_relaxed);
+        sample.hashes = m_hashes.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < Max; ++i) {
+            sample.values[i] = m_values[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((seq & 1) || seq != m_seq.load(std::memory_order_relaxed));
+
+    return sample;
+}
+
+
+void xmrig::PerfCounters::sample(uint64_t hashes)
+{
+    uint64_t values[Max] = {};
+
+    if (!isOpen() || (!(m_rdpmc && readUser(values)) && !readGroup(values))) {
+        return;
+    }
+
+    const uint32_t seq = m_seq.load(std::memory_order_relaxed);
+    m_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_sampleMask.store(m_mask, std::memory_order_relaxed);
+    m_hashes.store(hashes, std::memory_order_relaxed);
+    for (size_t i = 0; i < Max; ++i) {
+        m_values[i].store(values[i], std::memory_order_relaxed);
+    }
+
+    m_seq.store(seq + 2, std::memory_order_release);
+}
+
+
+bool xmrig::PerfCounters::readGroup(uint64_t *values) const
+{
+    struct {
+        uint64_t nr;
+        struct {
+            uint64_t value;
+            uint64_t id;
+        } events[Max];
+    } data{};
+
+    const ssize_t size = read(m_fd[Cycles], &data, sizeof(data));
+    if (size < static_cast<ssize_t>(sizeof(uint64_t))) {
+        return false;
+    }
+
+    for (uint64_t i = 0; i < data.nr && i < Max; ++i) {
+        for (size_t j = 0; j < Max; ++j) {
+            if (m_fd[j] >= 0 && m_ids[j] == data.events[i].id) {
+                values[j] = data.events[i].value;
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+bool xmrig::PerfCounters::readUser(uint64_t *values) const
+{
+#   if defined(__x86_64__) || defined(__i386__)
+    for (size_t i = 0; i < Max; ++i) {
+        if (!m_pages[i]) {
+            continue;
+        }
+
+        auto pc = static_cast<const volatile perf_event_mmap_page *>(m_pages[i]);
+        uint32_t seq;
+        uint64_t count;
+
+        do {
+            seq = pc->lock;
+            __asm__ __volatile__("" ::: "memory");
+
+            const uint32_t index = pc->index;
+            if (!pc->cap_user_rdpmc || index == 0) {
+                return false;
+            }
+
+            const uint32_t shift = 64 - pc->pmc_width;
+            count = pc->offset + static_cast<uint64_t>(static_cast<int64_t>(rdpmc(index - 1) << shift) >> shift);
+
+            __asm__ __volatile__("" ::: "memory");
+        } while (pc->lock != seq);
+
+        values[i] = count;
+    }
+
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+
+void xmrig::PerfCounters::close()
+{
+    for (size_t i = 0; i < Max; ++i) {
+        if (m_pages[i]) {
+            munmap(m_pages[i], m_pageSize);
+            m_pages[i] = nullptr;
+        }
+
+        if (m_fd[i] >= 0) {
+            ::close(m_fd[i]);
+            m_fd[i] = -1;
+        }
+    }
+
+    m_mask  = 0;
+    m_rdpmc = false;
+}
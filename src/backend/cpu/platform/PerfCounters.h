@@ -0,0 +1,102 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2019 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_PERFCOUNTERS_H
+#define XMRIG_PERFCOUNTERS_H
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class PerfCounters
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(PerfCounters)
+
+    enum Id : uint32_t {
+        Cycles,
+        Instructions,
+        LLCMisses,
+        DTLBMisses,
+        BranchMisses,
+        Max
+    };
+
+    struct Sample
+    {
+        inline bool isValid() const          { return mask != 0; }
+        inline bool has(Id id) const         { return (mask & (1U << id)) != 0; }
+        inline uint64_t value(Id id) const   { return values[id]; }
+
+        double perHash(Id id) const;
+        double ipc() const;
+        Sample since(const Sample &previous) const;
+
+        uint32_t mask           = 0;
+        uint64_t hashes         = 0;
+        uint64_t values[Max]    = {};
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    static const char *name(Id id);
+
+    inline bool isOpen() const      { return m_mask != 0; }
+    inline bool isRdpmc() const     { return m_rdpmc; }
+
+    bool open();
+    Sample snapshot() const;
+    void sample(uint64_t hashes);
+
+private:
+    bool readGroup(uint64_t *values) const;
+    bool readUser(uint64_t *values) const;
+    void close();
+
+    bool m_rdpmc                = false;
+    int m_fd[Max];
+    size_t m_pageSize           = 0;
+    std::atomic<uint32_t> m_sampleMask { 0 };
+    std::atomic<uint32_t> m_seq { 0 };
+    std::atomic<uint64_t> m_hashes { 0 };
+    std::atomic<uint64_t> m_values[Max];
+    uint32_t m_mask             = 0;
+    uint64_t m_ids[Max]         = {};
+    void *m_pages[Max]          = {};
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_PERFCOUNTERS_H */
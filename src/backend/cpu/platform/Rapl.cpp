@@ -0,0 +1,97 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <cstdio>
+#include <fstream>
+
+
+#include "backend/cpu/platform/Rapl.h"
+
+
+namespace xmrig {
+
+
+#ifdef __linux__
+static constexpr uint32_t kMaxZones = 64;
+
+
+static bool readValue(const std::string &path, uint64_t &value)
+{
+    std::ifstream file(path);
+
+    return static_cast<bool>(file >> value);
+}
+
+
+static std::string zonePath(uint32_t index, const char *file)
+{
+    char buf[64];
+    snprintf(buf, sizeof(buf), "/sys/class/powercap/intel-rapl:%u/", index);
+
+    return std::string(buf) + file;
+}
+#endif
+
+
+} // namespace xmrig
+
+
+xmrig::Rapl::Rapl()
+{
+#   ifdef __linux__
+    // Top level zones are CPU packages, subzones (intel-rapl:0:0) are already included in them.
+    for (uint32_t i = 0; i < kMaxZones; ++i) {
+        Zone zone;
+        zone.path = zonePath(i, "energy_uj");
+
+        if (readValue(zone.path, zone.energy) && readValue(zonePath(i, "max_energy_range_uj"), zone.range)) {
+            m_zones.emplace_back(std::move(zone));
+        }
+    }
+#   endif
+}
+
+
+/**
+ * Adds energy consumed by all packages since the previous read to the total returned by energy(), in microjoules.
+ */
+bool xmrig::Rapl::read()
+{
+#   ifdef __linux__
+    for (Zone &zone : m_zones) {
+        uint64_t energy = 0;
+        if (!readValue(zone.path, energy)) {
+            return false;
+        }
+
+        // The counter wraps at max_energy_range_uj.
+        m_energy   += energy >= zone.energy ? energy - zone.energy : zone.range - zone.energy + energy;
+        zone.energy = energy;
+    }
+#   endif
+
+    return isAvailable();
+}
@@ -452,6 +452,11 @@ void xmrig::CudaBackend::stop()
 }
 
 
+void xmrig::CudaBackend::stop(IWorker *)
+{
+}
+
+
 void xmrig::CudaBackend::tick(uint64_t ticks)
 {
     d_ptr->workers.tick(ticks);
@@ -523,4 +528,9 @@ rapidjson::Value xmrig::CudaBackend::toJSON(rapidjson::Document &doc) const
 void xmrig::CudaBackend::handleRequest(IApiRequest &)
 {
 }
+
+
+void xmrig::CudaBackend::toMetrics(Metrics &) const
+{
+}
 #endif
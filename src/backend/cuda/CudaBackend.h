@@ -62,11 +62,13 @@ protected:
     void setJob(const Job &job) override;
     void start(IWorker *worker, bool ready) override;
     void stop() override;
+    void stop(IWorker *worker) override;
     void tick(uint64_t ticks) override;
 
 #   ifdef XMRIG_FEATURE_API
     rapidjson::Value toJSON(rapidjson::Document &doc) const override;
     void handleRequest(IApiRequest &request) override;
+    void toMetrics(Metrics &metrics) const override;
 #   endif
 
 private:
@@ -382,6 +382,11 @@ void xmrig::OclBackend::stop()
 }
 
 
+void xmrig::OclBackend::stop(IWorker *)
+{
+}
+
+
 void xmrig::OclBackend::tick(uint64_t ticks)
 {
     d_ptr->workers.tick(ticks);
@@ -430,4 +435,9 @@ rapidjson::Value xmrig::OclBackend::toJSON(rapidjson::Document &doc) const
 void xmrig::OclBackend::handleRequest(IApiRequest &)
 {
 }
+
+
+void xmrig::OclBackend::toMetrics(Metrics &) const
+{
+}
 #endif
@@ -37,6 +37,9 @@
 #include "base/api/requests/HttpApiRequest.h"
 #include "base/io/json/Json.h"
 #include "base/kernel/Base.h"
+#include "base/kernel/Cgroup.h"
+#include "base/net/http/HttpApiResponse.h"
+#include "base/net/http/HttpData.h"
 #include "base/tools/Buffer.h"
 #include "base/tools/Chrono.h"
 #include "core/config/Config.h"
@@ -50,12 +53,19 @@
 #endif
 
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <thread>
 
 
 namespace xmrig {
 
 
+// Every format and encoding is encoded count times on the main loop, a higher limit would stall pool connections.
+static constexpr unsigned kMaxBenchmarkCount = 1000;
+
+
 static rapidjson::Value getResources(rapidjson::Document &doc)
 {
     using namespace rapidjson;
@@ -82,6 +92,7 @@ static rapidjson::Value getResources(rapidjson::Document &doc)
     out.AddMember("memory",               memory, allocator);
     out.AddMember("load_average",         load_average, allocator);
     out.AddMember("hardware_concurrency", std::thread::hardware_concurrency(), allocator);
+    out.AddMember("limits",               Cgroup::toJSON(doc), allocator);
 
     return out;
 }
@@ -191,6 +202,12 @@ void xmrig::Api::exec(IApiRequest &request)
         reply.AddMember("features", features, allocator);
     }
 
+    if (request.type() == IApiRequest::REQ_JSON_RPC && request.rpcMethod() == "api_benchmark") {
+        request.accept();
+
+        benchmark(request);
+    }
+
     for (IApiListener *listener : m_listeners) {
         listener->onRequest(request);
 
@@ -203,6 +220,71 @@ void xmrig::Api::exec(IApiRequest &request)
 }
 
 
+void xmrig::Api::benchmark(IApiRequest &request)
+{
+    using namespace rapidjson;
+    using namespace std::chrono;
+
+    static const char *formats[]   = { "json", "json-pretty", "cbor" };
+    static const char *encodings[] = { "identity", "gzip", "deflate" };
+
+    const Value &params = Json::getObject(request.json(), "params");
+    const char *url     = Json::getString(params, "url", "/2/backends");
+    const unsigned count = std::min(std::max(Json::getUint(params, "count", 100), 1U), kMaxBenchmarkCount);
+
+    HttpData data(std::numeric_limits<uint64_t>::max());
+    data.method = HTTP_GET;
+    data.url    = url;
+
+    HttpApiRequest target(data, true);
+    exec(target);
+
+    const Document &body = static_cast<IApiRequest &>(target).doc();
+
+    auto &allocator = request.doc().GetAllocator();
+    Value results(kArrayType);
+
+    for (int format = HttpApiResponse::JSON; format <= HttpApiResponse::CBOR; ++format) {
+        for (int encoding = HttpApiResponse::IDENTITY; encoding <= HttpApiResponse::DEFLATE; ++encoding) {
+#           ifndef XMRIG_FEATURE_ZLIB
+            if (encoding != HttpApiResponse::IDENTITY) {
+                continue;
+            }
+#           endif
+
+            auto applied = HttpApiResponse::IDENTITY;
+            size_t size  = 0;
+
+            const auto start = high_resolution_clock::now();
+
+            for (unsigned i = 0; i < count; ++i) {
+                applied = static_cast<HttpApiResponse::Encoding>(encoding);
+                size    = HttpApiResponse::encode(body, static_cast<HttpApiResponse::Format>(format), applied).second;
+            }
+
+            const double us = duration<double, std::micro>(high_resolution_clock::now() - start).count() / count;
+
+            // Bodies below the compression threshold are sent as is, report the encoding actually used.
+            Value result(kObjectType);
+            result.AddMember("format",    StringRef(formats[format]), allocator);
+            result.AddMember("requested", StringRef(encodings[encoding]), allocator);
+            result.AddMember("encoding",  StringRef(encodings[applied]), allocator);
+            result.AddMember("size",      static_cast<uint64_t>(size), allocator);
+            result.AddMember("time",      Json::normalize(us, true), allocator);
+
+            results.PushBack(result, allocator);
+        }
+    }
+
+    Value out(kObjectType);
+    out.AddMember("url",     Value(url, allocator), allocator);
+    out.AddMember("count",   count, allocator);
+    out.AddMember("results", results, allocator);
+
+    request.reply().AddMember("result", out, allocator);
+}
+
+
 void xmrig::Api::genId(const String &id)
 {
     memset(m_id, 0, sizeof(m_id));
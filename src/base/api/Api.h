@@ -30,6 +30,8 @@
 #include <cstdint>
 
 
+#include "base/api/EventStream.h"
+#include "base/api/Metrics.h"
 #include "base/kernel/interfaces/IBaseListener.h"
 #include "base/tools/Object.h"
 
@@ -55,6 +57,8 @@ public:
 
     inline const char *id() const                   { return m_id; }
     inline const char *workerId() const             { return m_workerId; }
+    inline EventStream &events()                    { return m_events; }
+    inline Metrics &metrics()                       { return m_metrics; }
     inline void addListener(IApiListener *listener) { m_listeners.push_back(listener); }
 
     void request(const HttpData &req);
@@ -65,6 +69,7 @@ protected:
     void onConfigChanged(Config *config, Config *previousConfig) override;
 
 private:
+    void benchmark(IApiRequest &request);
     void exec(IApiRequest &request);
     void genId(const String &id);
     void genWorkerId(const String &id);
@@ -73,7 +78,9 @@ private:
     char m_id[32]{};
     char m_workerId[128]{};
     const uint64_t m_timestamp;
+    EventStream m_events;
     Httpd *m_httpd = nullptr;
+    Metrics m_metrics;
     std::vector<IApiListener *> m_listeners;
 };
 
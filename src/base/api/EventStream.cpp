@@ -0,0 +1,178 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <algorithm>
+#include <uv.h>
+
+
+#include "base/api/EventStream.h"
+#include "base/net/http/HttpContext.h"
+#include "base/tools/Baton.h"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+
+namespace xmrig {
+
+
+static const char *kHeaders = "HTTP/1.1 200 OK\r\n"
+                              "Content-Type: text/event-stream\r\n"
+                              "Cache-Control: no-cache\r\n"
+                              "Access-Control-Allow-Origin: *\r\n"
+                              "\r\n"
+                              "retry: 5000\n\n";
+
+
+class EventStream::Client
+{
+public:
+    inline Client(uint64_t id) : id(id) {}
+
+    bool closed         = false;
+    const uint64_t id;
+    size_t pending      = 0;
+    uint64_t dropped    = 0;
+};
+
+
+class EventStream::WriteBaton : public Baton<uv_write_t>
+{
+public:
+    inline WriteBaton(const std::shared_ptr<EventStream::Client> &client, const std::shared_ptr<std::string> &message) :
+        client(client),
+        message(message)
+    {
+        buf.base = const_cast<char *>(message->data());
+        buf.len  = message->size();
+    }
+
+    std::shared_ptr<EventStream::Client> client;
+    std::shared_ptr<std::string> message;
+    uv_buf_t buf{};
+};
+
+
+} // namespace xmrig
+
+
+xmrig::EventStream::EventStream() = default;
+xmrig::EventStream::~EventStream() = default;
+
+
+void xmrig::EventStream::add(const HttpData &req)
+{
+    if (!HttpContext::get(req.id())) {
+        return;
+    }
+
+    auto client = std::make_shared<Client>(req.id());
+    m_clients.push_back(client);
+
+    write(client, std::make_shared<std::string>(kHeaders));
+}
+
+
+void xmrig::EventStream::send(const char *event, const rapidjson::Value &data)
+{
+    using namespace rapidjson;
+
+    if (!isActive()) {
+        return;
+    }
+
+    StringBuffer buffer(nullptr, 512);
+    Writer<StringBuffer> writer(buffer);
+    writer.SetMaxDecimalPlaces(2);
+    data.Accept(writer);
+
+    auto message = std::make_shared<std::string>();
+    message->reserve(buffer.GetSize() + 32);
+    *message += "event: ";
+    *message += event;
+    *message += "\ndata: ";
+    message->append(buffer.GetString(), buffer.GetSize());
+    *message += "\n\n";
+
+    send(std::move(message));
+}
+
+
+void xmrig::EventStream::send(std::shared_ptr<std::string> &&message)
+{
+    for (const auto &client : m_clients) {
+        write(client, message);
+    }
+
+    m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), [](const std::shared_ptr<Client> &client) { return client->closed; }), m_clients.end());
+}
+
+
+void xmrig::EventStream::write(const std::shared_ptr<Client> &client, const std::shared_ptr<std::string> &message)
+{
+    HttpContext *ctx = HttpContext::get(client->id);
+    if (!ctx || client->closed || !uv_is_writable(ctx->stream())) {
+        client->closed = true;
+
+        return;
+    }
+
+    if (client->pending + message->size() > kMaxPending) {
+        client->dropped++;
+
+        return;
+    }
+
+    if (client->dropped) {
+        push(ctx, client, std::make_shared<std::string>("event: dropped\ndata: {\"count\":" + std::to_string(client->dropped) + "}\n\n"));
+        client->dropped = 0;
+    }
+
+    push(ctx, client, message);
+}
+
+
+void xmrig::EventStream::push(HttpContext *ctx, const std::shared_ptr<Client> &client, const std::shared_ptr<std::string> &message)
+{
+    auto baton = new WriteBaton(client, message);
+    client->pending += message->size();
+
+    uv_write(&baton->req, ctx->stream(), &baton->buf, 1, [](uv_write_t *req, int status) {
+        auto baton = static_cast<WriteBaton *>(req->data);
+        baton->client->pending -= baton->message->size();
+
+        if (status < 0 && !baton->client->closed) {
+            baton->client->closed = true;
+
+            HttpContext *ctx = HttpContext::get(baton->client->id);
+            if (ctx) {
+                ctx->close();
+            }
+        }
+
+        delete baton;
+    });
+}
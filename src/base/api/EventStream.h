@@ -0,0 +1,85 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_EVENTSTREAM_H
+#define XMRIG_EVENTSTREAM_H
+
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+#include "base/tools/Object.h"
+#include "rapidjson/fwd.h"
+
+
+namespace xmrig {
+
+
+class HttpContext;
+class HttpData;
+
+
+/**
+ * Server-Sent Events for GET /events.
+ *
+ * Every event is formatted once and shared by all subscribers. Each subscriber
+ * may have at most kMaxPending bytes not yet accepted by the socket, events
+ * above this limit are dropped for that subscriber only and reported with
+ * a "dropped" event when it catches up.
+ */
+class EventStream
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(EventStream)
+
+    constexpr static size_t kMaxPending = 256 * 1024;
+
+    EventStream();
+    ~EventStream();
+
+    inline bool isActive() const { return !m_clients.empty(); }
+
+    void add(const HttpData &req);
+    void send(const char *event, const rapidjson::Value &data);
+
+private:
+    class Client;
+    class WriteBaton;
+
+    static void push(HttpContext *ctx, const std::shared_ptr<Client> &client, const std::shared_ptr<std::string> &message);
+
+    void send(std::shared_ptr<std::string> &&message);
+    void write(const std::shared_ptr<Client> &client, const std::shared_ptr<std::string> &message);
+
+    std::vector<std::shared_ptr<Client> > m_clients;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_EVENTSTREAM_H */
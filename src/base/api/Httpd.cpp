@@ -154,6 +154,19 @@ void xmrig::Httpd::onHttpData(const HttpData &data)
         return HttpApiResponse(data.id(), status).end();
     }
 
+    if (data.method == HTTP_GET && data.url == "/metrics") {
+        const std::string &metrics = m_base->api()->metrics().data();
+
+        HttpResponse response(data.id());
+        response.setHeader("Content-Type", "application/openmetrics-text; version=1.0.0; charset=utf-8");
+
+        return response.end(metrics.data(), metrics.size());
+    }
+
+    if (data.method == HTTP_GET && data.url == "/events") {
+        return m_base->api()->events().add(data);
+    }
+
     if (data.method != HTTP_GET) {
         if (m_base->config()->http().isRestricted()) {
             return HttpApiResponse(data.id(), HTTP_STATUS_FORBIDDEN).end();
@@ -0,0 +1,161 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+
+#include "base/api/Metrics.h"
+
+
+namespace xmrig {
+
+
+static const char *kEOF = "# EOF\n";
+
+
+// Release builds use -Ofast, which folds std::isnan() to false.
+static inline bool isNaN(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    return (bits & 0x7ff0000000000000ULL) == 0x7ff0000000000000ULL && (bits & 0x000fffffffffffffULL) != 0;
+}
+
+
+static void sample(std::string &out, const char *name, const char *labels, const char *value)
+{
+    out += name;
+
+    if (labels && *labels) {
+        out += '{';
+        out += labels;
+        out += '}';
+    }
+
+    out += ' ';
+    out += value;
+    out += '\n';
+}
+
+
+} // namespace xmrig
+
+
+xmrig::Metrics::Metrics() :
+    m_current(&m_sections[MinerSection]),
+    m_data(kEOF)
+{
+}
+
+
+std::string xmrig::Metrics::escape(const char *value)
+{
+    std::string out;
+
+    for (const char *p = value; p && *p; ++p) {
+        switch (*p) {
+        case '\\':
+            out += "\\\\";
+            break;
+
+        case '"':
+            out += "\\\"";
+            break;
+
+        case '\n':
+            out += "\\n";
+            break;
+
+        default:
+            out += *p;
+            break;
+        }
+    }
+
+    return out;
+}
+
+
+void xmrig::Metrics::add(const char *name, const char *labels, double value)
+{
+    char buf[32];
+
+    if (isNaN(value)) {
+        sample(*m_current, name, labels, "NaN");
+
+        return;
+    }
+
+    snprintf(buf, sizeof(buf), "%.3f", value);
+    sample(*m_current, name, labels, buf);
+}
+
+
+void xmrig::Metrics::add(const char *name, const char *labels, uint64_t value)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%" PRIu64, value);
+
+    sample(*m_current, name, labels, buf);
+}
+
+
+void xmrig::Metrics::begin(Section section)
+{
+    m_current = &m_sections[section];
+    m_current->clear();
+}
+
+
+void xmrig::Metrics::family(const char *name, const char *type, const char *help)
+{
+    std::string &out = *m_current;
+
+    out += "# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += "\n# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += '\n';
+}
+
+
+void xmrig::Metrics::publish()
+{
+    m_data.clear();
+
+    for (const std::string &section : m_sections) {
+        m_data += section;
+    }
+
+    m_data += kEOF;
+}
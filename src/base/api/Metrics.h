@@ -0,0 +1,81 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_METRICS_H
+#define XMRIG_METRICS_H
+
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+/**
+ * Pre-rendered OpenMetrics text served by GET /metrics.
+ *
+ * Each owner rewrites only its own section when its data changes, the miner
+ * tick joins all sections into the published buffer, so a scrape is a plain
+ * copy of already formatted text.
+ */
+class Metrics
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(Metrics)
+
+    enum Section {
+        MinerSection,
+        NetworkSection,
+        MaxSection
+    };
+
+    Metrics();
+
+    inline const std::string &data() const { return m_data; }
+
+    static std::string escape(const char *value);
+
+    void add(const char *name, const char *labels, double value);
+    void add(const char *name, const char *labels, uint64_t value);
+    void begin(Section section);
+    void family(const char *name, const char *type, const char *help);
+    void publish();
+
+private:
+    std::array<std::string, MaxSection> m_sections;
+    std::string *m_current;
+    std::string m_data;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_METRICS_H */
@@ -9,7 +9,9 @@ set(HEADERS_BASE
     src/base/io/log/Log.h
     src/base/io/Watcher.h
     src/base/kernel/Base.h
+    src/base/kernel/Cgroup.h
     src/base/kernel/config/BaseConfig.h
+    src/base/kernel/config/ConfigDiff.h
     src/base/kernel/config/BaseTransform.h
     src/base/kernel/Entry.h
     src/base/kernel/interfaces/IBaseListener.h
@@ -25,12 +27,14 @@ set(HEADERS_BASE
     src/base/kernel/interfaces/ISignalListener.h
     src/base/kernel/interfaces/IStrategy.h
     src/base/kernel/interfaces/IStrategyListener.h
+    src/base/kernel/interfaces/ITcpConnectorListener.h
     src/base/kernel/interfaces/ITimerListener.h
     src/base/kernel/interfaces/IWatcherListener.h
     src/base/kernel/Platform.h
     src/base/kernel/Process.h
     src/base/kernel/Signals.h
     src/base/net/dns/Dns.h
+    src/base/net/dns/DnsConfig.h
     src/base/net/dns/DnsRecord.h
     src/base/net/http/Http.h
     src/base/net/stratum/BaseClient.h
@@ -40,10 +44,12 @@ set(HEADERS_BASE
     src/base/net/stratum/Pools.h
     src/base/net/stratum/strategies/FailoverStrategy.h
     src/base/net/stratum/strategies/SinglePoolStrategy.h
+    src/base/net/stratum/strategies/WeightedStrategy.h
     src/base/net/stratum/SubmitResult.h
     src/base/net/stratum/Url.h
     src/base/net/tools/RecvBuf.h
     src/base/net/tools/Storage.h
+    src/base/net/tools/TcpConnector.h
     src/base/tools/Arguments.h
     src/base/tools/Baton.h
     src/base/tools/Buffer.h
@@ -63,13 +69,16 @@ set(SOURCES_BASE
     src/base/io/log/Log.cpp
     src/base/io/Watcher.cpp
     src/base/kernel/Base.cpp
+    src/base/kernel/Cgroup.cpp
     src/base/kernel/config/BaseConfig.cpp
+    src/base/kernel/config/ConfigDiff.cpp
     src/base/kernel/config/BaseTransform.cpp
     src/base/kernel/Entry.cpp
     src/base/kernel/Platform.cpp
     src/base/kernel/Process.cpp
     src/base/kernel/Signals.cpp
     src/base/net/dns/Dns.cpp
+    src/base/net/dns/DnsConfig.cpp
     src/base/net/dns/DnsRecord.cpp
     src/base/net/http/Http.cpp
     src/base/net/stratum/BaseClient.cpp
@@ -79,7 +88,9 @@ set(SOURCES_BASE
     src/base/net/stratum/Pools.cpp
     src/base/net/stratum/strategies/FailoverStrategy.cpp
     src/base/net/stratum/strategies/SinglePoolStrategy.cpp
+    src/base/net/stratum/strategies/WeightedStrategy.cpp
     src/base/net/stratum/Url.cpp
+    src/base/net/tools/TcpConnector.cpp
     src/base/tools/Arguments.cpp
     src/base/tools/Buffer.cpp
     src/base/tools/String.cpp
@@ -125,38 +136,51 @@ if (WITH_HTTP)
     set(HEADERS_BASE_HTTP
         src/3rdparty/http-parser/http_parser.h
         src/base/api/Api.h
+        src/base/api/EventStream.h
         src/base/api/Httpd.h
+        src/base/api/Metrics.h
         src/base/api/interfaces/IApiRequest.h
         src/base/api/requests/ApiRequest.h
         src/base/api/requests/HttpApiRequest.h
+        src/base/io/json/CborWriter.h
         src/base/kernel/interfaces/IHttpListener.h
         src/base/kernel/interfaces/IJsonReader.h
         src/base/kernel/interfaces/ITcpServerListener.h
+        src/base/kernel/interfaces/IZmqListener.h
         src/base/net/http/HttpApiResponse.h
         src/base/net/http/HttpClient.h
         src/base/net/http/HttpContext.h
         src/base/net/http/HttpData.h
+        src/base/net/http/HttpPool.h
         src/base/net/http/HttpResponse.h
         src/base/net/http/HttpServer.h
+        src/base/net/stratum/BlockTemplate.h
         src/base/net/stratum/DaemonClient.h
         src/base/net/stratum/SelfSelectClient.h
         src/base/net/tools/TcpServer.h
+        src/base/net/zmq/ZmqSubscriber.h
         )
 
     set(SOURCES_BASE_HTTP
         src/3rdparty/http-parser/http_parser.c
         src/base/api/Api.cpp
+        src/base/api/EventStream.cpp
         src/base/api/Httpd.cpp
+        src/base/api/Metrics.cpp
         src/base/api/requests/ApiRequest.cpp
         src/base/api/requests/HttpApiRequest.cpp
+        src/base/io/json/CborWriter.cpp
         src/base/net/http/HttpApiResponse.cpp
         src/base/net/http/HttpClient.cpp
         src/base/net/http/HttpContext.cpp
+        src/base/net/http/HttpPool.cpp
         src/base/net/http/HttpResponse.cpp
         src/base/net/http/HttpServer.cpp
+        src/base/net/stratum/BlockTemplate.cpp
         src/base/net/stratum/DaemonClient.cpp
         src/base/net/stratum/SelfSelectClient.cpp
         src/base/net/tools/TcpServer.cpp
+        src/base/net/zmq/ZmqSubscriber.cpp
         )
 
     add_definitions(/DXMRIG_FEATURE_HTTP)
@@ -0,0 +1,211 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <cstring>
+
+
+#include "base/io/json/CborWriter.h"
+#include "rapidjson/stringbuffer.h"
+
+
+namespace xmrig {
+
+
+enum CborMajor : uint8_t {
+    kUnsigned   = 0,
+    kNegative   = 1,
+    kText       = 3,
+    kArray      = 4,
+    kMap        = 5
+};
+
+
+static constexpr uint8_t kFalse       = 0xf4;
+static constexpr uint8_t kTrue        = 0xf5;
+static constexpr uint8_t kNull        = 0xf6;
+static constexpr uint8_t kFloat64     = 0xfb;
+static constexpr uint8_t kBreak       = 0xff;
+static constexpr uint8_t kIndefinite  = 31;
+
+
+} // namespace xmrig
+
+
+bool xmrig::CborWriter::Bool(bool b)
+{
+    put(b ? kTrue : kFalse);
+
+    return true;
+}
+
+
+bool xmrig::CborWriter::Double(double d)
+{
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+
+    auto out = reinterpret_cast<uint8_t *>(m_out.Push(9));
+    out[0]   = kFloat64;
+
+    for (size_t i = 0; i < 8; ++i) {
+        out[8 - i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+
+    return true;
+}
+
+
+bool xmrig::CborWriter::EndArray(rapidjson::SizeType)
+{
+    put(kBreak);
+
+    return true;
+}
+
+
+bool xmrig::CborWriter::EndObject(rapidjson::SizeType)
+{
+    put(kBreak);
+
+    return true;
+}
+
+
+bool xmrig::CborWriter::Int(int i)
+{
+    return Int64(i);
+}
+
+
+bool xmrig::CborWriter::Int64(int64_t i)
+{
+    if (i < 0) {
+        head(kNegative, static_cast<uint64_t>(-(i + 1)));
+    }
+    else {
+        head(kUnsigned, static_cast<uint64_t>(i));
+    }
+
+    return true;
+}
+
+
+bool xmrig::CborWriter::Null()
+{
+    put(kNull);
+
+    return true;
+}
+
+
+bool xmrig::CborWriter::RawNumber(const Ch *str, rapidjson::SizeType length, bool copy)
+{
+    return String(str, length, copy);
+}
+
+
+bool xmrig::CborWriter::StartArray()
+{
+    put((kArray << 5) | kIndefinite);
+
+    return true;
+}
+
+
+bool xmrig::CborWriter::StartObject()
+{
+    put((kMap << 5) | kIndefinite);
+
+    return true;
+}
+
+
+bool xmrig::CborWriter::String(const Ch *str, rapidjson::SizeType length, bool)
+{
+    head(kText, length);
+    memcpy(m_out.Push(length), str, length);
+
+    return true;
+}
+
+
+bool xmrig::CborWriter::Uint(unsigned u)
+{
+    head(kUnsigned, u);
+
+    return true;
+}
+
+
+bool xmrig::CborWriter::Uint64(uint64_t u)
+{
+    head(kUnsigned, u);
+
+    return true;
+}
+
+
+void xmrig::CborWriter::head(uint8_t major, uint64_t value)
+{
+    const uint8_t type = static_cast<uint8_t>(major << 5);
+
+    if (value < 24) {
+        return put(type | static_cast<uint8_t>(value));
+    }
+
+    size_t bytes;
+    uint8_t info;
+
+    if (value <= 0xff) {
+        bytes = 1;
+        info  = 24;
+    }
+    else if (value <= 0xffff) {
+        bytes = 2;
+        info  = 25;
+    }
+    else if (value <= 0xffffffff) {
+        bytes = 4;
+        info  = 26;
+    }
+    else {
+        bytes = 8;
+        info  = 27;
+    }
+
+    auto out = reinterpret_cast<uint8_t *>(m_out.Push(bytes + 1));
+    out[0]   = type | info;
+
+    for (size_t i = 0; i < bytes; ++i) {
+        out[bytes - i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+
+void xmrig::CborWriter::put(uint8_t byte)
+{
+    m_out.Put(static_cast<char>(byte));
+}
@@ -0,0 +1,80 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_CBORWRITER_H
+#define XMRIG_CBORWRITER_H
+
+
+#include <cstdint>
+
+
+#include "rapidjson/fwd.h"
+#include "rapidjson/rapidjson.h"
+
+
+namespace xmrig {
+
+
+/**
+ * rapidjson SAX handler producing CBOR (RFC 8949).
+ *
+ * Objects and arrays are written as indefinite length items, so a document is
+ * encoded in one pass with doc.Accept(writer) like with rapidjson::Writer.
+ */
+class CborWriter
+{
+public:
+    using Ch = char;
+
+    inline CborWriter(rapidjson::StringBuffer &out) : m_out(out) {}
+
+    bool Bool(bool b);
+    bool Double(double d);
+    bool EndArray(rapidjson::SizeType count = 0);
+    bool EndObject(rapidjson::SizeType count = 0);
+    bool Int(int i);
+    bool Int64(int64_t i);
+    bool Null();
+    bool RawNumber(const Ch *str, rapidjson::SizeType length, bool copy = false);
+    bool StartArray();
+    bool StartObject();
+    bool String(const Ch *str, rapidjson::SizeType length, bool copy = false);
+    bool Uint(unsigned u);
+    bool Uint64(uint64_t u);
+
+    inline bool Key(const Ch *str, rapidjson::SizeType length, bool copy = false) { return String(str, length, copy); }
+
+private:
+    void head(uint8_t major, uint64_t value);
+    void put(uint8_t byte);
+
+    rapidjson::StringBuffer &m_out;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CBORWRITER_H */
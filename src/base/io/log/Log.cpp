@@ -31,10 +31,16 @@
 
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cinttypes>
 #include <cstring>
 #include <ctime>
+#include <memory>
 #include <mutex>
-#include <string>
+#include <thread>
 #include <uv.h>
 #include <vector>
 
@@ -64,6 +70,130 @@ static const char *colors_map[] = {
 };
 
 
+/**
+ * Single producer, single consumer ring of log records, each thread that logs owns one ring and only the writer
+ * thread reads from it, so neither side ever takes a lock.
+ */
+class LogRing
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(LogRing)
+
+    constexpr static size_t kSize = 64 * 1024;
+
+    struct Record
+    {
+        uint32_t size;          // total size including this header, 0 marks padding up to the end of the ring.
+        int32_t level;
+        uint32_t offset;
+        uint32_t plainOffset;
+        uint32_t coloredSize;
+        uint32_t plainSize;
+        uint64_t seq;
+
+        inline const char *colored() const  { return reinterpret_cast<const char *>(this + 1); }
+        inline const char *plain() const    { return colored() + coloredSize + 1; }
+    };
+
+    LogRing() = default;
+
+    inline bool isClosed() const    { return m_closed.load(std::memory_order_acquire); }
+    inline bool isEmpty() const     { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed); }
+    inline bool isWriting() const   { return m_writing.load(std::memory_order_seq_cst); }
+    inline void close()             { m_closed.store(true, std::memory_order_release); }
+
+
+    // The sequence number is taken inside the writing window, so the reader can tell when every number below its watermark is published.
+    bool push(int level, std::atomic<uint64_t> &sequence, const char *colored, size_t coloredSize, size_t offset, const char *plain, size_t plainSize, size_t plainOffset)
+    {
+        m_writing.store(true, std::memory_order_seq_cst);
+        const bool rc = push(level, sequence.fetch_add(1, std::memory_order_seq_cst), colored, coloredSize, offset, plain, plainSize, plainOffset);
+        m_writing.store(false, std::memory_order_release);
+
+        return rc;
+    }
+
+
+    // Collects published records below the watermark without releasing them, release() must be called once they are printed.
+    void peek(std::vector<const Record *> &out, uint64_t watermark)
+    {
+        const size_t head = m_head.load(std::memory_order_acquire);
+        size_t tail       = m_tail.load(std::memory_order_relaxed);
+
+        while (tail != head) {
+            const size_t pos = tail % kSize;
+            auto record      = reinterpret_cast<const Record *>(m_data + pos);
+
+            if (record->size == 0) {
+                tail += kSize - pos;
+                continue;
+            }
+
+            if (record->seq >= watermark) {
+                break;
+            }
+
+            out.push_back(record);
+            tail += record->size;
+        }
+
+        m_peek = tail;
+    }
+
+
+    inline void release() { m_tail.store(m_peek, std::memory_order_release); }
+
+private:
+    constexpr static inline size_t align(size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+
+
+    bool push(int level, uint64_t seq, const char *colored, size_t coloredSize, size_t offset, const char *plain, size_t plainSize, size_t plainOffset)
+    {
+        const size_t size = align(sizeof(Record) + coloredSize + plainSize + 2);
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        const size_t pos  = head % kSize;
+        const size_t pad  = (kSize - pos < size) ? kSize - pos : 0;
+
+        if (kSize - (head - tail) < size + pad) {
+            return false;
+        }
+
+        if (pad) {
+            reinterpret_cast<Record *>(m_data + pos)->size = 0;
+        }
+
+        auto record         = reinterpret_cast<Record *>(m_data + (head + pad) % kSize);
+        record->size        = static_cast<uint32_t>(size);
+        record->level       = level;
+        record->offset      = static_cast<uint32_t>(offset);
+        record->plainOffset = static_cast<uint32_t>(plainOffset);
+        record->coloredSize = static_cast<uint32_t>(coloredSize);
+        record->plainSize   = static_cast<uint32_t>(plainSize);
+        record->seq         = seq;
+
+        auto data = const_cast<char *>(record->colored());
+        memcpy(data, colored, coloredSize);
+        data[coloredSize] = '\0';
+
+        data = const_cast<char *>(record->plain());
+        memcpy(data, plain, plainSize);
+        data[plainSize] = '\0';
+
+        m_head.store(head + pad + size, std::memory_order_release);
+
+        return true;
+    }
+
+
+    alignas(8) char m_data[kSize];
+    size_t m_peek = 0;
+    std::atomic<bool> m_closed{ false };
+    std::atomic<bool> m_writing{ false };
+    std::atomic<size_t> m_head{ 0 };
+    std::atomic<size_t> m_tail{ 0 };
+};
+
 
 class LogPrivate
 {
@@ -76,58 +206,201 @@ public:
 
     inline ~LogPrivate()
     {
+        stop();
+
         for (ILogBackend *backend : m_backends) {
             delete backend;
         }
     }
 
 
-    inline void add(ILogBackend *backend) { m_backends.push_back(backend); }
+    inline void add(ILogBackend *backend)
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_backends.push_back(backend);
+    }
 
 
     void print(Log::Level level, const char *fmt, va_list args)
     {
+        thread_local char buf[kBufSize];
+        thread_local char plain[kBufSize];
+
         size_t size   = 0;
         size_t offset = 0;
 
-        std::lock_guard<std::mutex> lock(m_mutex);
+        timestamp(buf, level, size, offset);
+        color(buf, level, size);
 
-        if (Log::background && m_backends.empty()) {
+        const int rc = vsnprintf(buf + size, sizeof (buf) - offset - 32, fmt, args);
+        if (rc < 0) {
             return;
         }
 
-        timestamp(level, size, offset);
-        color(level, size);
+        size += std::min(static_cast<size_t>(rc), sizeof (buf) - offset - 32);
+        endl(buf, size);
 
-        const int rc = vsnprintf(m_buf + size, sizeof (m_buf) - offset - 32, fmt, args);
-        if (rc < 0) {
+        size_t plainOffset = 0;
+        const size_t plainSize = strip(buf, size, offset, plain, plainOffset);
+
+        if (!ring()->push(level, m_seq, buf, size, offset, plain, plainSize, plainOffset)) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        wake();
+    }
+
+
+    void stop()
+    {
+        if (!m_thread.joinable()) {
             return;
         }
 
-        size += std::min(static_cast<size_t>(rc), sizeof (m_buf) - offset - 32);
-        endl(size);
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_stop = true;
+        }
+
+        m_cv.notify_one();
+        m_thread.join();
+    }
+
+
+private:
+    constexpr static size_t kBufSize = 4096;
+
+    struct RingHolder
+    {
+        inline ~RingHolder() { if (ring) { ring->close(); } }
 
-        std::string txt(m_buf);
-        size_t i;
-        while ((i = txt.find(CSI)) != std::string::npos) {
-            txt.erase(i, txt.find('m', i) - i + 1);
+        std::shared_ptr<LogRing> ring;
+    };
+
+
+    inline void wake()
+    {
+        if (!m_pending.exchange(true, std::memory_order_acq_rel)) {
+            m_cv.notify_one();
+        }
+    }
+
+
+    LogRing *ring()
+    {
+        thread_local RingHolder holder;
+
+        if (!holder.ring) {
+            holder.ring = std::make_shared<LogRing>();
+
+            {
+                std::lock_guard<std::mutex> lock(m_ringsMutex);
+                m_rings.push_back(holder.ring);
+            }
+
+            std::call_once(m_started, [this] {
+                m_thread = std::thread(&LogPrivate::run, this);
+                std::atexit(Log::destroy);
+            });
+        }
+
+        return holder.ring.get();
+    }
+
+
+    void drain()
+    {
+        // Every sequence number below the watermark belongs to a ring that is already registered and is published once
+        // that ring is not in the middle of a push. Newer records stay in the rings until the next drain, so records from
+        // different threads are printed in the order they were logged.
+        const uint64_t watermark = m_seq.load(std::memory_order_seq_cst);
+
+        std::vector<std::shared_ptr<LogRing> > rings;
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            rings = m_rings;
+        }
+
+        for (auto &ring : rings) {
+            while (ring->isWriting()) {
+                std::this_thread::yield();
+            }
+        }
+
+        m_records.clear();
+        for (auto &ring : rings) {
+            ring->peek(m_records, watermark);
+        }
+
+        std::sort(m_records.begin(), m_records.end(), [](const LogRing::Record *a, const LogRing::Record *b) { return a->seq < b->seq; });
+
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+
+        for (auto record : m_records) {
+            write(record->level, record->colored(), record->offset, record->coloredSize, record->plain(), record->plainOffset, record->plainSize);
+        }
+
+        const uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped) {
+            char buf[64];
+            const int size = snprintf(buf, sizeof(buf), "log: %" PRIu64 " message(s) dropped\n", dropped);
+
+            write(Log::WARNING, buf, 0, static_cast<size_t>(size), buf, 0, static_cast<size_t>(size));
+        }
+
+        for (ILogBackend *backend : m_backends) {
+            backend->flush();
         }
 
+        if (m_backends.empty() && !m_records.empty()) {
+            fflush(stdout);
+        }
+
+        for (auto &ring : rings) {
+            ring->release();
+        }
+
+        std::lock_guard<std::mutex> ringsLock(m_ringsMutex);
+        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [](const std::shared_ptr<LogRing> &ring) { return ring->isClosed() && ring->isEmpty(); }), m_rings.end());
+    }
+
+
+    void run()
+    {
+        while (true) {
+            bool stop = false;
+            {
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                m_cv.wait_for(lock, std::chrono::milliseconds(100), [this] { return m_stop || m_pending.load(std::memory_order_acquire); });
+
+                stop = m_stop;
+            }
+
+            m_pending.store(false, std::memory_order_release);
+            drain();
+
+            if (stop) {
+                return;
+            }
+        }
+    }
+
+
+    void write(int level, const char *colored, size_t offset, size_t coloredSize, const char *plain, size_t plainOffset, size_t plainSize)
+    {
         if (!m_backends.empty()) {
             for (ILogBackend *backend : m_backends) {
-                backend->print(level, m_buf, offset, size, true);
-                backend->print(level, txt.c_str(), offset ? (offset - 11) : 0, txt.size(), false);
+                backend->print(level, colored, offset, coloredSize, true);
+                backend->print(level, plain, plainOffset, plainSize, false);
             }
         }
-        else {
-            fputs(txt.c_str(), stdout);
-            fflush(stdout);
+        else if (!Log::background) {
+            fputs(plain, stdout);
         }
     }
 
 
-private:
-    inline void timestamp(Log::Level level, size_t &size, size_t &offset)
+    static inline void timestamp(char *buf, Log::Level level, size_t &size, size_t &offset)
     {
         if (level == Log::NONE) {
             return;
@@ -143,7 +416,7 @@ private:
         localtime_r(&now, &stime);
 #       endif
 
-        const int rc = snprintf(m_buf, sizeof(m_buf) - 1, "[%d-%02d-%02d %02d:%02d:%02d" BLACK_BOLD(".%03d") "] ",
+        const int rc = snprintf(buf, kBufSize - 1, "[%d-%02d-%02d %02d:%02d:%02d" BLACK_BOLD(".%03d") "] ",
                                 stime.tm_year + 1900,
                                 stime.tm_mon + 1,
                                 stime.tm_mday,
@@ -159,7 +432,7 @@ private:
     }
 
 
-    inline void color(Log::Level level, size_t &size)
+    static inline void color(char *buf, Log::Level level, size_t &size)
     {
         if (level == Log::NONE) {
             return;
@@ -171,27 +444,69 @@ private:
         }
 
         const size_t s = strlen(color);
-        memcpy(m_buf + size, color, s);
+        memcpy(buf + size, color, s);
 
         size += s;
     }
 
 
-    inline void endl(size_t &size)
+    static inline void endl(char *buf, size_t &size)
     {
 #       ifdef _WIN32
-        memcpy(m_buf + size, CLEAR "\r\n", 7);
+        memcpy(buf + size, CLEAR "\r\n", 7);
         size += 6;
 #       else
-        memcpy(m_buf + size, CLEAR "\n", 6);
+        memcpy(buf + size, CLEAR "\n", 6);
         size += 5;
 #       endif
     }
 
 
-    char m_buf[4096]{};
-    std::mutex m_mutex;
+    // Removes escape sequences in a single pass and maps the message offset to the plain text.
+    static size_t strip(const char *in, size_t size, size_t offset, char *out, size_t &outOffset)
+    {
+        size_t pos = 0;
+
+        for (size_t i = 0; i < size; ++i) {
+            if (i == offset) {
+                outOffset = pos;
+            }
+
+            if (in[i] == '\x1B' && i + 1 < size && in[i + 1] == '[') {
+                const char *end = static_cast<const char *>(memchr(in + i, 'm', size - i));
+                if (end) {
+                    const size_t next = static_cast<size_t>(end - in);
+                    if (offset > i && offset <= next) {
+                        outOffset = pos;
+                    }
+
+                    i = next;
+                    continue;
+                }
+            }
+
+            out[pos++] = in[i];
+        }
+
+        out[pos] = '\0';
+
+        return pos;
+    }
+
+
+    bool m_stop = false;
+    std::atomic<bool> m_pending{ false };
+    std::atomic<uint64_t> m_dropped{ 0 };
+    std::atomic<uint64_t> m_seq{ 0 };
+    std::condition_variable m_cv;
+    std::mutex m_ringsMutex;
+    std::mutex m_wakeMutex;
+    std::mutex m_writeMutex;
+    std::once_flag m_started;
+    std::thread m_thread;
+    std::vector<const LogRing::Record *> m_records;
     std::vector<ILogBackend*> m_backends;
+    std::vector<std::shared_ptr<LogRing> > m_rings;
 };
 
 
@@ -69,6 +69,14 @@ xmrig::ConsoleLog::~ConsoleLog()
 }
 
 
+void xmrig::ConsoleLog::flush()
+{
+    if (m_tty) {
+        fflush(stdout);
+    }
+}
+
+
 void xmrig::ConsoleLog::print(int, const char *line, size_t, size_t size, bool colors)
 {
     if (!m_tty || Log::colors != colors) {
@@ -80,14 +88,12 @@ void xmrig::ConsoleLog::print(int, const char *line, size_t, size_t size, bool c
 
     if (!isWritable()) {
         fputs(line, stdout);
-        fflush(stdout);
     }
     else {
         uv_try_write(m_stream, &buf, 1);
     }
 #   else
     fputs(line, stdout);
-    fflush(stdout);
 #   endif
 }
 
@@ -47,6 +47,7 @@ public:
     ~ConsoleLog() override;
 
 protected:
+    void flush() override;
     void print(int level, const char *line, size_t offset, size_t size, bool colors) override;
 
 private:
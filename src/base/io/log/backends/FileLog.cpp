@@ -24,44 +24,37 @@
  */
 
 
-#include <string.h>
-#include <uv.h>
-
-
 #include "base/io/log/backends/FileLog.h"
 
 
 xmrig::FileLog::FileLog(const char *fileName)
 {
-    uv_fs_t req;
-    m_file = uv_fs_open(uv_default_loop(), &req, fileName, O_CREAT | O_APPEND | O_WRONLY, 0644, nullptr);
-    uv_fs_req_cleanup(&req);
+    m_file = fopen(fileName, "a");
 }
 
 
-void xmrig::FileLog::print(int, const char *line, size_t, size_t size, bool colors)
+xmrig::FileLog::~FileLog()
 {
-    if (m_file < 0 || colors) {
-        return;
+    if (m_file) {
+        fclose(m_file);
     }
+}
 
-#   ifdef _WIN32
-    uv_buf_t buf = uv_buf_init(strdup(line), static_cast<unsigned int>(size));
-#   else
-    uv_buf_t buf = uv_buf_init(strdup(line), size);
-#   endif
-
-    uv_fs_t *req = new uv_fs_t;
-    req->data = buf.base;
 
-    uv_fs_write(uv_default_loop(), req, m_file, &buf, 1, -1, FileLog::onWrite);
+// Called from the log writer thread only, lines are buffered by stdio and written once per batch.
+void xmrig::FileLog::flush()
+{
+    if (m_file) {
+        fflush(m_file);
+    }
 }
 
 
-void xmrig::FileLog::onWrite(uv_fs_t *req)
+void xmrig::FileLog::print(int, const char *line, size_t, size_t size, bool colors)
 {
-    delete [] static_cast<char *>(req->data);
+    if (!m_file || colors) {
+        return;
+    }
 
-    uv_fs_req_cleanup(req);
-    delete req;
+    fwrite(line, 1, size, m_file);
 }
@@ -27,10 +27,11 @@
 #define XMRIG_FILELOG_H
 
 
-typedef struct uv_fs_s uv_fs_t;
+#include <cstdio>
 
 
 #include "base/kernel/interfaces/ILogBackend.h"
+#include "base/tools/Object.h"
 
 
 namespace xmrig {
@@ -39,16 +40,17 @@ namespace xmrig {
 class FileLog : public ILogBackend
 {
 public:
-    FileLog(const char *fileName);
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(FileLog)
 
+    FileLog(const char *fileName);
+    ~FileLog() override;
 
 protected:
+    void flush() override;
     void print(int level, const char *line, size_t offset, size_t size, bool colors) override;
 
 private:
-    static void onWrite(uv_fs_t *req);
-
-    int m_file;
+    FILE *m_file;
 };
 
 
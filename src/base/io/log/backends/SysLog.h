@@ -40,6 +40,8 @@ public:
     ~SysLog() override;
 
 protected:
+    inline void flush() override {}
+
     void print(int level, const char *line, size_t offset, size_t size, bool colors) override;
 };
 
@@ -34,9 +34,11 @@
 #include "base/io/log/Log.h"
 #include "base/io/Watcher.h"
 #include "base/kernel/Base.h"
+#include "base/kernel/config/ConfigDiff.h"
 #include "base/kernel/interfaces/IBaseListener.h"
 #include "base/kernel/Platform.h"
 #include "base/kernel/Process.h"
+#include "base/net/dns/Dns.h"
 #include "core/config/Config.h"
 #include "core/config/ConfigTransform.h"
 
@@ -97,9 +99,21 @@ public:
 
     inline void replace(Config *newConfig)
     {
+        const ConfigDiff diff(*config, *newConfig);
+        if (diff.isEmpty()) {
+            LOG_INFO("configuration not changed");
+
+            delete newConfig;
+            return;
+        }
+
+        LOG_INFO("configuration changes: %s", String::join(diff.keys(), ',').data());
+
         Config *previousConfig = config;
         config = newConfig;
 
+        Dns::set(config->dns());
+
         for (IBaseListener *listener : listeners) {
             listener->onConfigChanged(config, previousConfig);
         }
@@ -175,6 +189,7 @@ int xmrig::Base::init()
 #   endif
 
     Platform::init(config()->userAgent());
+    Dns::set(config()->dns());
 
     if (isBackground()) {
         Log::background = true;
@@ -238,7 +253,7 @@ bool xmrig::Base::isBackground() const
 }
 
 
-bool xmrig::Base::reload(const rapidjson::Value &json)
+bool xmrig::Base::reload(const rapidjson::Value &json, bool save)
 {
     JsonReader reader(json);
     if (reader.isEmpty()) {
@@ -252,9 +267,7 @@ bool xmrig::Base::reload(const rapidjson::Value &json)
         return false;
     }
 
-    const bool saved = config->save();
-
-    if (config->isWatch() && d_ptr->watcher && saved) {
+    if (save && config->save() && config->isWatch() && d_ptr->watcher) {
         delete config;
 
         return true;
@@ -58,7 +58,7 @@ public:
 
     Api *api() const;
     bool isBackground() const;
-    bool reload(const rapidjson::Value &json);
+    bool reload(const rapidjson::Value &json, bool save = true);
     Config *config() const;
     void addListener(IBaseListener *listener);
 
@@ -0,0 +1,417 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <uv.h>
+#include <vector>
+
+
+#include "base/kernel/Cgroup.h"
+#include "base/tools/Object.h"
+#include "rapidjson/document.h"
+
+
+namespace xmrig {
+
+
+class CgroupPrivate
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(CgroupPrivate)
+
+    CgroupPrivate();
+
+    double quota            = 0.0;
+    int version             = 0;
+    std::string usagePath;
+    String cpuset;
+    uint32_t cpus           = 0;
+    uint64_t memory         = 0;
+
+#   ifdef __linux__
+private:
+    struct Mount
+    {
+        bool v2;
+        std::string options;
+        std::string point;
+        std::string root;
+    };
+
+    static bool read(const std::string &path, std::string &out);
+    static uint32_t count(const std::string &cpus);
+
+    std::string directory(const char *controller) const;
+    void readV1();
+    void readV2();
+    void walk(const char *controller, const char *file, void (*fn)(CgroupPrivate *, const std::string &)) const;
+
+    std::vector<Mount> m_mounts;
+    std::vector<std::pair<std::string, std::string> > m_groups;
+#   endif
+};
+
+
+static CgroupPrivate &d_ptr()
+{
+    static CgroupPrivate d;
+
+    return d;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::CgroupPrivate::CgroupPrivate()
+{
+#   ifdef __linux__
+    std::ifstream mountinfo("/proc/self/mountinfo");
+    std::string line;
+
+    // 36 35 98:0 /root /mnt rw,noatime master:1 - cgroup cgroup rw,cpu,cpuacct
+    while (std::getline(mountinfo, line)) {
+        std::istringstream stream(line);
+        std::vector<std::string> fields;
+        std::string field;
+
+        while (stream >> field) {
+            fields.push_back(field);
+        }
+
+        const auto separator = std::find(fields.begin(), fields.end(), "-");
+        if (fields.size() < 5 || std::distance(separator, fields.end()) < 4) {
+            continue;
+        }
+
+        const std::string &type = *(separator + 1);
+        if (type == "cgroup2" || type == "cgroup") {
+            m_mounts.push_back({ type == "cgroup2", *(separator + 3), fields[4], fields[3] });
+        }
+    }
+
+    // 4:cpu,cpuacct:/kubepods/pod1/abc or 0::/system.slice/xmrig.service
+    std::ifstream groups("/proc/self/cgroup");
+    while (std::getline(groups, line)) {
+        const size_t first  = line.find(':');
+        const size_t second = line.find(':', first + 1);
+
+        if (first != std::string::npos && second != std::string::npos) {
+            m_groups.emplace_back(line.substr(first + 1, second - first - 1), line.substr(second + 1));
+        }
+    }
+
+    if (!directory("memory").empty() || !directory("cpu").empty()) {
+        readV1();
+    }
+    else if (!directory(nullptr).empty()) {
+        readV2();
+    }
+
+    const uint32_t host = std::max(std::thread::hardware_concurrency(), 1U);
+
+    if (quota > 0.0 && quota < host) {
+        cpus = std::max(static_cast<uint32_t>(quota), 1U);
+    }
+
+    const uint32_t allowed = cpuset.isNull() ? 0 : count(cpuset.data());
+    if (allowed > 0 && allowed < host) {
+        cpus = cpus ? std::min(cpus, allowed) : allowed;
+    }
+
+    if (memory >= uv_get_total_memory()) {
+        memory = 0;
+    }
+
+    m_mounts.clear();
+    m_groups.clear();
+#   endif
+}
+
+
+#ifdef __linux__
+bool xmrig::CgroupPrivate::read(const std::string &path, std::string &out)
+{
+    std::ifstream file(path);
+
+    return file.is_open() && std::getline(file, out) && !out.empty();
+}
+
+
+uint32_t xmrig::CgroupPrivate::count(const std::string &cpus)
+{
+    uint32_t total = 0;
+    std::istringstream stream(cpus);
+    std::string range;
+
+    // 0-3,8,10-11
+    while (std::getline(stream, range, ',')) {
+        const size_t dash = range.find('-');
+        const long first  = strtol(range.c_str(), nullptr, 10);
+        const long last   = dash == std::string::npos ? first : strtol(range.c_str() + dash + 1, nullptr, 10);
+
+        if (last >= first) {
+            total += static_cast<uint32_t>(last - first + 1);
+        }
+    }
+
+    return total;
+}
+
+
+std::string xmrig::CgroupPrivate::directory(const char *controller) const
+{
+    for (const Mount &mount : m_mounts) {
+        if (mount.v2 != (controller == nullptr)) {
+            continue;
+        }
+
+        if (controller && ("," + mount.options + ",").find(std::string(",") + controller + ",") == std::string::npos) {
+            continue;
+        }
+
+        for (const auto &group : m_groups) {
+            const bool match = controller ? ("," + group.first + ",").find(std::string(",") + controller + ",") != std::string::npos
+                                          : group.first.empty();
+            if (!match) {
+                continue;
+            }
+
+            // Inside a cgroup namespace the path is relative to the mount root.
+            std::string path = group.second;
+            if (mount.root != "/" && path.compare(0, mount.root.size(), mount.root) == 0) {
+                path = path.substr(mount.root.size());
+            }
+            else if (mount.root != "/") {
+                path.clear();
+            }
+
+            return path.empty() || path == "/" ? mount.point : mount.point + path;
+        }
+    }
+
+    return std::string();
+}
+
+
+void xmrig::CgroupPrivate::readV1()
+{
+    version = 1;
+
+    // Limits of parent groups apply too, the smallest one wins.
+    walk("cpu", "cpu.cfs_quota_us", [](CgroupPrivate *d, const std::string &dir) {
+        std::string value;
+        std::string period;
+
+        if (read(dir + "/cpu.cfs_quota_us", value) && read(dir + "/cpu.cfs_period_us", period) && strtoll(value.c_str(), nullptr, 10) > 0) {
+            const double q = static_cast<double>(strtoll(value.c_str(), nullptr, 10)) / std::max(strtoll(period.c_str(), nullptr, 10), 1LL);
+            d->quota       = d->quota > 0.0 ? std::min(d->quota, q) : q;
+        }
+    });
+
+    walk("memory", "memory.limit_in_bytes", [](CgroupPrivate *d, const std::string &dir) {
+        std::string value;
+
+        if (read(dir + "/memory.limit_in_bytes", value)) {
+            const uint64_t limit = strtoull(value.c_str(), nullptr, 10);
+            d->memory            = d->memory ? std::min(d->memory, limit) : limit;
+        }
+    });
+
+    const std::string cpusetDir = directory("cpuset");
+    std::string value;
+
+    if (!cpusetDir.empty() && (read(cpusetDir + "/cpuset.effective_cpus", value) || read(cpusetDir + "/cpuset.cpus", value))) {
+        cpuset = value.c_str();
+    }
+
+    const std::string memoryDir = directory("memory");
+    if (!memoryDir.empty()) {
+        usagePath = memoryDir + "/memory.usage_in_bytes";
+    }
+}
+
+
+void xmrig::CgroupPrivate::readV2()
+{
+    version = 2;
+
+    walk(nullptr, "cpu.max", [](CgroupPrivate *d, const std::string &dir) {
+        std::string value;
+
+        // "max 100000" or "150000 100000"
+        if (read(dir + "/cpu.max", value) && value.compare(0, 3, "max") != 0) {
+            char *end = nullptr;
+            const double limit  = strtod(value.c_str(), &end);
+            const double period = strtod(end, nullptr);
+
+            if (limit > 0.0 && period > 0.0) {
+                d->quota = d->quota > 0.0 ? std::min(d->quota, limit / period) : limit / period;
+            }
+        }
+    });
+
+    walk(nullptr, "memory.max", [](CgroupPrivate *d, const std::string &dir) {
+        std::string value;
+
+        if (read(dir + "/memory.max", value) && value != "max") {
+            const uint64_t limit = strtoull(value.c_str(), nullptr, 10);
+            d->memory            = d->memory ? std::min(d->memory, limit) : limit;
+        }
+    });
+
+    const std::string dir = directory(nullptr);
+    std::string value;
+
+    if (read(dir + "/cpuset.cpus.effective", value)) {
+        cpuset = value.c_str();
+    }
+
+    usagePath = dir + "/memory.current";
+}
+
+
+void xmrig::CgroupPrivate::walk(const char *controller, const char *file, void (*fn)(CgroupPrivate *, const std::string &)) const
+{
+    std::string dir = directory(controller);
+    std::string top;
+
+    for (const Mount &mount : m_mounts) {
+        if (dir.compare(0, mount.point.size(), mount.point) == 0 && mount.point.size() > top.size()) {
+            top = mount.point;
+        }
+    }
+
+    while (!dir.empty()) {
+        std::ifstream probe(dir + "/" + file);
+        if (probe.is_open()) {
+            fn(const_cast<CgroupPrivate *>(this), dir);
+        }
+
+        if (dir.size() <= top.size()) {
+            break;
+        }
+
+        dir = dir.substr(0, dir.rfind('/'));
+    }
+}
+#endif
+
+
+bool xmrig::Cgroup::isLimited()
+{
+    return cpus() > 0 || memoryLimit() > 0;
+}
+
+
+const xmrig::String &xmrig::Cgroup::cpuset()
+{
+    return d_ptr().cpuset;
+}
+
+
+double xmrig::Cgroup::cpuQuota()
+{
+    return d_ptr().quota;
+}
+
+
+int xmrig::Cgroup::version()
+{
+    return d_ptr().version;
+}
+
+
+/**
+ * Number of CPUs the process can keep busy without being throttled, 0 if not limited by the control group.
+ */
+uint32_t xmrig::Cgroup::cpus()
+{
+    return d_ptr().cpus;
+}
+
+
+/**
+ * Memory the process can still allocate, the control group limit minus current usage or free host memory.
+ */
+uint64_t xmrig::Cgroup::freeMemory()
+{
+    const uint64_t limit = memoryLimit();
+    if (!limit) {
+        return uv_get_free_memory();
+    }
+
+    const uint64_t usage = memoryUsage();
+
+    return usage < limit ? limit - usage : 0;
+}
+
+
+uint64_t xmrig::Cgroup::memoryLimit()
+{
+    return d_ptr().memory;
+}
+
+
+uint64_t xmrig::Cgroup::memoryUsage()
+{
+#   ifdef __linux__
+    std::ifstream file(d_ptr().usagePath);
+    uint64_t usage = 0;
+
+    if (file >> usage) {
+        return usage;
+    }
+#   endif
+
+    return 0;
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::Cgroup::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+
+    out.AddMember("cgroup",       version() ? Value(version()) : Value(kNullType), allocator);
+    out.AddMember("cpu_quota",    cpuQuota() > 0.0 ? Value(cpuQuota()) : Value(kNullType), allocator);
+    out.AddMember("cpuset",       cpuset().toJSON(doc), allocator);
+    out.AddMember("cpus",         cpus() ? cpus() : std::max(std::thread::hardware_concurrency(), 1U), allocator);
+    out.AddMember("memory",       memoryLimit() ? Value(memoryLimit()) : Value(kNullType), allocator);
+    out.AddMember("memory_usage", memoryLimit() ? Value(memoryUsage()) : Value(kNullType), allocator);
+
+    return out;
+}
+#endif
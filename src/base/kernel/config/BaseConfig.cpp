@@ -139,6 +139,7 @@ bool xmrig::BaseConfig::read(const IJsonReader &reader, const char *fileName)
         m_apiWorkerId = Json::getString(api, "worker-id");
     }
 
+    m_dns = DnsConfig(reader.getObject(DnsConfig::kField));
     m_http.load(reader.getObject("http"));
     m_pools.load(reader);
 
@@ -27,6 +27,7 @@
 
 
 #include "base/kernel/interfaces/IConfig.h"
+#include "base/net/dns/DnsConfig.h"
 #include "base/net/http/Http.h"
 #include "base/net/stratum/Pools.h"
 
@@ -48,6 +49,7 @@ public:
     inline bool isSyslog() const                   { return m_syslog; }
     inline const char *logFile() const             { return m_logFile.data(); }
     inline const char *userAgent() const           { return m_userAgent.data(); }
+    inline const DnsConfig &dns() const            { return m_dns; }
     inline const Http &http() const                { return m_http; }
     inline const Pools &pools() const              { return m_pools; }
     inline const String &apiId() const             { return m_apiId; }
@@ -70,6 +72,7 @@ protected:
     bool m_syslog      = false;
     bool m_upgrade     = false;
     bool m_watch       = true;
+    DnsConfig m_dns;
     Http m_http;
     Pools m_pools;
     String m_apiId;
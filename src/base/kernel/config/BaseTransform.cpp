@@ -208,10 +208,13 @@ void xmrig::BaseTransform::transform(rapidjson::Document &doc, int key, const ch
 
     case IConfig::RetriesKey:     /* --retries */
     case IConfig::RetryPauseKey:  /* --retry-pause */
+    case IConfig::StandbyPoolsKey: /* --standby-pools */
+    case IConfig::PoolWeightKey:  /* --pool-weight */
     case IConfig::PrintTimeKey:   /* --print-time */
     case IConfig::HttpPort:       /* --http-port */
     case IConfig::DonateLevelKey: /* --donate-level */
     case IConfig::DaemonPollKey:  /* --daemon-poll-interval */
+    case IConfig::DaemonZMQPortKey: /* --daemon-zmq-port */
         return transformUint64(doc, key, static_cast<uint64_t>(strtol(arg, nullptr, 10)));
 
     case IConfig::BackgroundKey:  /* --background */
@@ -288,6 +291,9 @@ void xmrig::BaseTransform::transformUint64(rapidjson::Document &doc, int key, ui
     case IConfig::RetryPauseKey: /* --retry-pause */
         return set(doc, "retry-pause", arg);
 
+    case IConfig::StandbyPoolsKey: /* --standby-pools */
+        return set(doc, "standby-pools", arg);
+
     case IConfig::DonateLevelKey: /* --donate-level */
         return set(doc, "donate-level", arg);
 
@@ -301,9 +307,15 @@ void xmrig::BaseTransform::transformUint64(rapidjson::Document &doc, int key, ui
     case IConfig::PrintTimeKey: /* --print-time */
         return set(doc, "print-time", arg);
 
+    case IConfig::PoolWeightKey: /* --pool-weight */
+        return add(doc, kPools, "weight", arg);
+
 #   ifdef XMRIG_FEATURE_HTTP
     case IConfig::DaemonPollKey:  /* --daemon-poll-interval */
         return add(doc, kPools, "daemon-poll-interval", arg);
+
+    case IConfig::DaemonZMQPortKey: /* --daemon-zmq-port */
+        return add(doc, kPools, "daemon-zmq-port", arg);
 #   endif
 
     default:
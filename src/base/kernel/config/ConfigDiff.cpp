@@ -0,0 +1,58 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "base/kernel/config/ConfigDiff.h"
+#include "base/kernel/interfaces/IConfig.h"
+#include "rapidjson/document.h"
+
+
+/**
+ * Compares top level sections of two configurations in their serialized form,
+ * the names of added, removed or modified sections are collected in keys().
+ */
+xmrig::ConfigDiff::ConfigDiff(const IConfig &previous, const IConfig &config)
+{
+    using namespace rapidjson;
+
+    Document a(kObjectType);
+    Document b(kObjectType);
+
+    previous.getJSON(a);
+    config.getJSON(b);
+
+    for (const auto &member : b.GetObject()) {
+        const auto it = a.FindMember(member.name);
+        if (it == a.MemberEnd() || it->value != member.value) {
+            m_keys.emplace_back(member.name.GetString());
+        }
+    }
+
+    for (const auto &member : a.GetObject()) {
+        if (!b.HasMember(member.name)) {
+            m_keys.emplace_back(member.name.GetString());
+        }
+    }
+}
@@ -60,6 +60,8 @@ public:
         PasswordKey          = 'p',
         RetriesKey           = 'r',
         RetryPauseKey        = 'R',
+        StandbyPoolsKey      = 1034,
+        PoolWeightKey        = 1035,
         RigIdKey             = 1012,
         SyslogKey            = 'S',
         UrlKey               = 'o',
@@ -72,6 +74,7 @@ public:
         ProxyDonateKey       = 1017,
         DaemonKey            = 1018,
         DaemonPollKey        = 1019,
+        DaemonZMQPortKey     = 1033,
         SelfSelectKey        = 1028,
 
         // xmrig common
@@ -93,6 +96,16 @@ public:
         CPUMaxThreadsKey     = 1026,
         MemoryPoolKey        = 1027,
         YieldKey             = 1030,
+        StrictWXKey          = 1031,
+        PerfCountersKey      = 1032,
+        RebalanceKey         = 1036,
+        MaxTempKey           = 1037,
+        MaxPowerKey          = 1038,
+        VerifyIntervalKey    = 1043,
+        BenchKey             = 1039,
+        BenchAlgoKey         = 1040,
+        BenchTimeKey         = 1041,
+        BenchOutputKey       = 1042,
 
         // xmrig amd
         OclPlatformKey       = 1400,
@@ -39,6 +39,7 @@ class ILogBackend
 public:
     virtual ~ILogBackend() = default;
 
+    virtual void flush()                                                                    = 0;
     virtual void print(int level, const char *line, size_t offset, size_t size, bool colors) = 0;
 };
 
@@ -23,31 +23,64 @@
  */
 
 
+#include <algorithm>
+#include <map>
+#include <string>
+
+
 #include "base/kernel/interfaces/IDnsListener.h"
 #include "base/net/dns/Dns.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Handle.h"
 
 
 namespace xmrig {
-    Storage<Dns> Dns::m_storage;
-    static const DnsRecord defaultRecord;
+
+
+/**
+ * Shared resolver state for a single host name. Records stay available after TTL expiration and are used if
+ * the following lookup fails, concurrent lookups of the same host share one getaddrinfo request.
+ */
+class DnsEntry
+{
+public:
+    int status                  = 0;
+    std::vector<DnsRecord> ipv4;
+    std::vector<DnsRecord> ipv6;
+    std::vector<uintptr_t> waiters;
+    uint64_t timestamp          = 0;
+    uv_getaddrinfo_t *req       = nullptr;
+};
+
+
+DnsConfig Dns::m_config;
+Storage<Dns> Dns::m_storage;
+static const DnsRecord defaultRecord;
+static std::map<std::string, DnsEntry> cache;
+static std::vector<uintptr_t> notifications;
+static uv_timer_t *notifyTimer = nullptr;
+
+
+static inline bool isFresh(const DnsEntry &entry, uint64_t now)
+{
+    return entry.timestamp && (now - entry.timestamp) < Dns::config().ttl();
+}
+
+
+static inline void remove(std::vector<uintptr_t> &keys, uintptr_t key)
+{
+    keys.erase(std::remove(keys.begin(), keys.end(), key), keys.end());
 }
 
 
+} // namespace xmrig
+
+
 xmrig::Dns::Dns(IDnsListener *listener) :
-    m_hints(),
     m_listener(listener),
-    m_status(0),
-    m_resolver(nullptr)
+    m_status(0)
 {
     m_key = m_storage.add(this);
-
-    m_resolver = new uv_getaddrinfo_t;
-    m_resolver->data = m_storage.ptr(m_key);
-
-    m_hints.ai_family   = AF_UNSPEC;
-    m_hints.ai_socktype = SOCK_STREAM;
-    m_hints.ai_protocol = IPPROTO_TCP;
 }
 
 
@@ -55,21 +88,63 @@ xmrig::Dns::~Dns()
 {
     m_storage.release(m_key);
 
-    delete m_resolver;
+    remove(notifications, m_key);
+
+    if (!m_host.isNull()) {
+        auto it = cache.find(m_host.data());
+        if (it != cache.end()) {
+            remove(it->second.waiters, m_key);
+        }
+    }
 }
 
 
 bool xmrig::Dns::resolve(const String &host)
 {
     if (m_host != host) {
+        if (!m_host.isNull()) {
+            remove(cache[m_host.data()].waiters, m_key);
+        }
+
         m_host = host;
 
         clear();
     }
 
-    m_status = uv_getaddrinfo(uv_default_loop(), m_resolver, Dns::onResolved, m_host.data(), nullptr, &m_hints);
+    DnsEntry &entry    = cache[m_host.data()];
+    const uint64_t now = Chrono::steadyMSecs();
 
-    return m_status == 0;
+    // Cached records are delivered asynchronously as usual, the entry is refreshed in background when 3/4 of TTL passed.
+    if (isFresh(entry, now)) {
+        if ((now - entry.timestamp) > m_config.ttl() / 4 * 3) {
+            query(entry, m_host.data());
+        }
+
+        if (std::find(notifications.begin(), notifications.end(), m_key) == notifications.end()) {
+            notifications.push_back(m_key);
+        }
+
+        if (!notifyTimer) {
+            notifyTimer = new uv_timer_t;
+            uv_timer_init(uv_default_loop(), notifyTimer);
+            uv_timer_start(notifyTimer, Dns::onNotify, 0, 0);
+        }
+
+        m_status = 0;
+
+        return true;
+    }
+
+    m_status = query(entry, m_host.data());
+    if (m_status < 0) {
+        return false;
+    }
+
+    if (std::find(entry.waiters.begin(), entry.waiters.end(), m_key) == entry.waiters.end()) {
+        entry.waiters.push_back(m_key);
+    }
+
+    return true;
 }
 
 
@@ -85,6 +160,10 @@ const xmrig::DnsRecord &xmrig::Dns::get(DnsRecord::Type prefered) const
         return defaultRecord;
     }
 
+    if (prefered == DnsRecord::Unknown) {
+        prefered = m_config.isIPv6() ? DnsRecord::AAAA : DnsRecord::A;
+    }
+
     const size_t ipv4 = m_ipv4.size();
     const size_t ipv6 = m_ipv6.size();
 
@@ -114,6 +193,48 @@ size_t xmrig::Dns::count(DnsRecord::Type type) const
 }
 
 
+/**
+ * All records in connection attempt order (RFC 8305 section 4): address families are interleaved starting with
+ * the preferred one, the starting record of each family is random to spread load.
+ */
+std::vector<xmrig::DnsRecord> xmrig::Dns::records() const
+{
+    const std::vector<DnsRecord> &first  = m_config.isIPv6() ? m_ipv6 : m_ipv4;
+    const std::vector<DnsRecord> &second = m_config.isIPv6() ? m_ipv4 : m_ipv6;
+    const size_t offset1                 = first.size() > 1 ? static_cast<size_t>(rand()) % first.size() : 0;
+    const size_t offset2                 = second.size() > 1 ? static_cast<size_t>(rand()) % second.size() : 0;
+
+    std::vector<DnsRecord> out;
+    out.reserve(count());
+
+    for (size_t i = 0; i < std::max(first.size(), second.size()); ++i) {
+        if (i < first.size()) {
+            out.push_back(first[(i + offset1) % first.size()]);
+        }
+
+        if (i < second.size()) {
+            out.push_back(second[(i + offset2) % second.size()]);
+        }
+    }
+
+    return out;
+}
+
+
+void xmrig::Dns::prefetch(const String &host)
+{
+    if (host.isNull()) {
+        return;
+    }
+
+    DnsEntry &entry = cache[host.data()];
+
+    if (!isFresh(entry, Chrono::steadyMSecs())) {
+        query(entry, host.data());
+    }
+}
+
+
 void xmrig::Dns::clear()
 {
     m_ipv4.clear();
@@ -121,43 +242,98 @@ void xmrig::Dns::clear()
 }
 
 
-void xmrig::Dns::onResolved(int status, addrinfo *res)
+void xmrig::Dns::onResolved(const DnsEntry &entry)
 {
-    m_status = status;
+    m_ipv4 = entry.ipv4;
+    m_ipv6 = entry.ipv6;
 
-    if (m_status < 0) {
-        return m_listener->onResolved(*this, status);
-    }
-
-    clear();
+    // Stale records are still better than nothing if the resolver is unavailable.
+    m_status = isEmpty() ? entry.status : 0;
 
-    addrinfo *ptr = res;
-    while (ptr != nullptr) {
-        if (ptr->ai_family == AF_INET) {
-            m_ipv4.push_back(ptr);
-        }
+    m_listener->onResolved(*this, m_status);
+}
 
-        if (ptr->ai_family == AF_INET6) {
-            m_ipv6.push_back(ptr);
-        }
 
-        ptr = ptr->ai_next;
+int xmrig::Dns::query(DnsEntry &entry, const char *host)
+{
+    if (entry.req) {
+        return 0;
     }
 
-    if (isEmpty()) {
-        m_status = UV_EAI_NONAME;
+    addrinfo hints{};
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+
+    entry.req       = new uv_getaddrinfo_t;
+    entry.req->data = &entry;
+
+    const int rc = uv_getaddrinfo(uv_default_loop(), entry.req, Dns::onResolved, host, nullptr, &hints);
+    if (rc < 0) {
+        delete entry.req;
+        entry.req = nullptr;
     }
 
-    m_listener->onResolved(*this, m_status);
+    return rc;
+}
+
+
+void xmrig::Dns::onNotify(uv_timer_t *)
+{
+    Handle::close(notifyTimer);
+    notifyTimer = nullptr;
+
+    const std::vector<uintptr_t> keys = std::move(notifications);
+    notifications.clear();
+
+    for (uintptr_t key : keys) {
+        Dns *dns = m_storage.get(key);
+        if (dns) {
+            dns->onResolved(cache[dns->m_host.data()]);
+        }
+    }
 }
 
 
 void xmrig::Dns::onResolved(uv_getaddrinfo_t *req, int status, addrinfo *res)
 {
-    Dns *dns = m_storage.get(req->data);
-    if (dns) {
-        dns->onResolved(status, res);
+    auto entry = static_cast<DnsEntry *>(req->data);
+    entry->req = nullptr;
+
+    delete req;
+
+    std::vector<DnsRecord> ipv4;
+    std::vector<DnsRecord> ipv6;
+
+    for (addrinfo *ptr = status == 0 ? res : nullptr; ptr != nullptr; ptr = ptr->ai_next) {
+        if (ptr->ai_family == AF_INET) {
+            ipv4.emplace_back(ptr);
+        }
+
+        if (ptr->ai_family == AF_INET6) {
+            ipv6.emplace_back(ptr);
+        }
     }
 
     uv_freeaddrinfo(res);
+
+    if (!ipv4.empty() || !ipv6.empty()) {
+        entry->status    = 0;
+        entry->ipv4      = std::move(ipv4);
+        entry->ipv6      = std::move(ipv6);
+        entry->timestamp = Chrono::steadyMSecs();
+    }
+    else {
+        entry->status = status < 0 ? status : UV_EAI_NONAME;
+    }
+
+    const std::vector<uintptr_t> keys = std::move(entry->waiters);
+    entry->waiters.clear();
+
+    for (uintptr_t key : keys) {
+        Dns *dns = m_storage.get(key);
+        if (dns) {
+            dns->onResolved(*entry);
+        }
+    }
 }
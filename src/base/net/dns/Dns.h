@@ -30,6 +30,7 @@
 #include <uv.h>
 
 
+#include "base/net/dns/DnsConfig.h"
 #include "base/net/dns/DnsRecord.h"
 #include "base/net/tools/Storage.h"
 #include "base/tools/String.h"
@@ -38,6 +39,7 @@
 namespace xmrig {
 
 
+class DnsEntry;
 class IDnsListener;
 
 
@@ -47,30 +49,37 @@ public:
     Dns(IDnsListener *listener);
     ~Dns();
 
-    inline bool isEmpty() const       { return m_ipv4.empty() && m_ipv6.empty(); }
-    inline const String &host() const { return m_host; }
-    inline int status() const         { return m_status; }
+    inline bool isEmpty() const                     { return m_ipv4.empty() && m_ipv6.empty(); }
+    inline const String &host() const               { return m_host; }
+    inline int status() const                       { return m_status; }
+
+    static inline const DnsConfig &config()         { return m_config; }
+    static inline void set(const DnsConfig &config) { m_config = config; }
 
     bool resolve(const String &host);
     const char *error() const;
-    const DnsRecord &get(DnsRecord::Type prefered = DnsRecord::A) const;
+    const DnsRecord &get(DnsRecord::Type prefered = DnsRecord::Unknown) const;
     size_t count(DnsRecord::Type type = DnsRecord::Unknown) const;
+    std::vector<DnsRecord> records() const;
+
+    static void prefetch(const String &host);
 
 private:
     void clear();
-    void onResolved(int status, addrinfo *res);
+    void onResolved(const DnsEntry &entry);
 
+    static int query(DnsEntry &entry, const char *host);
+    static void onNotify(uv_timer_t *handle);
     static void onResolved(uv_getaddrinfo_t *req, int status, addrinfo *res);
 
-    addrinfo m_hints;
     IDnsListener *m_listener;
     int m_status;
     std::vector<DnsRecord> m_ipv4;
     std::vector<DnsRecord> m_ipv6;
     String m_host;
     uintptr_t m_key;
-    uv_getaddrinfo_t *m_resolver;
 
+    static DnsConfig m_config;
     static Storage<Dns> m_storage;
 };
 
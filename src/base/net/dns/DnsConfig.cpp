@@ -0,0 +1,75 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "base/net/dns/DnsConfig.h"
+#include "base/io/json/Json.h"
+#include "rapidjson/document.h"
+
+
+namespace xmrig {
+
+
+const char *DnsConfig::kField   = "dns";
+static const char *kIPv6        = "ipv6";
+static const char *kTTL         = "ttl";
+
+
+} // namespace xmrig
+
+
+xmrig::DnsConfig::DnsConfig(const rapidjson::Value &value)
+{
+    if (!value.IsObject()) {
+        return;
+    }
+
+    m_ipv6 = Json::getBool(value, kIPv6, m_ipv6);
+
+    const uint32_t ttl = Json::getUint(value, kTTL, m_ttl);
+    if (ttl > 0 && ttl <= 86400) {
+        m_ttl = ttl;
+    }
+}
+
+
+bool xmrig::DnsConfig::isEqual(const DnsConfig &other) const
+{
+    return m_ipv6 == other.m_ipv6 && m_ttl == other.m_ttl;
+}
+
+
+rapidjson::Value xmrig::DnsConfig::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value obj(kObjectType);
+
+    obj.AddMember(StringRef(kIPv6), m_ipv6, allocator);
+    obj.AddMember(StringRef(kTTL),  m_ttl, allocator);
+
+    return obj;
+}
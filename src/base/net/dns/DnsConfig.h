@@ -0,0 +1,67 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_DNSCONFIG_H
+#define XMRIG_DNSCONFIG_H
+
+
+#include "rapidjson/fwd.h"
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class DnsConfig
+{
+public:
+    static const char *kField;
+
+    constexpr static uint32_t kDefaultTTL = 30;
+
+    DnsConfig() = default;
+    DnsConfig(const rapidjson::Value &value);
+
+    inline bool isIPv6() const                              { return m_ipv6; }
+    inline uint32_t ttl() const                             { return m_ttl * 1000U; }
+
+    inline bool operator!=(const DnsConfig &other) const    { return !isEqual(other); }
+    inline bool operator==(const DnsConfig &other) const    { return isEqual(other); }
+
+    bool isEqual(const DnsConfig &other) const;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+
+private:
+    bool m_ipv6     = false;
+    uint32_t m_ttl  = kDefaultTTL;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_DNSCONFIG_H */
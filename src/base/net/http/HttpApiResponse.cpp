@@ -25,16 +25,131 @@
 
 
 #include "3rdparty/http-parser/http_parser.h"
+#include "base/io/json/CborWriter.h"
 #include "base/net/http/HttpApiResponse.h"
+#include "base/net/http/HttpContext.h"
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/stringbuffer.h"
 
 
+#include <cstdlib>
+#include <cstring>
+
+
+#ifdef XMRIG_FEATURE_ZLIB
+#   include <vector>
+#   include <zlib.h>
+#endif
+
+
+#ifdef _MSC_VER
+#   define strncasecmp _strnicmp
+#endif
+
+
 namespace xmrig {
 
 static const char *kError  = "error";
 static const char *kStatus = "status";
 
+static constexpr size_t kMinCompressSize = 512;
+
+
+static inline bool isSpace(char c) { return c == ' ' || c == '\t'; }
+
+
+/**
+ * Checks if a comma separated header like Accept or Accept-Encoding lists the token with a non-zero quality,
+ * "gzip;q=0" means the client refuses gzip.
+ */
+static bool hasToken(const HttpContext *ctx, const char *header, const char *token)
+{
+    if (!ctx || !ctx->headers.count(header)) {
+        return false;
+    }
+
+    const std::string &value = ctx->headers.at(header);
+    const size_t tokenSize   = strlen(token);
+    size_t pos               = 0;
+
+    while (pos < value.size()) {
+        size_t end = value.find(',', pos);
+        if (end == std::string::npos) {
+            end = value.size();
+        }
+
+        size_t first = pos;
+        while (first < end && isSpace(value[first])) {
+            ++first;
+        }
+
+        size_t last = first;
+        while (last < end && value[last] != ';' && !isSpace(value[last])) {
+            ++last;
+        }
+
+        if (last - first == tokenSize && strncasecmp(value.c_str() + first, token, tokenSize) == 0) {
+            double quality = 1.0;
+
+            for (size_t param = value.find(';', last); param < end; param = value.find(';', param + 1)) {
+                size_t name = param + 1;
+                while (name < end && isSpace(value[name])) {
+                    ++name;
+                }
+
+                if (name + 1 < end && (value[name] == 'q' || value[name] == 'Q') && value[name + 1] == '=') {
+                    quality = strtod(value.c_str() + name + 2, nullptr);
+                }
+            }
+
+            return quality > 0.0;
+        }
+
+        pos = end + 1;
+    }
+
+    return false;
+}
+
+
+#ifdef XMRIG_FEATURE_ZLIB
+static bool compress(const char *data, size_t size, HttpApiResponse::Encoding encoding, std::pair<const char *, size_t> &out)
+{
+    static z_stream streams[2];
+    static bool ready[2] = { false, false };
+    static std::vector<char> buffer;
+
+    const size_t index = encoding == HttpApiResponse::GZIP ? 0 : 1;
+    z_stream &zs       = streams[index];
+
+    if (!ready[index]) {
+        if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, index == 0 ? (MAX_WBITS + 16) : MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+
+        ready[index] = true;
+    }
+    else if (deflateReset(&zs) != Z_OK) {
+        return false;
+    }
+
+    buffer.resize(deflateBound(&zs, static_cast<uLong>(size)));
+
+    zs.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    zs.avail_in  = static_cast<uInt>(size);
+    zs.next_out  = reinterpret_cast<Bytef *>(buffer.data());
+    zs.avail_out = static_cast<uInt>(buffer.size());
+
+    if (deflate(&zs, Z_FINISH) != Z_STREAM_END) {
+        return false;
+    }
+
+    out = { buffer.data(), zs.total_out };
+
+    return true;
+}
+#endif
+
 } // namespace xmrig
 
 
@@ -53,10 +168,52 @@ xmrig::HttpApiResponse::HttpApiResponse(uint64_t id, int status) :
 }
 
 
+std::pair<const char *, size_t> xmrig::HttpApiResponse::encode(const rapidjson::Value &value, Format format, Encoding &encoding)
+{
+    using namespace rapidjson;
+
+    // HTTP server runs on the main loop only, so output buffers are shared by all responses and never shrink.
+    static StringBuffer buffer(nullptr, 16 * 1024);
+    buffer.Clear();
+
+    if (format == CBOR) {
+        CborWriter writer(buffer);
+        value.Accept(writer);
+    }
+    else if (format == PRETTY_JSON) {
+        PrettyWriter<StringBuffer> writer(buffer);
+        writer.SetMaxDecimalPlaces(10);
+        writer.SetFormatOptions(kFormatSingleLineArray);
+        value.Accept(writer);
+    }
+    else {
+        Writer<StringBuffer> writer(buffer);
+        writer.SetMaxDecimalPlaces(10);
+        value.Accept(writer);
+    }
+
+    std::pair<const char *, size_t> out(buffer.GetString(), buffer.GetSize());
+
+#   ifdef XMRIG_FEATURE_ZLIB
+    if (encoding != IDENTITY && out.second >= kMinCompressSize && compress(out.first, out.second, encoding, out)) {
+        return out;
+    }
+#   endif
+
+    encoding = IDENTITY;
+
+    return out;
+}
+
+
 void xmrig::HttpApiResponse::end()
 {
     using namespace rapidjson;
 
+    if (!isAlive()) {
+        return;
+    }
+
     setHeader("Access-Control-Allow-Origin", "*");
     setHeader("Access-Control-Allow-Methods", "GET, PUT, POST, DELETE");
     setHeader("Access-Control-Allow-Headers", "Authorization, Content-Type");
@@ -75,14 +232,32 @@ void xmrig::HttpApiResponse::end()
         return HttpResponse::end();
     }
 
-    setHeader("Content-Type", "application/json");
+    const HttpContext *ctx = HttpContext::get(id());
+    Format format          = JSON;
+    Encoding encoding      = IDENTITY;
 
-    StringBuffer buffer(nullptr, 4096);
-    PrettyWriter<StringBuffer> writer(buffer);
-    writer.SetMaxDecimalPlaces(10);
-    writer.SetFormatOptions(kFormatSingleLineArray);
+    if (hasToken(ctx, "accept", "application/cbor")) {
+        format = CBOR;
+    }
+    else if (hasToken(ctx, "accept", "text/html")) {
+        format = PRETTY_JSON;
+    }
+
+    if (hasToken(ctx, "accept-encoding", "gzip")) {
+        encoding = GZIP;
+    }
+    else if (hasToken(ctx, "accept-encoding", "deflate")) {
+        encoding = DEFLATE;
+    }
+
+    const auto body = encode(m_doc, format, encoding);
 
-    m_doc.Accept(writer);
+    setHeader("Content-Type", format == CBOR ? "application/cbor" : "application/json");
+    setHeader("Vary", "Accept, Accept-Encoding");
+
+    if (encoding != IDENTITY) {
+        setHeader("Content-Encoding", encoding == GZIP ? "gzip" : "deflate");
+    }
 
-    HttpResponse::end(buffer.GetString(), buffer.GetSize());
+    HttpResponse::end(body.first, body.second);
 }
@@ -28,6 +28,9 @@
 #define XMRIG_HTTPAPIRESPONSE_H
 
 
+#include <utility>
+
+
 #include "base/net/http/HttpResponse.h"
 #include "rapidjson/document.h"
 
@@ -38,11 +41,25 @@ namespace xmrig {
 class HttpApiResponse : public HttpResponse
 {
 public:
+    enum Format {
+        JSON,
+        PRETTY_JSON,
+        CBOR
+    };
+
+    enum Encoding {
+        IDENTITY,
+        GZIP,
+        DEFLATE
+    };
+
     HttpApiResponse(uint64_t id);
     HttpApiResponse(uint64_t id, int status);
 
     inline rapidjson::Document &doc() { return m_doc; }
 
+    static std::pair<const char *, size_t> encode(const rapidjson::Value &value, Format format, Encoding &encoding);
+
     void end();
 
 private:
@@ -43,34 +43,21 @@ static const char *kCRLF = "\r\n";
 class ClientWriteBaton : public Baton<uv_write_t>
 {
 public:
-    inline ClientWriteBaton(const std::string &header, std::string &&body) :
-        m_body(std::move(body)),
-        m_header(header)
+    inline ClientWriteBaton(std::string &&data) :
+        m_data(std::move(data))
     {
-        bufs[0].len  = m_header.size();
-        bufs[0].base = const_cast<char *>(m_header.c_str());
-
-        if (!m_body.empty()) {
-            bufs[1].len  = m_body.size();
-            bufs[1].base = const_cast<char *>(m_body.c_str());
-        }
-        else {
-            bufs[1].base = nullptr;
-            bufs[1].len  = 0;
-        }
+        buf.len  = m_data.size();
+        buf.base = const_cast<char *>(m_data.c_str());
     }
 
 
-    inline size_t count() const                      { return bufs[1].base == nullptr ? 1 : 2; }
-    inline size_t size() const                       { return bufs[0].len + bufs[1].len; }
     inline static void onWrite(uv_write_t *req, int) { delete reinterpret_cast<ClientWriteBaton *>(req->data); }
 
 
-    uv_buf_t bufs[2]{};
+    uv_buf_t buf{};
 
 private:
-    std::string m_body;
-    std::string m_header;
+    std::string m_data;
 };
 
 
@@ -111,6 +98,19 @@ const xmrig::String &xmrig::HttpClient::host() const
 }
 
 
+void xmrig::HttpClient::send(int method, const String &url, const char *data, size_t size)
+{
+    std::string out = request(method, url.data(), data ? (size ? std::string(data, size) : std::string(data)) : std::string());
+
+    if (m_ready) {
+        write(std::move(out));
+    }
+    else {
+        m_pending.emplace_back(std::move(out));
+    }
+}
+
+
 void xmrig::HttpClient::onResolved(const Dns &dns, int status)
 {
     this->status = status;
@@ -120,7 +120,7 @@ void xmrig::HttpClient::onResolved(const Dns &dns, int status)
             LOG_ERR("[%s:%d] DNS error: \"%s\"", dns.host().data(), m_port, uv_strerror(status));
         }
 
-        return;
+        return close(status);
     }
 
     sockaddr *addr = dns.get().addr(m_port);
@@ -134,26 +134,16 @@ void xmrig::HttpClient::onResolved(const Dns &dns, int status)
 
 void xmrig::HttpClient::handshake()
 {
-    headers.insert({ "Host",       m_dns->host().data() });
-    headers.insert({ "Connection", "close" });
-    headers.insert({ "User-Agent", Platform::userAgent() });
-
-    if (!body.empty()) {
-        headers.insert({ "Content-Length", std::to_string(body.size()) });
-    }
+    m_ready = true;
 
-    std::stringstream ss;
-    ss << http_method_str(static_cast<http_method>(method)) << " " << url << " HTTP/1.1" << kCRLF;
+    write(request(method, url, std::move(body)));
+    body.clear();
 
-    for (auto &header : headers) {
-        ss << header.first << ": " << header.second << kCRLF;
+    for (auto &data : m_pending) {
+        write(std::move(data));
     }
 
-    ss << kCRLF;
-
-    headers.clear();
-
-    write(ss.str());
+    m_pending.clear();
 }
 
 
@@ -165,10 +155,34 @@ void xmrig::HttpClient::read(const char *data, size_t size)
 }
 
 
-void xmrig::HttpClient::write(const std::string &header)
+void xmrig::HttpClient::write(std::string &&data)
+{
+    auto baton = new ClientWriteBaton(std::move(data));
+    uv_write(&baton->req, stream(), &baton->buf, 1, ClientWriteBaton::onWrite);
+}
+
+
+std::string xmrig::HttpClient::request(int method, const std::string &url, std::string &&body)
 {
-    auto baton = new ClientWriteBaton(header, std::move(body));
-    uv_write(&baton->req, stream(), baton->bufs, baton->count(), ClientWriteBaton::onWrite);
+    std::map<std::string, std::string> fields;
+    fields.insert({ "Host",       m_dns->host().data() });
+    fields.insert({ "Connection", m_keepAlive ? "keep-alive" : "close" });
+    fields.insert({ "User-Agent", Platform::userAgent() });
+
+    if (!body.empty()) {
+        fields.insert({ "Content-Length", std::to_string(body.size()) });
+    }
+
+    std::stringstream ss;
+    ss << http_method_str(static_cast<http_method>(method)) << " " << url << " HTTP/1.1" << kCRLF;
+
+    for (auto &field : fields) {
+        ss << field.first << ": " << field.second << kCRLF;
+    }
+
+    ss << kCRLF << body;
+
+    return ss.str();
 }
 
 
@@ -33,6 +33,9 @@
 #include "base/tools/Object.h"
 
 
+#include <vector>
+
+
 namespace xmrig {
 
 
@@ -47,25 +50,32 @@ public:
     HttpClient(int method, const String &url, IHttpListener *listener, const char *data = nullptr, size_t size = 0);
     ~HttpClient() override;
 
-    inline uint16_t port() const     { return m_port; }
-    inline void setQuiet(bool quiet) { m_quiet = quiet; }
+    inline bool isReady() const                 { return m_ready; }
+    inline uint16_t port() const                { return m_port; }
+    inline void setKeepAlive(bool keepAlive)    { m_keepAlive = keepAlive; }
+    inline void setQuiet(bool quiet)            { m_quiet = quiet; }
 
     bool connect(const String &host, uint16_t port);
     const String &host() const;
+    void send(int method, const String &url, const char *data = nullptr, size_t size = 0);
 
 protected:
     void onResolved(const Dns &dns, int status) override;
 
     virtual void handshake();
     virtual void read(const char *data, size_t size);
-    virtual void write(const std::string &header);
+    virtual void write(std::string &&data);
 
     bool m_quiet = false;
 
 private:
+    std::string request(int method, const std::string &url, std::string &&body);
+
     static void onConnect(uv_connect_t *req, int status);
 
+    bool m_ready = false;
     Dns *m_dns;
+    std::vector<std::string> m_pending;
     uint16_t m_port = 0;
 };
 
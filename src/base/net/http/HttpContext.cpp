@@ -75,6 +75,12 @@ xmrig::HttpContext::~HttpContext()
 }
 
 
+bool xmrig::HttpContext::shouldKeepAlive() const
+{
+    return http_should_keep_alive(m_parser) != 0;
+}
+
+
 size_t xmrig::HttpContext::parse(const char *data, size_t size)
 {
     return http_parser_execute(m_parser, &http_settings, data, size);
@@ -179,11 +185,23 @@ int xmrig::HttpContext::onHeaderValue(http_parser *parser, const char *at, size_
 
 void xmrig::HttpContext::attach(http_parser_settings *settings)
 {
-    settings->on_message_begin  = nullptr;
     settings->on_status         = nullptr;
     settings->on_chunk_header   = nullptr;
     settings->on_chunk_complete = nullptr;
 
+    settings->on_message_begin = [](http_parser *parser) -> int
+    {
+        auto ctx = static_cast<HttpContext*>(parser->data);
+
+        if (parser->type == HTTP_RESPONSE) {
+            ctx->status = 0;
+            ctx->headers.clear();
+            ctx->body.clear();
+        }
+
+        return 0;
+    };
+
     settings->on_url = [](http_parser *parser, const char *at, size_t length) -> int
     {
         static_cast<HttpContext*>(parser->data)->url = std::string(at, length);
@@ -218,8 +236,15 @@ void xmrig::HttpContext::attach(http_parser_settings *settings)
     settings->on_message_complete = [](http_parser *parser) -> int
     {
         auto ctx = static_cast<HttpContext*>(parser->data);
+        if (!ctx->m_listener) {
+            return 0;
+        }
+
         ctx->m_listener->onHttpData(*ctx);
-        ctx->m_listener = nullptr;
+
+        if (!ctx->m_keepAlive) {
+            ctx->m_listener = nullptr;
+        }
 
         return 0;
     };
@@ -54,9 +54,11 @@ public:
     HttpContext(int parser_type, IHttpListener *listener);
     virtual ~HttpContext();
 
+    inline bool isKeepAlive() const    { return m_keepAlive; }
     inline uv_stream_t *stream() const { return reinterpret_cast<uv_stream_t *>(m_tcp); }
     inline uv_handle_t *handle() const { return reinterpret_cast<uv_handle_t *>(m_tcp); }
 
+    bool shouldKeepAlive() const;
     size_t parse(const char *data, size_t size);
     std::string ip() const;
     uint64_t elapsed() const;
@@ -66,6 +68,7 @@ public:
     static void closeAll();
 
 protected:
+    bool m_keepAlive = false;
     uv_tcp_t *m_tcp;
 
 private:
@@ -0,0 +1,228 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <map>
+#include <uv.h>
+
+
+#include "base/net/http/HttpPool.h"
+#include "base/net/http/HttpClient.h"
+#include "base/tools/Chrono.h"
+
+
+#ifdef XMRIG_FEATURE_TLS
+#   include "base/net/http/HttpsClient.h"
+#endif
+
+
+namespace xmrig {
+
+
+static std::map<std::string, HttpPool *> pools;
+
+
+} // namespace xmrig
+
+
+xmrig::HttpPool::HttpPool(const String &host, uint16_t port, bool tls, const String &fingerprint) :
+    m_tls(tls),
+    m_fingerprint(fingerprint),
+    m_host(host),
+    m_port(port)
+{
+}
+
+
+void xmrig::HttpPool::cancel(IHttpListener *listener)
+{
+    for (auto &kv : pools) {
+        for (auto &connection : kv.second->m_connections) {
+            for (auto &request : connection.requests) {
+                if (request.listener == listener) {
+                    request.listener = nullptr;
+                }
+            }
+        }
+    }
+}
+
+
+void xmrig::HttpPool::send(const String &host, uint16_t port, bool tls, const String &fingerprint, bool quiet, int method, const char *url, IHttpListener *listener, const char *data, size_t size)
+{
+    std::string key = std::string(host.data()) + ":" + std::to_string(port);
+    if (tls) {
+        key += std::string("/tls/") + (fingerprint.isNull() ? "" : fingerprint.data());
+    }
+
+    HttpPool *pool = pools[key];
+    if (!pool) {
+        pool = pools[key] = new HttpPool(host, port, tls, fingerprint);
+    }
+
+    Request request;
+    request.method   = method;
+    request.url      = url;
+    request.listener = listener;
+
+    if (data) {
+        request.data = size ? std::string(data, size) : std::string(data);
+    }
+
+    pool->m_quiet = quiet;
+    pool->send(std::move(request));
+}
+
+
+void xmrig::HttpPool::onHttpData(const HttpData &data)
+{
+    auto it = std::find_if(m_connections.begin(), m_connections.end(), [&data](const Connection &connection) {
+        return static_cast<const HttpData *>(connection.client) == &data;
+    });
+
+    if (it == m_connections.end()) {
+        return;
+    }
+
+    HttpClient *client = it->client;
+
+    if (data.status < 0) {
+        const bool reused                = it->served > 0;
+        std::deque<Request> requests     = std::move(it->requests);
+        m_connections.erase(it);
+
+        for (auto &request : requests) {
+            // A reused connection may have been closed by the server while idle, repeat the request once on a new connection.
+            if (reused && !request.retried) {
+                request.retried = true;
+                send(std::move(request));
+            }
+            else {
+                notify(client, data, request);
+            }
+        }
+
+        return;
+    }
+
+    if (it->requests.empty()) {
+        return;
+    }
+
+    const Request request = std::move(it->requests.front());
+    it->requests.pop_front();
+
+    it->served++;
+    it->timestamp = Chrono::steadyMSecs();
+    it->closing   = !client->shouldKeepAlive();
+
+#   ifdef XMRIG_FEATURE_TLS
+    if (m_tls && it->served == 1) {
+        m_session = static_cast<HttpsClient *>(client)->session();
+    }
+#   endif
+
+    notify(client, data, request);
+}
+
+
+void xmrig::HttpPool::connect(Request &&request)
+{
+    HttpClient *client;
+
+#   ifdef XMRIG_FEATURE_TLS
+    if (m_tls) {
+        auto https = new HttpsClient(request.method, request.url, this, request.data.data(), request.data.size(), m_fingerprint);
+        https->setSession(m_session);
+
+        client = https;
+    }
+    else
+#   endif
+    {
+        client = new HttpClient(request.method, request.url, this, request.data.data(), request.data.size());
+    }
+
+    client->setKeepAlive(true);
+    client->setQuiet(m_quiet);
+
+    Connection connection;
+    connection.client = client;
+    connection.requests.emplace_back(std::move(request));
+
+    m_connections.emplace_back(std::move(connection));
+
+    if (!client->connect(m_host, m_port)) {
+        client->close(UV_EAI_FAIL);
+    }
+}
+
+
+void xmrig::HttpPool::notify(HttpClient *client, const HttpData &data, const Request &request)
+{
+    if (!request.listener) {
+        return;
+    }
+
+    client->method = request.method;
+    client->url    = request.url.data();
+
+    request.listener->onHttpData(data);
+}
+
+
+void xmrig::HttpPool::send(Request &&request)
+{
+    const uint64_t now      = Chrono::steadyMSecs();
+    Connection *target      = nullptr;
+    size_t count            = 0;
+
+    for (auto it = m_connections.begin(); it != m_connections.end();) {
+        if (it->closing) {
+            ++it;
+            continue;
+        }
+
+        if (it->requests.empty() && now - it->timestamp > kIdleTimeout) {
+            it->client->close();
+            it = m_connections.erase(it);
+            continue;
+        }
+
+        if (!target || it->requests.size() < target->requests.size()) {
+            target = &*it;
+        }
+
+        ++count;
+        ++it;
+    }
+
+    if (!target || (!target->requests.empty() && count < kMaxConnections)) {
+        return connect(std::move(request));
+    }
+
+    target->client->send(request.method, request.url, request.data.data(), request.data.size());
+    target->requests.emplace_back(std::move(request));
+}
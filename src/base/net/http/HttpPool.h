@@ -0,0 +1,101 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_HTTPPOOL_H
+#define XMRIG_HTTPPOOL_H
+
+
+#include <deque>
+#include <list>
+#include <string>
+
+
+#include "base/kernel/interfaces/IHttpListener.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+class HttpClient;
+
+
+/**
+ * Per origin pool of HTTP/1.1 keep-alive connections, requests reuse idle
+ * connections and are pipelined when all connections are busy.
+ */
+class HttpPool : public IHttpListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(HttpPool)
+
+    constexpr static size_t kMaxConnections = 2;
+    constexpr static uint64_t kIdleTimeout  = 30000;
+
+    static void cancel(IHttpListener *listener);
+    static void send(const String &host, uint16_t port, bool tls, const String &fingerprint, bool quiet, int method, const char *url, IHttpListener *listener, const char *data = nullptr, size_t size = 0);
+
+protected:
+    void onHttpData(const HttpData &data) override;
+
+private:
+    struct Request
+    {
+        bool retried            = false;
+        int method              = 0;
+        IHttpListener *listener = nullptr;
+        std::string data;
+        String url;
+    };
+
+    struct Connection
+    {
+        bool closing            = false;
+        HttpClient *client      = nullptr;
+        std::deque<Request> requests;
+        uint64_t served         = 0;
+        uint64_t timestamp      = 0;
+    };
+
+    HttpPool(const String &host, uint16_t port, bool tls, const String &fingerprint);
+
+    void connect(Request &&request);
+    void notify(HttpClient *client, const HttpData &data, const Request &request);
+    void send(Request &&request);
+
+    bool m_quiet        = false;
+    bool m_tls;
+    std::list<Connection> m_connections;
+    std::string m_session;
+    String m_fingerprint;
+    String m_host;
+    uint16_t m_port;
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_HTTPPOOL_H
@@ -41,6 +41,7 @@ public:
     HttpResponse(uint64_t id, int statusCode = 200);
 
     inline int statusCode() const                                           { return m_statusCode; }
+    inline uint64_t id() const                                              { return m_id; }
     inline void setHeader(const std::string &key, const std::string &value) { m_headers.insert({ key, value }); }
     inline void setStatus(int code)                                         { m_statusCode = code; }
 
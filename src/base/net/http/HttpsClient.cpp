@@ -68,6 +68,10 @@ xmrig::HttpsClient::~HttpsClient()
     if (m_ssl) {
         SSL_free(m_ssl);
     }
+
+    if (m_session) {
+        SSL_SESSION_free(m_session);
+    }
 }
 
 
@@ -83,6 +87,34 @@ const char *xmrig::HttpsClient::version() const
 }
 
 
+std::string xmrig::HttpsClient::session() const
+{
+    SSL_SESSION *session = m_ready ? SSL_get_session(m_ssl) : nullptr;
+    const int size       = session ? i2d_SSL_SESSION(session, nullptr) : 0;
+
+    if (size <= 0) {
+        return {};
+    }
+
+    std::string out(static_cast<size_t>(size), '\0');
+    auto data = reinterpret_cast<unsigned char *>(&out[0]);
+    i2d_SSL_SESSION(session, &data);
+
+    return out;
+}
+
+
+void xmrig::HttpsClient::setSession(const std::string &session)
+{
+    if (session.empty() || m_session) {
+        return;
+    }
+
+    auto data = reinterpret_cast<const unsigned char *>(session.data());
+    m_session = d2i_SSL_SESSION(nullptr, &data, static_cast<long>(session.size()));
+}
+
+
 void xmrig::HttpsClient::handshake()
 {
     m_ssl = SSL_new(m_ctx);
@@ -96,6 +128,10 @@ void xmrig::HttpsClient::handshake()
     SSL_set_bio(m_ssl, m_readBio, m_writeBio);
     SSL_set_tlsext_host_name(m_ssl, host().data());
 
+    if (m_session) {
+        SSL_set_session(m_ssl, m_session);
+    }
+
     SSL_do_handshake(m_ssl);
 
     flush();
@@ -134,10 +170,9 @@ void xmrig::HttpsClient::read(const char *data, size_t size)
 }
 
 
-void xmrig::HttpsClient::write(const std::string &header)
+void xmrig::HttpsClient::write(std::string &&data)
 {
-    SSL_write(m_ssl, (header + body).c_str(), header.size() + body.size());
-    body.clear();
+    SSL_write(m_ssl, data.c_str(), static_cast<int>(data.size()));
 
     flush();
 }
@@ -28,10 +28,11 @@
 #define XMRIG_HTTPSCLIENT_H
 
 
-using BIO       = struct bio_st;
-using SSL_CTX   = struct ssl_ctx_st;
-using SSL       = struct ssl_st;
-using X509      = struct x509_st;
+using BIO         = struct bio_st;
+using SSL_CTX     = struct ssl_ctx_st;
+using SSL         = struct ssl_st;
+using SSL_SESSION = struct ssl_session_st;
+using X509        = struct x509_st;
 
 
 #include "base/net/http/HttpClient.h"
@@ -51,11 +52,13 @@ public:
 
     const char *fingerprint() const;
     const char *version() const;
+    std::string session() const;
+    void setSession(const std::string &session);
 
 protected:
     void handshake() override;
     void read(const char *data, size_t size) override;
-    void write(const std::string &header) override;
+    void write(std::string &&data) override;
 
 private:
     bool verify(X509 *cert);
@@ -69,6 +72,7 @@ private:
     char m_fingerprint[32 * 2 + 8];
     SSL *m_ssl;
     SSL_CTX *m_ctx;
+    SSL_SESSION *m_session = nullptr;
     String m_fp;
 };
 
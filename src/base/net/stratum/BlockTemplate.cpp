@@ -0,0 +1,293 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstring>
+
+
+#include "base/net/stratum/BlockTemplate.h"
+#include "crypto/common/keccak.h"
+
+
+namespace xmrig {
+
+
+class BlobReader
+{
+public:
+    inline BlobReader(const uint8_t *data, size_t size) : m_data(data), m_size(size) {}
+
+    inline size_t pos() const   { return m_pos; }
+
+    inline bool skip(size_t size)
+    {
+        if (m_size - m_pos < size) {
+            return false;
+        }
+
+        m_pos += size;
+        return true;
+    }
+
+    inline bool byte(uint8_t &out)
+    {
+        if (m_pos >= m_size) {
+            return false;
+        }
+
+        out = m_data[m_pos++];
+        return true;
+    }
+
+    inline bool varint(uint64_t &out)
+    {
+        out = 0;
+
+        for (size_t shift = 0; shift < 64 && m_pos < m_size; shift += 7) {
+            const uint8_t b = m_data[m_pos++];
+            out |= static_cast<uint64_t>(b & 0x7F) << shift;
+
+            if ((b & 0x80) == 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    const uint8_t *m_data;
+    const size_t m_size;
+    size_t m_pos = 0;
+};
+
+
+static inline void fastHash(const uint8_t *in, size_t size, uint8_t *out)
+{
+    keccak(in, static_cast<int>(size), out, BlockTemplate::kHashSize);
+}
+
+
+static void writeVarint(uint64_t value, std::vector<uint8_t> &out)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::BlockTemplate::parse(const String &blocktemplate, size_t reservedOffset, size_t reserveSize)
+{
+    reset();
+
+    if (blocktemplate.size() % 2 || reserveSize == 0 || reserveSize > kReserveSize) {
+        return false;
+    }
+
+    Buffer blob = Buffer::fromHex(blocktemplate);
+    if (blob.size() != blocktemplate.size() / 2) {
+        return false;
+    }
+
+    auto data = reinterpret_cast<const uint8_t *>(blob.data());
+    BlobReader reader(data, blob.size());
+    uint64_t value;
+    uint8_t tag;
+
+    // Block header: major and minor version, timestamp, previous block id and nonce.
+    if (!reader.varint(value) || !reader.varint(value) || !reader.varint(value) || !reader.skip(kHashSize + kNonceSize) || reader.pos() != kNonceOffset + kNonceSize) {
+        return false;
+    }
+
+    const size_t headerSize    = reader.pos();
+    const size_t minerTxOffset = headerSize;
+    uint64_t version;
+    uint64_t count;
+
+    // Miner transaction prefix: version, unlock time and single coinbase input.
+    if (!reader.varint(version) || version == 0 || version > 2 || !reader.varint(value) || !reader.varint(count) || count != 1 || !reader.byte(tag) || tag != 0xFF || !reader.varint(value)) {
+        return false;
+    }
+
+    if (!reader.varint(count)) {
+        return false;
+    }
+
+    for (uint64_t i = 0; i < count; ++i) {
+        if (!reader.varint(value) || !reader.byte(tag)) {
+            return false;
+        }
+
+        // txout_to_key or txout_to_tagged_key (one byte view tag).
+        const size_t keySize = tag == 2 ? kHashSize : (tag == 3 ? kHashSize + 1 : 0);
+        if (keySize == 0 || !reader.skip(keySize)) {
+            return false;
+        }
+    }
+
+    uint64_t extraSize;
+    if (!reader.varint(extraSize)) {
+        return false;
+    }
+
+    const size_t extraOffset = reader.pos();
+    if (!reader.skip(extraSize) || reservedOffset < extraOffset || reservedOffset + reserveSize > reader.pos()) {
+        return false;
+    }
+
+    const size_t minerTxPrefix = reader.pos() - minerTxOffset;
+
+    // Coinbase RingCT signatures are always RCTTypeNull.
+    if (version == 2 && (!reader.byte(tag) || tag != 0)) {
+        return false;
+    }
+
+    const size_t minerTxSize = reader.pos() - minerTxOffset;
+
+    if (!reader.varint(count) || count > (blob.size() - reader.pos()) / kHashSize) {
+        return false;
+    }
+
+    const size_t hashesOffset = reader.pos();
+    if (!reader.skip(count * kHashSize) || reader.pos() != blob.size()) {
+        return false;
+    }
+
+    m_hashes.resize((count + 1) * kHashSize);
+    memcpy(m_hashes.data() + kHashSize, data + hashesOffset, count * kHashSize);
+
+    m_blob           = std::move(blob);
+    m_headerSize     = headerSize;
+    m_minerTxOffset  = minerTxOffset;
+    m_minerTxPrefix  = minerTxPrefix;
+    m_minerTxSize    = minerTxSize;
+    m_reservedOffset = reservedOffset;
+    m_reserveSize    = reserveSize;
+    m_txVersion      = version;
+
+    return true;
+}
+
+
+xmrig::String xmrig::BlockTemplate::hashingBlob(uint64_t extraNonce) const
+{
+    if (!isValid()) {
+        return String();
+    }
+
+    std::vector<uint8_t> blob(m_blob.size());
+    memcpy(blob.data(), m_blob.data(), m_blob.size());
+    BlockTemplate::extraNonce(extraNonce, m_reserveSize, blob.data() + m_reservedOffset);
+
+    std::vector<uint8_t> hashes(m_hashes);
+    minerTxHash(blob.data() + m_minerTxOffset, hashes.data());
+
+    blob.resize(m_headerSize + kHashSize);
+    treeHash(hashes.data(), hashes.size() / kHashSize, blob.data() + m_headerSize);
+    writeVarint(hashes.size() / kHashSize, blob);
+
+    return Buffer::toHex(blob.data(), blob.size());
+}
+
+
+void xmrig::BlockTemplate::reset()
+{
+    m_blob           = Buffer();
+    m_headerSize     = 0;
+    m_minerTxOffset  = 0;
+    m_minerTxPrefix  = 0;
+    m_minerTxSize    = 0;
+    m_reservedOffset = 0;
+    m_reserveSize    = 0;
+    m_txVersion      = 0;
+
+    m_hashes.clear();
+}
+
+
+void xmrig::BlockTemplate::extraNonce(uint64_t extraNonce, size_t size, uint8_t *out)
+{
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = static_cast<uint8_t>(i < sizeof(extraNonce) ? (extraNonce >> (i * 8)) : 0);
+    }
+}
+
+
+void xmrig::BlockTemplate::treeHash(const uint8_t *hashes, size_t count, uint8_t *root)
+{
+    if (count == 1) {
+        memcpy(root, hashes, kHashSize);
+        return;
+    }
+
+    if (count == 2) {
+        fastHash(hashes, kHashSize * 2, root);
+        return;
+    }
+
+    size_t cnt = 2;
+    while (cnt < count) {
+        cnt <<= 1;
+    }
+
+    cnt >>= 1;
+
+    std::vector<uint8_t> ints(cnt * kHashSize);
+    memcpy(ints.data(), hashes, (2 * cnt - count) * kHashSize);
+
+    for (size_t i = 2 * cnt - count, j = 2 * cnt - count; j < cnt; i += 2, ++j) {
+        fastHash(hashes + i * kHashSize, kHashSize * 2, ints.data() + j * kHashSize);
+    }
+
+    while (cnt > 2) {
+        cnt >>= 1;
+
+        for (size_t i = 0, j = 0; j < cnt; i += 2, ++j) {
+            fastHash(ints.data() + i * kHashSize, kHashSize * 2, ints.data() + j * kHashSize);
+        }
+    }
+
+    fastHash(ints.data(), kHashSize * 2, root);
+}
+
+
+void xmrig::BlockTemplate::minerTxHash(const uint8_t *blob, uint8_t *out) const
+{
+    if (m_txVersion == 1) {
+        return fastHash(blob, m_minerTxSize, out);
+    }
+
+    // Version 2 transaction hash: prefix hash, RingCT base hash (type byte only) and empty prunable hash.
+    uint8_t hashes[kHashSize * 3] = {};
+    fastHash(blob, m_minerTxPrefix, hashes);
+    fastHash(blob + m_minerTxPrefix, m_minerTxSize - m_minerTxPrefix, hashes + kHashSize);
+
+    fastHash(hashes, sizeof(hashes), out);
+}
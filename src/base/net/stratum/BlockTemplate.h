@@ -0,0 +1,82 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BLOCKTEMPLATE_H
+#define XMRIG_BLOCKTEMPLATE_H
+
+
+#include <vector>
+
+
+#include "base/tools/Buffer.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+/**
+ * Parsed CryptoNote block template, rebuilds the block hashing blob after the
+ * extra nonce in the miner transaction reserved area was changed.
+ */
+class BlockTemplate
+{
+public:
+    static constexpr size_t kHashSize        = 32;
+    static constexpr size_t kNonceOffset     = 39;
+    static constexpr size_t kNonceSize       = 4;
+    static constexpr size_t kReserveSize     = 8;
+
+    BlockTemplate() = default;
+
+    inline bool isValid() const                 { return m_reserveSize > 0; }
+    inline size_t reservedOffset() const        { return m_reservedOffset; }
+    inline size_t reserveSize() const           { return m_reserveSize; }
+
+    bool parse(const String &blocktemplate, size_t reservedOffset, size_t reserveSize);
+    String hashingBlob(uint64_t extraNonce) const;
+    void reset();
+
+    static void extraNonce(uint64_t extraNonce, size_t size, uint8_t *out);
+    static void treeHash(const uint8_t *hashes, size_t count, uint8_t *root);
+
+private:
+    void minerTxHash(const uint8_t *blob, uint8_t *out) const;
+
+    Buffer m_blob;
+    size_t m_headerSize      = 0;
+    size_t m_minerTxOffset   = 0;
+    size_t m_minerTxPrefix   = 0;
+    size_t m_minerTxSize     = 0;
+    size_t m_reservedOffset  = 0;
+    size_t m_reserveSize     = 0;
+    std::vector<uint8_t> m_hashes;
+    uint64_t m_txVersion     = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BLOCKTEMPLATE_H */
@@ -28,6 +28,7 @@
 #include <iterator>
 #include <cstdio>
 #include <cstring>
+#include <string>
 #include <utility>
 
 
@@ -44,8 +45,11 @@
 #include "base/kernel/interfaces/IClientListener.h"
 #include "base/net/dns/Dns.h"
 #include "base/net/stratum/Client.h"
+#include "base/net/tools/TcpConnector.h"
+#include "base/tools/Baton.h"
 #include "base/tools/Buffer.h"
 #include "base/tools/Chrono.h"
+#include "base/tools/Handle.h"
 #include "net/JobResult.h"
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
@@ -62,6 +66,27 @@ namespace xmrig {
 
 Storage<Client> Client::m_storage;
 
+
+class StratumWriteBaton : public Baton<uv_write_t>
+{
+public:
+    inline StratumWriteBaton(const char *data, size_t size) :
+        m_data(data, size)
+    {
+        buf.len  = m_data.size();
+        buf.base = const_cast<char *>(m_data.c_str());
+    }
+
+
+    inline static void onWrite(uv_write_t *req, int) { delete reinterpret_cast<StratumWriteBaton *>(req->data); }
+
+
+    uv_buf_t buf{};
+
+private:
+    std::string m_data;
+};
+
 } /* namespace xmrig */
 
 
@@ -81,14 +106,22 @@ xmrig::Client::Client(int id, const char *agent, IClientListener *listener) :
     BaseClient(id, listener),
     m_agent(agent)
 {
-    m_key = m_storage.add(this);
-    m_dns = new Dns(this);
+    m_key       = m_storage.add(this);
+    m_dns       = new Dns(this);
+    m_connector = new TcpConnector(this);
+
+    m_flush = new uv_check_t;
+    m_flush->data = m_storage.ptr(m_key);
+    uv_check_init(uv_default_loop(), m_flush);
 }
 
 
 xmrig::Client::~Client()
 {
+    Handle::close(m_flush);
+
     delete m_dns;
+    delete m_connector;
     delete m_socket;
 }
 
@@ -186,8 +219,8 @@ int64_t xmrig::Client::submit(const JobResult &result)
     const char *nonce = result.nonce;
     const char *data  = result.result;
 #   else
-    char *nonce = m_sendBuf;
-    char *data  = m_sendBuf + 16;
+    char nonce[9];
+    char data[65];
 
     Buffer::toHex(reinterpret_cast<const char*>(&result.nonce), 4, nonce);
     nonce[8] = '\0';
@@ -196,6 +229,11 @@ int64_t xmrig::Client::submit(const JobResult &result)
     data[64] = '\0';
 #   endif
 
+    const int64_t id = batch(result, nonce, data);
+    if (id != -2) {
+        return id;
+    }
+
     Document doc(kObjectType);
     auto &allocator = doc.GetAllocator();
 
@@ -273,11 +311,43 @@ void xmrig::Client::tick(uint64_t now)
     }
 
     if (m_state == ConnectingState && m_expire && now > m_expire) {
+        m_connector->cancel();
+
         return reconnect();
     }
 }
 
 
+void xmrig::Client::onConnected(uv_tcp_t *tcp, const DnsRecord &record, int status)
+{
+    if (status < 0) {
+        if (!isQuiet() && status != UV_ECANCELED) {
+            LOG_ERR("[%s] connect error: \"%s\"", url(), uv_strerror(status));
+        }
+
+        return onClose();
+    }
+
+    m_ip     = record.ip();
+    m_socket = tcp;
+    m_stream = reinterpret_cast<uv_stream_t*>(tcp);
+
+    m_socket->data = m_storage.ptr(m_key);
+
+    uv_tcp_nodelay(m_socket, 1);
+
+#   ifndef WIN32
+    uv_tcp_keepalive(m_socket, 1, 60);
+#   endif
+
+    setState(ConnectedState);
+
+    uv_read_start(m_stream, onAllocBuffer, onRead);
+
+    handshake();
+}
+
+
 void xmrig::Client::onResolved(const Dns &dns, int status)
 {
     assert(m_listener != nullptr);
@@ -293,10 +363,9 @@ void xmrig::Client::onResolved(const Dns &dns, int status)
         return reconnect();
     }
 
-    const DnsRecord &record = dns.get();
-    m_ip = record.ip();
+    setState(ConnectingState);
 
-    connect(record.addr(m_pool.port()));
+    m_connector->connect(dns.records(), m_pool.port());
 }
 
 
@@ -306,12 +375,22 @@ bool xmrig::Client::close()
         return m_socket != nullptr;
     }
 
+    if (m_state == ConnectingState && m_socket == nullptr && m_connector->isActive()) {
+        setState(ClosingState);
+        m_connector->close();
+
+        return true;
+    }
+
     if (m_state == UnconnectedState || m_socket == nullptr) {
         return false;
     }
 
     setState(ClosingState);
 
+    uv_check_stop(m_flush);
+    m_batch.clear();
+
     if (uv_is_closing(reinterpret_cast<uv_handle_t*>(m_socket)) == 0) {
         uv_close(reinterpret_cast<uv_handle_t*>(m_socket), Client::onClose);
     }
@@ -456,11 +535,7 @@ bool xmrig::Client::send(BIO *bio)
 
     bool result = false;
     if (state() == ConnectedState && uv_is_writable(m_stream)) {
-        result = uv_try_write(m_stream, &buf, 1) > 0;
-
-        if (!result) {
-            close();
-        }
+        result = write(buf);
     }
     else {
         LOG_DEBUG_ERR("[%s] send failed, invalid state: %d", url(), m_state);
@@ -475,6 +550,18 @@ bool xmrig::Client::send(BIO *bio)
 }
 
 
+bool xmrig::Client::isPlain(const char *str)
+{
+    for (; *str; ++str) {
+        if (*str == '"' || *str == '\\' || static_cast<unsigned char>(*str) < 0x20) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 bool xmrig::Client::verifyAlgorithm(const Algorithm &algorithm, const char *algo) const
 {
     if (!algorithm.isValid()) {
@@ -501,6 +588,101 @@ bool xmrig::Client::verifyAlgorithm(const Algorithm &algorithm, const char *algo
 }
 
 
+bool xmrig::Client::write(const uv_buf_t &buf)
+{
+    const int rc = uv_try_write(m_stream, &buf, 1);
+    if (rc < 0 && rc != UV_EAGAIN) {
+        close();
+
+        return false;
+    }
+
+    // The socket send buffer is full or a previous write is still pending, queue the rest to keep the stream intact.
+    const size_t written = rc > 0 ? static_cast<size_t>(rc) : 0;
+    if (written < buf.len) {
+        auto baton = new StratumWriteBaton(buf.base + written, buf.len - written);
+        uv_write(&baton->req, m_stream, &baton->buf, 1, StratumWriteBaton::onWrite);
+    }
+
+    return true;
+}
+
+
+/**
+ * Shares are formatted without building a JSON document and queued, everything queued within one event loop
+ * iteration is written to the socket at once by flush().
+ *
+ * Returns -2 if the share can't be represented by the fixed template, the caller must use the generic path.
+ */
+int64_t xmrig::Client::batch(const JobResult &result, const char *nonce, const char *data)
+{
+    if (!isPlain(m_rpcId.data()) || !isPlain(result.jobId.data())) {
+        return -2;
+    }
+
+    const bool algo = has<EXT_ALGO>() && result.algorithm.isValid();
+    const int size  = snprintf(m_sendBuf, sizeof(m_sendBuf),
+                               "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"method\":\"submit\",\"params\":{\"id\":\"%s\",\"job_id\":\"%s\",\"nonce\":\"%s\",\"result\":\"%s\"%s%s%s}}\n",
+                               m_sequence, m_rpcId.data(), result.jobId.data(), nonce, data,
+                               algo ? ",\"algo\":\"" : "", algo ? result.algorithm.shortName() : "", algo ? "\"" : ""
+                               );
+
+    if (size <= 0 || static_cast<size_t>(size) >= sizeof(m_sendBuf)) {
+        return -2;
+    }
+
+    if (state() != ConnectedState) {
+        LOG_DEBUG_ERR("[%s] send failed, invalid state: %d", url(), m_state);
+        return -1;
+    }
+
+    LOG_DEBUG("[%s] send (%d bytes): \"%.*s\"", url(), size, size - 1, m_sendBuf);
+
+    if (m_batch.empty()) {
+        uv_check_start(m_flush, Client::onFlush);
+    }
+
+    m_batch.insert(m_batch.end(), m_sendBuf, m_sendBuf + size);
+
+#   ifdef XMRIG_PROXY_PROJECT
+    m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), result.id, 0);
+#   else
+    m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), 0, result.backend);
+#   endif
+
+    m_expire = Chrono::steadyMSecs() + kResponseTimeout;
+    return m_sequence++;
+}
+
+
+bool xmrig::Client::flush()
+{
+    if (m_batch.empty()) {
+        return true;
+    }
+
+    uv_check_stop(m_flush);
+
+    bool result = false;
+
+#   ifdef XMRIG_FEATURE_TLS
+    if (isTLS()) {
+        result = m_tls->send(m_batch.data(), m_batch.size());
+    }
+    else
+#   endif
+    if (state() == ConnectedState && uv_is_writable(m_stream)) {
+        uv_buf_t buf = uv_buf_init(m_batch.data(), static_cast<unsigned int>(m_batch.size()));
+
+        result = write(buf);
+    }
+
+    m_batch.clear();
+
+    return result;
+}
+
+
 int xmrig::Client::resolve(const String &host)
 {
     setState(HostLookupState);
@@ -527,6 +709,10 @@ int64_t xmrig::Client::send(size_t size)
 {
     LOG_DEBUG("[%s] send (%d bytes): \"%.*s\"", url(), size, static_cast<int>(size) - 1, m_sendBuf);
 
+    if (!flush()) {
+        return -1;
+    }
+
 #   ifdef XMRIG_FEATURE_TLS
     if (isTLS()) {
         if (!m_tls->send(m_sendBuf, size)) {
@@ -543,8 +729,7 @@ int64_t xmrig::Client::send(size_t size)
 
         uv_buf_t buf = uv_buf_init(m_sendBuf, (unsigned int) size);
 
-        if (uv_try_write(m_stream, &buf, 1) < 0) {
-            close();
+        if (!write(buf)) {
             return -1;
         }
     }
@@ -554,29 +739,6 @@ int64_t xmrig::Client::send(size_t size)
 }
 
 
-void xmrig::Client::connect(sockaddr *addr)
-{
-    setState(ConnectingState);
-
-    uv_connect_t *req = new uv_connect_t;
-    req->data = m_storage.ptr(m_key);
-
-    m_socket = new uv_tcp_t;
-    m_socket->data = m_storage.ptr(m_key);
-
-    uv_tcp_init(uv_default_loop(), m_socket);
-    uv_tcp_nodelay(m_socket, 1);
-
-#   ifndef WIN32
-    uv_tcp_keepalive(m_socket, 1, 60);
-#   endif
-
-    uv_tcp_connect(req, m_socket, addr, onConnect);
-
-    delete addr;
-}
-
-
 void xmrig::Client::handshake()
 {
 #   ifdef XMRIG_FEATURE_TLS
@@ -926,44 +1088,12 @@ void xmrig::Client::onClose(uv_handle_t *handle)
 }
 
 
-void xmrig::Client::onConnect(uv_connect_t *req, int status)
+void xmrig::Client::onFlush(uv_check_t *handle)
 {
-    auto client = getClient(req->data);
-    if (!client) {
-        delete req;
-        return;
-    }
-
-    if (status < 0) {
-        if (!client->isQuiet()) {
-            LOG_ERR("[%s] connect error: \"%s\"", client->url(), uv_strerror(status));
-        }
-
-        if (client->state() == ReconnectingState) {
-            return;
-        }
-
-        if (client->state() != ConnectingState) {
-            if (!client->isQuiet()) {
-                LOG_ERR("[%s] connect error: \"invalid state: %d\"", client->url(), client->state());
-            }
-
-            return;
-        }
-
-        delete req;
-        client->close();
-        return;
+    auto client = getClient(handle->data);
+    if (client) {
+        client->flush();
     }
-
-    client->m_stream = static_cast<uv_stream_t*>(req->handle);
-    client->m_stream->data = req->data;
-    client->setState(ConnectedState);
-
-    uv_read_start(client->m_stream, onAllocBuffer, onRead);
-    delete req;
-
-    client->handshake();
 }
 
 
@@ -35,6 +35,7 @@
 
 #include "base/kernel/interfaces/IDnsListener.h"
 #include "base/kernel/interfaces/ILineListener.h"
+#include "base/kernel/interfaces/ITcpConnectorListener.h"
 #include "base/net/stratum/BaseClient.h"
 #include "base/net/stratum/Job.h"
 #include "base/net/stratum/Pool.h"
@@ -53,9 +54,10 @@ namespace xmrig {
 
 class IClientListener;
 class JobResult;
+class TcpConnector;
 
 
-class Client : public BaseClient, public IDnsListener, public ILineListener
+class Client : public BaseClient, public IDnsListener, public ILineListener, public ITcpConnectorListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Client)
@@ -85,6 +87,7 @@ protected:
     void deleteLater() override;
     void tick(uint64_t now) override;
 
+    void onConnected(uv_tcp_t *tcp, const DnsRecord &record, int status) override;
     void onResolved(const Dns &dns, int status) override;
 
     inline bool hasExtension(Extension extension) const noexcept override { return m_extensions.test(extension); }
@@ -95,14 +98,16 @@ private:
     class Tls;
 
     bool close();
+    bool flush();
     bool isCriticalError(const char *message);
     bool parseJob(const rapidjson::Value &params, int *code);
     bool parseLogin(const rapidjson::Value &result, int *code);
     bool send(BIO *bio);
     bool verifyAlgorithm(const Algorithm &algorithm, const char *algo) const;
+    bool write(const uv_buf_t &buf);
     int resolve(const String &host);
+    int64_t batch(const JobResult &result, const char *nonce, const char *data);
     int64_t send(size_t size);
-    void connect(sockaddr *addr);
     void handshake();
     void login();
     void onClose();
@@ -121,9 +126,10 @@ private:
     inline void setExtension(Extension ext, bool enable) noexcept { m_extensions.set(ext, enable); }
     template<Extension ext> inline bool has() const noexcept      { return m_extensions.test(ext); }
 
+    static bool isPlain(const char *str);
     static void onAllocBuffer(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf);
     static void onClose(uv_handle_t *handle);
-    static void onConnect(uv_connect_t *req, int status);
+    static void onFlush(uv_check_t *handle);
     static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
 
     static inline Client *getClient(void *data) { return m_storage.get(data); }
@@ -131,14 +137,17 @@ private:
     char m_sendBuf[2048] = { 0 };
     const char *m_agent;
     Dns *m_dns;
+    TcpConnector *m_connector;
     RecvBuf<kInputBufferSize> m_recvBuf;
     std::bitset<EXT_MAX> m_extensions;
+    std::vector<char> m_batch;
     String m_rpcId;
     Tls *m_tls                  = nullptr;
     uint64_t m_expire           = 0;
     uint64_t m_jobs             = 0;
     uint64_t m_keepAlive        = 0;
     uintptr_t m_key             = 0;
+    uv_check_t *m_flush         = nullptr;
     uv_stream_t *m_stream       = nullptr;
     uv_tcp_t *m_socket          = nullptr;
 
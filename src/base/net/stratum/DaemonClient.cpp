@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 
 
 #include "3rdparty/http-parser/http_parser.h"
@@ -33,10 +34,12 @@
 #include "base/io/json/JsonRequest.h"
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IClientListener.h"
-#include "base/net/http/HttpClient.h"
+#include "base/net/http/HttpPool.h"
 #include "base/net/stratum/DaemonClient.h"
 #include "base/net/stratum/SubmitResult.h"
+#include "base/net/zmq/ZmqSubscriber.h"
 #include "base/tools/Buffer.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Timer.h"
 #include "net/JobResult.h"
 #include "rapidjson/document.h"
@@ -50,6 +53,11 @@
 #endif
 
 
+#ifndef XMRIG_PROXY_PROJECT
+#   include "crypto/common/Nonce.h"
+#endif
+
+
 namespace xmrig {
 
 static const char *kBlocktemplateBlob       = "blocktemplate_blob";
@@ -58,6 +66,7 @@ static const char *kGetInfo                 = "/getinfo";
 static const char *kHash                    = "hash";
 static const char *kHeight                  = "height";
 static const char *kJsonRPC                 = "/json_rpc";
+static const char *kZMQTopic                = "json-minimal-chain_main";
 
 }
 
@@ -72,7 +81,10 @@ xmrig::DaemonClient::DaemonClient(int id, IClientListener *listener) :
 
 xmrig::DaemonClient::~DaemonClient()
 {
+    HttpPool::cancel(this);
+
     delete m_timer;
+    delete m_zmq;
 }
 
 
@@ -98,21 +110,41 @@ bool xmrig::DaemonClient::isTLS() const
 
 int64_t xmrig::DaemonClient::submit(const JobResult &result)
 {
-    if (result.jobId != (m_blocktemplate.data() + m_blocktemplate.size() - 32)) {
+    const size_t reserveSize = m_template.reserveSize() * 2;
+
+    if (result.jobId.size() < 32 || memcmp(result.jobId.data(), m_templateId.data(), 32) != 0) {
+        return -1;
+    }
+
+    if (result.jobId.size() > 32 && result.jobId.size() != 32 + reserveSize) {
         return -1;
     }
 
+    // Patch a copy, the stored template must stay pristine for the next results of the same job.
+    String blob = m_blocktemplate;
+
+    if (m_template.isValid()) {
+        char *reserved = blob.data() + m_template.reservedOffset() * 2;
+
+        if (result.jobId.size() > 32) {
+            memcpy(reserved, result.jobId.data() + 32, reserveSize);
+        }
+        else {
+            memset(reserved, '0', reserveSize);
+        }
+    }
+
 #   ifdef XMRIG_PROXY_PROJECT
-    memcpy(m_blocktemplate.data() + 78, result.nonce, 8);
+    memcpy(blob.data() + 78, result.nonce, 8);
 #   else
-    Buffer::toHex(reinterpret_cast<const uint8_t *>(&result.nonce), 4, m_blocktemplate.data() + 78);
+    Buffer::toHex(reinterpret_cast<const uint8_t *>(&result.nonce), 4, blob.data() + 78);
 #   endif
 
     using namespace rapidjson;
     Document doc(kObjectType);
 
     Value params(kArrayType);
-    params.PushBack(m_blocktemplate.toJSON(), doc.GetAllocator());
+    params.PushBack(blob.toJSON(), doc.GetAllocator());
 
     JsonRequest::create(doc, m_sequence, "submitblock", params);
 
@@ -142,6 +174,16 @@ void xmrig::DaemonClient::connect(const Pool &pool)
 }
 
 
+void xmrig::DaemonClient::tick(uint64_t)
+{
+#   ifndef XMRIG_PROXY_PROJECT
+    if (m_state == ConnectedState && m_template.isValid() && Nonce::isExhausted(0)) {
+        rollExtraNonce();
+    }
+#   endif
+}
+
+
 void xmrig::DaemonClient::onHttpData(const HttpData &data)
 {
     if (data.status != HTTP_STATUS_OK) {
@@ -200,6 +242,56 @@ void xmrig::DaemonClient::onTimer(const Timer *)
     }
     else if (m_state == ConnectedState) {
         send(HTTP_GET, m_monero ? kGetHeight : kGetInfo);
+
+        if (m_zmq && m_zmq->state() == ZmqSubscriber::UnconnectedState && Chrono::steadyMSecs() - m_zmqClosed >= m_retryPause) {
+            subscribe();
+        }
+    }
+}
+
+
+void xmrig::DaemonClient::onZmqClose(const ZmqSubscriber &zmq, int status)
+{
+    m_zmqClosed = Chrono::steadyMSecs();
+
+    if (!isQuiet()) {
+        LOG_WARN("[%s:%d] ZMQ error: \"%s\", fallback to polling", zmq.host().data(), zmq.port(), uv_strerror(status));
+    }
+
+    if (m_state == ConnectedState) {
+        startPolling();
+    }
+}
+
+
+void xmrig::DaemonClient::onZmqMessage(const ZmqSubscriber &zmq, const char *data, size_t size)
+{
+    const size_t topicSize = zmq.topic().size();
+    if (m_state != ConnectedState || size <= topicSize || memcmp(data, zmq.topic().data(), topicSize) != 0 || data[topicSize] != ':') {
+        return;
+    }
+
+    LOG_DEBUG("[%s:%d] ZMQ received (%zu bytes): \"%.*s\"", zmq.host().data(), zmq.port(), size, static_cast<int>(size), data);
+
+    rapidjson::Document doc;
+    if (!doc.Parse(data + topicSize + 1, size - topicSize - 1).HasParseError()) {
+        const rapidjson::Value &ids = Json::getArray(doc, "ids");
+        if (ids.IsArray() && !ids.Empty() && ids[ids.Size() - 1].IsString() && m_prevHash == ids[ids.Size() - 1].GetString()) {
+            return;
+        }
+    }
+
+    getBlockTemplate();
+}
+
+
+void xmrig::DaemonClient::onZmqReady(const ZmqSubscriber &zmq)
+{
+    LOG_DEBUG("[%s:%d] ZMQ subscribed to " MAGENTA_BOLD("\"%s\""), zmq.host().data(), zmq.port(), zmq.topic().data());
+
+    if (m_state == ConnectedState) {
+        m_timer->stop();
+        send(HTTP_GET, m_monero ? kGetHeight : kGetInfo);
     }
 }
 
@@ -215,7 +307,7 @@ bool xmrig::DaemonClient::parseJob(const rapidjson::Value &params, int *code)
     Job job(false, m_pool.algorithm(), String());
 
     String blocktemplate = Json::getString(params, kBlocktemplateBlob);
-    if (blocktemplate.isNull() || !job.setBlob(Json::getString(params, "blockhashing_blob"))) {
+    if (blocktemplate.size() < 32 || !job.setBlob(Json::getString(params, "blockhashing_blob"))) {
         *code = 4;
         return false;
     }
@@ -223,14 +315,22 @@ bool xmrig::DaemonClient::parseJob(const rapidjson::Value &params, int *code)
     job.setSeedHash(Json::getString(params, "seed_hash"));
     job.setHeight(Json::getUint64(params, kHeight));
     job.setDiff(Json::getUint64(params, "difficulty"));
-    job.setId(blocktemplate.data() + blocktemplate.size() - 32);
+    String templateId(blocktemplate.data() + blocktemplate.size() - 32, 32);
+    job.setId(templateId.data());
 
     if (m_pool.coin().isValid()) {
         job.setAlgorithm(m_pool.coin().algorithm(job.blob()[0]));
     }
 
+    // The block hashing blob is rebuilt locally for every extra nonce, use it only if it matches the daemon for the initial one.
+    m_extraNonce = 0;
+    if (!m_template.parse(blocktemplate, Json::getUint64(params, "reserved_offset"), BlockTemplate::kReserveSize) || m_template.hashingBlob(0) != Json::getString(params, "blockhashing_blob")) {
+        m_template.reset();
+    }
+
     m_job           = std::move(job);
     m_blocktemplate = std::move(blocktemplate);
+    m_templateId    = std::move(templateId);
     m_prevHash      = Json::getString(params, "prev_hash");
 
     if (m_state == ConnectingState) {
@@ -285,7 +385,7 @@ int64_t xmrig::DaemonClient::getBlockTemplate()
 
     Value params(kObjectType);
     params.AddMember("wallet_address", m_pool.user().toJSON(), allocator);
-    params.AddMember("reserve_size",   8,                      allocator);
+    params.AddMember("reserve_size",   static_cast<uint64_t>(BlockTemplate::kReserveSize), allocator);
 
     JsonRequest::create(doc, m_sequence, "getblocktemplate", params);
 
@@ -295,6 +395,15 @@ int64_t xmrig::DaemonClient::getBlockTemplate()
 }
 
 
+xmrig::String xmrig::DaemonClient::jobId(uint64_t extraNonce) const
+{
+    uint8_t reserved[BlockTemplate::kReserveSize];
+    BlockTemplate::extraNonce(extraNonce, m_template.reserveSize(), reserved);
+
+    return (std::string(m_templateId.data(), m_templateId.size()) + Buffer::toHex(reserved, m_template.reserveSize()).data()).c_str();
+}
+
+
 void xmrig::DaemonClient::retry()
 {
     m_failures++;
@@ -313,6 +422,47 @@ void xmrig::DaemonClient::retry()
 }
 
 
+void xmrig::DaemonClient::startPolling()
+{
+    if (m_zmq && m_zmq->isReady()) {
+        return;
+    }
+
+    const uint64_t interval = std::max<uint64_t>(20, m_pool.pollInterval());
+    m_timer->start(interval, interval);
+}
+
+
+void xmrig::DaemonClient::subscribe()
+{
+    if (m_pool.zmqPort() <= 0 || m_pool.zmqPort() > 0xFFFF) {
+        return;
+    }
+
+    if (!m_zmq) {
+        m_zmq = new ZmqSubscriber(this, kZMQTopic);
+    }
+
+    if (m_zmq->state() == ZmqSubscriber::UnconnectedState && !m_zmq->connect(m_pool.host(), static_cast<uint16_t>(m_pool.zmqPort()))) {
+        m_zmqClosed = Chrono::steadyMSecs();
+    }
+}
+
+
+void xmrig::DaemonClient::rollExtraNonce()
+{
+    Job job(m_job);
+    if (!job.setBlob(m_template.hashingBlob(m_extraNonce + 1))) {
+        return;
+    }
+
+    job.setId(jobId(++m_extraNonce));
+
+    m_job = std::move(job);
+    m_listener->onJobReceived(this, m_job, rapidjson::Value());
+}
+
+
 void xmrig::DaemonClient::send(int method, const char *url, const char *data, size_t size)
 {
     LOG_DEBUG("[%s:%d] " MAGENTA_BOLD("\"%s %s\"") BLACK_BOLD_S " send (%zu bytes): \"%.*s\"",
@@ -324,19 +474,7 @@ void xmrig::DaemonClient::send(int method, const char *url, const char *data, si
               static_cast<int>(size),
               data);
 
-    HttpClient *client;
-#   ifdef XMRIG_FEATURE_TLS
-    if (m_pool.isTLS()) {
-        client = new HttpsClient(method, url, this, data, size, m_pool.fingerprint());
-    }
-    else
-#   endif
-    {
-        client = new HttpClient(method, url, this, data, size);
-    }
-
-    client->setQuiet(isQuiet());
-    client->connect(m_pool.host(), m_pool.port());
+    HttpPool::send(m_pool.host(), m_pool.port(), isTLS(), m_pool.fingerprint(), isQuiet(), method, url, this, data, size);
 }
 
 
@@ -367,14 +505,18 @@ void xmrig::DaemonClient::setState(SocketState state)
             m_failures = 0;
             m_listener->onLoginSuccess(this);
 
-            const uint64_t interval = std::max<uint64_t>(20, m_pool.pollInterval());
-            m_timer->start(interval, interval);
+            startPolling();
+            subscribe();
         }
         break;
 
     case UnconnectedState:
         m_failures = -1;
         m_timer->stop();
+
+        if (m_zmq) {
+            m_zmq->close();
+        }
         break;
 
     default:
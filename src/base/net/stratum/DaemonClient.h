@@ -29,14 +29,16 @@
 
 #include "base/kernel/interfaces/IHttpListener.h"
 #include "base/kernel/interfaces/ITimerListener.h"
+#include "base/kernel/interfaces/IZmqListener.h"
 #include "base/net/stratum/BaseClient.h"
+#include "base/net/stratum/BlockTemplate.h"
 #include "base/tools/Object.h"
 
 
 namespace xmrig {
 
 
-class DaemonClient : public BaseClient, public ITimerListener, public IHttpListener
+class DaemonClient : public BaseClient, public ITimerListener, public IHttpListener, public IZmqListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(DaemonClient)
@@ -53,6 +55,9 @@ protected:
 
     void onHttpData(const HttpData &data) override;
     void onTimer(const Timer *timer) override;
+    void onZmqClose(const ZmqSubscriber &zmq, int status) override;
+    void onZmqMessage(const ZmqSubscriber &zmq, const char *data, size_t size) override;
+    void onZmqReady(const ZmqSubscriber &zmq) override;
 
     inline bool hasExtension(Extension) const noexcept override         { return false; }
     inline const char *mode() const override                            { return "daemon"; }
@@ -61,24 +66,34 @@ protected:
     inline int64_t send(const rapidjson::Value &, Callback) override    { return -1; }
     inline int64_t send(const rapidjson::Value &) override              { return -1; }
     inline void deleteLater() override                                  { delete this; }
-    inline void tick(uint64_t) override                                 {}
+
+    void tick(uint64_t now) override;
 
 private:
     bool isOutdated(uint64_t height, const char *hash) const;
     bool parseJob(const rapidjson::Value &params, int *code);
     bool parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error);
     int64_t getBlockTemplate();
+    String jobId(uint64_t extraNonce) const;
     void retry();
+    void rollExtraNonce();
+    void startPolling();
+    void subscribe();
     void send(int method, const char *url, const char *data = nullptr, size_t size = 0);
     void send(int method, const char *url, const rapidjson::Document &doc);
     void setState(SocketState state);
 
+    BlockTemplate m_template;
     bool m_monero;
     String m_blocktemplate;
     String m_prevHash;
+    String m_templateId;
     String m_tlsFingerprint;
     String m_tlsVersion;
     Timer *m_timer;
+    uint64_t m_extraNonce   = 0;
+    uint64_t m_zmqClosed    = 0;
+    ZmqSubscriber *m_zmq    = nullptr;
 };
 
 
@@ -51,6 +51,7 @@ static const char *kAlgo                   = "algo";
 static const char *kCoin                   = "coin";
 static const char *kDaemon                 = "daemon";
 static const char *kDaemonPollInterval     = "daemon-poll-interval";
+static const char *kDaemonZMQPort          = "daemon-zmq-port";
 static const char *kEnabled                = "enabled";
 static const char *kFingerprint            = "tls-fingerprint";
 static const char *kKeepalive              = "keepalive";
@@ -61,6 +62,7 @@ static const char *kSelfSelect             = "self-select";
 static const char *kTls                    = "tls";
 static const char *kUrl                    = "url";
 static const char *kUser                   = "user";
+static const char *kWeight                 = "weight";
 
 const String Pool::kDefaultPassword        = "x";
 const String Pool::kDefaultUser            = "x";
@@ -90,6 +92,8 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     m_rigId        = Json::getString(object, kRigId);
     m_fingerprint  = Json::getString(object, kFingerprint);
     m_pollInterval = Json::getUint64(object, kDaemonPollInterval, kDefaultPollInterval);
+    m_zmqPort      = Json::getInt(object, kDaemonZMQPort, m_zmqPort);
+    m_weight       = Json::getUint(object, kWeight);
     m_algorithm    = Json::getString(object, kAlgo);
     m_coin         = Json::getString(object, kCoin);
     m_daemon       = Json::getString(object, kSelfSelect);
@@ -169,6 +173,8 @@ bool xmrig::Pool::isEqual(const Pool &other) const
             && m_url          == other.m_url
             && m_user         == other.m_user
             && m_pollInterval == other.m_pollInterval
+            && m_zmqPort      == other.m_zmqPort
+            && m_weight       == other.m_weight
             && m_daemon       == other.m_daemon
             );
 }
@@ -233,9 +239,11 @@ rapidjson::Value xmrig::Pool::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kTls),                isTLS(), allocator);
     obj.AddMember(StringRef(kFingerprint),        m_fingerprint.toJSON(), allocator);
     obj.AddMember(StringRef(kDaemon),             m_mode == MODE_DAEMON, allocator);
+    obj.AddMember(StringRef(kWeight),             m_weight, allocator);
 
     if (m_mode == MODE_DAEMON) {
         obj.AddMember(StringRef(kDaemonPollInterval), m_pollInterval, allocator);
+        obj.AddMember(StringRef(kDaemonZMQPort),      m_zmqPort, allocator);
     }
     else {
         obj.AddMember(StringRef(kSelfSelect), m_daemon.url().toJSON(), allocator);
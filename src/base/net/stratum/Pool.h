@@ -84,9 +84,11 @@ public:
     inline const String &user() const                   { return !m_user.isNull() ? m_user : kDefaultUser; }
     inline const Url &daemon() const                    { return m_daemon; }
     inline int keepAlive() const                        { return m_keepAlive; }
+    inline int zmqPort() const                          { return m_zmqPort; }
     inline Mode mode() const                            { return m_mode; }
     inline uint16_t port() const                        { return m_url.port(); }
     inline uint64_t pollInterval() const                { return m_pollInterval; }
+    inline uint32_t weight() const                      { return m_weight; }
     inline void setAlgo(const Algorithm &algorithm)     { m_algorithm = algorithm; }
     inline void setPassword(const String &password)     { m_password = password; }
     inline void setRigId(const String &rigId)           { m_rigId = rigId; }
@@ -119,12 +121,14 @@ private:
     Algorithm m_algorithm;
     Coin m_coin;
     int m_keepAlive                 = 0;
+    int m_zmqPort                   = -1;
     Mode m_mode                     = MODE_POOL;
     std::bitset<FLAG_MAX> m_flags   = 0;
     String m_fingerprint;
     String m_password;
     String m_rigId;
     String m_user;
+    uint32_t m_weight               = 0;
     uint64_t m_pollInterval         = kDefaultPollInterval;
     Url m_daemon;
     Url m_url;
@@ -28,6 +28,7 @@
 #include "base/net/stratum/Pools.h"
 #include "base/net/stratum/strategies/FailoverStrategy.h"
 #include "base/net/stratum/strategies/SinglePoolStrategy.h"
+#include "base/net/stratum/strategies/WeightedStrategy.h"
 #include "donate.h"
 #include "rapidjson/document.h"
 
@@ -36,6 +37,7 @@ xmrig::Pools::Pools() :
     m_donateLevel(kDefaultDonateLevel),
     m_retries(5),
     m_retryPause(5),
+    m_standby(0),
     m_proxyDonate(PROXY_DONATE_AUTO)
 {
 #   ifdef XMRIG_PROXY_PROJECT
@@ -47,7 +49,7 @@ xmrig::Pools::Pools() :
 
 bool xmrig::Pools::isEqual(const Pools &other) const
 {
-    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause) {
+    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause || m_standby != other.m_standby) {
         return false;
     }
 
@@ -65,7 +67,18 @@ xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) cons
         }
     }
 
-    auto strategy = new FailoverStrategy(retryPause(), retries(), listener);
+    if (weighted() > 1) {
+        auto strategy = new WeightedStrategy(retryPause(), retries(), listener);
+        for (const Pool &pool : m_data) {
+            if (pool.isEnabled()) {
+                strategy->add(pool);
+            }
+        }
+
+        return strategy;
+    }
+
+    auto strategy = new FailoverStrategy(retryPause(), retries(), listener, false, standby());
     for (const Pool &pool : m_data) {
         if (pool.isEnabled()) {
             strategy->add(pool);
@@ -104,6 +117,19 @@ size_t xmrig::Pools::active() const
 }
 
 
+size_t xmrig::Pools::weighted() const
+{
+    size_t count = 0;
+    for (const Pool &pool : m_data) {
+        if (pool.isEnabled() && pool.weight() > 0) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
 void xmrig::Pools::load(const IJsonReader &reader)
 {
     m_data.clear();
@@ -128,6 +154,7 @@ void xmrig::Pools::load(const IJsonReader &reader)
     setProxyDonate(reader.getInt("donate-over-proxy", PROXY_DONATE_AUTO));
     setRetries(reader.getInt("retries"));
     setRetryPause(reader.getInt("retry-pause"));
+    setStandby(reader.getInt("standby-pools"));
 }
 
 
@@ -183,3 +210,11 @@ void xmrig::Pools::setRetryPause(int retryPause)
         m_retryPause = retryPause;
     }
 }
+
+
+void xmrig::Pools::setStandby(int standby)
+{
+    if (standby >= 0 && standby <= 16) {
+        m_standby = standby;
+    }
+}
@@ -55,6 +55,7 @@ public:
     inline int donateLevel() const                      { return m_donateLevel; }
     inline int retries() const                          { return m_retries; }
     inline int retryPause() const                       { return m_retryPause; }
+    inline int standby() const                          { return m_standby; }
     inline ProxyDonate proxyDonate() const              { return m_proxyDonate; }
 
     inline bool operator!=(const Pools &other) const    { return !isEqual(other); }
@@ -64,6 +65,7 @@ public:
     IStrategy *createStrategy(IStrategyListener *listener) const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     size_t active() const;
+    size_t weighted() const;
     void load(const IJsonReader &reader);
     void print() const;
 
@@ -72,10 +74,12 @@ private:
     void setProxyDonate(int value);
     void setRetries(int retries);
     void setRetryPause(int retryPause);
+    void setStandby(int standby);
 
     int m_donateLevel;
     int m_retries;
     int m_retryPause;
+    int m_standby;
     ProxyDonate m_proxyDonate;
     std::vector<Pool> m_data;
 };
@@ -29,7 +29,8 @@
 #include "base/io/json/Json.h"
 #include "base/io/json/JsonRequest.h"
 #include "base/io/log/Log.h"
-#include "base/net/http/HttpClient.h"
+#include "base/net/http/HttpData.h"
+#include "base/net/http/HttpPool.h"
 #include "base/net/stratum/Client.h"
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
@@ -37,11 +38,6 @@
 #include "rapidjson/writer.h"
 
 
-#ifdef XMRIG_FEATURE_TLS
-#   include "base/net/http/HttpsClient.h"
-#endif
-
-
 namespace xmrig {
 
 static const char *kBlob                = "blob";
@@ -69,6 +65,8 @@ xmrig::SelfSelectClient::SelfSelectClient(int id, const char *agent, IClientList
 
 xmrig::SelfSelectClient::~SelfSelectClient()
 {
+    HttpPool::cancel(this);
+
     delete m_client;
 }
 
@@ -178,19 +176,7 @@ void xmrig::SelfSelectClient::send(int method, const char *url, const char *data
               static_cast<int>(size),
               data);
 
-    HttpClient *client;
-#   ifdef XMRIG_FEATURE_TLS
-    if (pool().daemon().isTLS()) {
-        client = new HttpsClient(method, url, this, data, size, String());
-    }
-    else
-#   endif
-    {
-        client = new HttpClient(method, url, this, data, size);
-    }
-
-    client->setQuiet(isQuiet());
-    client->connect(pool().daemon().host(), pool().daemon().port());
+    HttpPool::send(pool().daemon().host(), pool().daemon().port(), pool().daemon().isTLS(), String(), isQuiet(), method, url, this, data, size);
 }
 
 
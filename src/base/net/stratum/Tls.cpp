@@ -25,12 +25,15 @@
 
 
 #include <assert.h>
+#include <map>
+#include <string>
 
 
 #include "base/io/log/Log.h"
 #include "base/net/stratum/Client.h"
 #include "base/net/stratum/Tls.h"
 #include "base/tools/Buffer.h"
+#include "base/tools/Object.h"
 
 
 #ifdef _MSC_VER
@@ -38,6 +41,101 @@
 #endif
 
 
+namespace xmrig {
+
+
+class TlsSessions
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(TlsSessions)
+
+    TlsSessions()
+    {
+        m_ctx = SSL_CTX_new(SSLv23_method());
+        assert(m_ctx != nullptr);
+
+        if (!m_ctx) {
+            return;
+        }
+
+        SSL_CTX_set_options(m_ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+        SSL_CTX_set_session_cache_mode(m_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(m_ctx, onNewSession);
+    }
+
+
+    ~TlsSessions()
+    {
+        for (auto &kv : m_sessions) {
+            SSL_SESSION_free(kv.second);
+        }
+
+        if (m_ctx) {
+            SSL_CTX_free(m_ctx);
+        }
+    }
+
+
+    inline SSL_CTX *ctx() const { return m_ctx; }
+
+
+    SSL_SESSION *get(const std::string &key) const
+    {
+        const auto it = m_sessions.find(key);
+
+        return (it != m_sessions.end() && SSL_SESSION_is_resumable(it->second)) ? it->second : nullptr;
+    }
+
+
+    void remove(const std::string &key)
+    {
+        const auto it = m_sessions.find(key);
+        if (it != m_sessions.end()) {
+            SSL_SESSION_free(it->second);
+            m_sessions.erase(it);
+        }
+    }
+
+
+    void set(const std::string &key, SSL_SESSION *session)
+    {
+        remove(key);
+        m_sessions.insert({ key, session });
+    }
+
+
+private:
+    static int onNewSession(SSL *ssl, SSL_SESSION *session);
+
+    SSL_CTX *m_ctx = nullptr;
+    std::map<std::string, SSL_SESSION *> m_sessions;
+};
+
+
+static TlsSessions &sessions()
+{
+    static TlsSessions instance;
+
+    return instance;
+}
+
+
+int TlsSessions::onNewSession(SSL *ssl, SSL_SESSION *session)
+{
+    auto key = static_cast<const std::string *>(SSL_get_app_data(ssl));
+    if (!key || !SSL_SESSION_is_resumable(session)) {
+        return 0;
+    }
+
+    sessions().set(*key, session);
+
+    return 1;
+}
+
+
+} // namespace xmrig
+
+
 xmrig::Client::Tls::Tls(Client *client) :
     m_ready(false),
     m_buf(),
@@ -45,42 +143,56 @@ xmrig::Client::Tls::Tls(Client *client) :
     m_client(client),
     m_ssl(nullptr)
 {
-    m_ctx = SSL_CTX_new(SSLv23_method());
-    assert(m_ctx != nullptr);
-
-    if (!m_ctx) {
-        return;
-    }
+    m_key = std::string(client->m_pool.host().data()) + ":" + std::to_string(client->m_pool.port());
 
     m_writeBio = BIO_new(BIO_s_mem());
     m_readBio  = BIO_new(BIO_s_mem());
-    SSL_CTX_set_options(m_ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
 }
 
 
 xmrig::Client::Tls::~Tls()
 {
-    if (m_ctx) {
-        SSL_CTX_free(m_ctx);
-    }
-
     if (m_ssl) {
+        // OpenSSL invalidates sessions of connections freed without shutdown, pools usually just drop the socket.
+        if (m_ready) {
+            SSL_set_shutdown(m_ssl, SSL_SENT_SHUTDOWN);
+        }
+        else if (SSL_session_reused(m_ssl)) {
+            sessions().remove(m_key);
+        }
+
         SSL_free(m_ssl);
     }
+    else {
+        BIO_free(m_readBio);
+        BIO_free(m_writeBio);
+    }
 }
 
 
 bool xmrig::Client::Tls::handshake()
 {
-    m_ssl = SSL_new(m_ctx);
+    SSL_CTX *ctx = sessions().ctx();
+    if (!ctx) {
+        return false;
+    }
+
+    m_ssl = SSL_new(ctx);
     assert(m_ssl != nullptr);
 
     if (!m_ssl) {
         return false;
     }
 
+    SSL_set_app_data(m_ssl, &m_key);
     SSL_set_connect_state(m_ssl);
     SSL_set_bio(m_ssl, m_readBio, m_writeBio);
+
+    SSL_SESSION *session = sessions().get(m_key);
+    if (session) {
+        SSL_set_session(m_ssl, session);
+    }
+
     SSL_do_handshake(m_ssl);
 
     return send();
@@ -120,6 +232,7 @@ void xmrig::Client::Tls::read(const char *data, size_t size)
             X509 *cert = SSL_get_peer_certificate(m_ssl);
             if (!verify(cert)) {
                 X509_free(cert);
+                sessions().remove(m_key);
                 m_client->close();
 
                 return;
@@ -127,6 +240,11 @@ void xmrig::Client::Tls::read(const char *data, size_t size)
 
             X509_free(cert);
             m_ready = true;
+
+            if (SSL_session_reused(m_ssl)) {
+                LOG_DEBUG("[%s] TLS session resumed", m_client->url());
+            }
+
             m_client->login();
       }
 
@@ -27,6 +27,7 @@
 
 
 #include <openssl/ssl.h>
+#include <string>
 
 
 #include "base/net/stratum/Client.h"
@@ -59,7 +60,7 @@ private:
     char m_fingerprint[32 * 2 + 8];
     Client *m_client;
     SSL *m_ssl;
-    SSL_CTX *m_ctx;
+    std::string m_key;
 };
 
 
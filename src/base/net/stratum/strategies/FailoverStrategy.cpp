@@ -27,12 +27,26 @@
 #include "base/kernel/interfaces/IClient.h"
 #include "base/kernel/interfaces/IStrategyListener.h"
 #include "base/kernel/Platform.h"
+#include "base/net/dns/Dns.h"
+#include "base/net/stratum/Job.h"
+#include "base/net/stratum/SubmitResult.h"
 
 
-xmrig::FailoverStrategy::FailoverStrategy(const std::vector<Pool> &pools, int retryPause, int retries, IStrategyListener *listener, bool quiet) :
+namespace xmrig {
+
+
+static const uint64_t kMaxLatency = 10000;
+static const uint64_t kMinResults = 10;
+
+
+} // namespace xmrig
+
+
+xmrig::FailoverStrategy::FailoverStrategy(const std::vector<Pool> &pools, int retryPause, int retries, IStrategyListener *listener, bool quiet, int standby) :
     m_quiet(quiet),
     m_retries(retries),
     m_retryPause(retryPause),
+    m_standby(standby),
     m_active(-1),
     m_listener(listener),
     m_index(0)
@@ -43,10 +57,11 @@ xmrig::FailoverStrategy::FailoverStrategy(const std::vector<Pool> &pools, int re
 }
 
 
-xmrig::FailoverStrategy::FailoverStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet) :
+xmrig::FailoverStrategy::FailoverStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet, int standby) :
     m_quiet(quiet),
     m_retries(retries),
     m_retryPause(retryPause),
+    m_standby(standby),
     m_active(-1),
     m_listener(listener),
     m_index(0)
@@ -71,6 +86,7 @@ void xmrig::FailoverStrategy::add(const Pool &pool)
     client->setQuiet(m_quiet);
 
     m_pools.push_back(client);
+    m_states.emplace_back();
 }
 
 
@@ -86,7 +102,13 @@ int64_t xmrig::FailoverStrategy::submit(const JobResult &result)
 
 void xmrig::FailoverStrategy::connect()
 {
-    m_pools[m_index]->connect();
+    // Backup pools are resolved in advance, so switching to them does not wait for DNS.
+    for (size_t i = m_index + 1; i < m_pools.size(); ++i) {
+        Dns::prefetch(m_pools[i]->pool().host());
+    }
+
+    connect(m_index);
+    update();
 }
 
 
@@ -114,6 +136,11 @@ void xmrig::FailoverStrategy::stop()
         pool->disconnect();
     }
 
+    for (auto &state : m_states) {
+        state.connected = false;
+        state.ready     = false;
+    }
+
     m_index  = 0;
     m_active = -1;
 
@@ -135,8 +162,25 @@ void xmrig::FailoverStrategy::onClose(IClient *client, int failures)
         return;
     }
 
+    m_states[static_cast<size_t>(client->id())].ready = false;
+
     if (m_active == client->id()) {
         m_active = -1;
+
+        const int index = standby();
+        if (index >= 0) {
+            IClient *next = m_pools[static_cast<size_t>(index)];
+
+            setActive(next);
+            update();
+
+            if (next->job().isValid()) {
+                m_listener->onJob(this, next, next->job());
+            }
+
+            return;
+        }
+
         m_listener->onPause(this);
     }
 
@@ -145,7 +189,8 @@ void xmrig::FailoverStrategy::onClose(IClient *client, int failures)
     }
 
     if (m_index == static_cast<size_t>(client->id()) && (m_pools.size() - m_index) > 1) {
-        m_pools[++m_index]->connect();
+        connect(++m_index);
+        update();
     }
 }
 
@@ -166,27 +211,28 @@ void xmrig::FailoverStrategy::onJobReceived(IClient *client, const Job &job, con
 
 void xmrig::FailoverStrategy::onLoginSuccess(IClient *client)
 {
-    int active = m_active;
+    m_states[static_cast<size_t>(client->id())].ready = true;
 
-    if (client->id() == 0 || !isActive()) {
-        active = client->id();
+    if ((client->id() == 0 || !isActive()) && client->id() != m_active) {
+        setActive(client);
     }
 
-    for (size_t i = 1; i < m_pools.size(); ++i) {
-        if (active != static_cast<int>(i)) {
-            m_pools[i]->disconnect();
-        }
-    }
-
-    if (active >= 0 && active != m_active) {
-        m_index = m_active = active;
-        m_listener->onActive(this, client);
-    }
+    update();
 }
 
 
 void xmrig::FailoverStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
 {
+    State &state = m_states[static_cast<size_t>(client->id())];
+    state.latency = state.accepted + state.rejected ? (state.latency * 7 + result.elapsed) / 8 : result.elapsed;
+
+    if (error) {
+        state.rejected++;
+    }
+    else {
+        state.accepted++;
+    }
+
     m_listener->onResultAccepted(this, client, result, error);
 }
 
@@ -195,3 +241,91 @@ void xmrig::FailoverStrategy::onVerifyAlgorithm(const IClient *client, const Alg
 {
     m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
 }
+
+
+bool xmrig::FailoverStrategy::isHealthy(size_t index) const
+{
+    const State &state  = m_states[index];
+    const uint64_t count = state.accepted + state.rejected;
+
+    return !(count >= kMinResults && state.rejected * 2 > count) && !(count && state.latency > kMaxLatency);
+}
+
+
+/**
+ * Returns the logged in backup pool to switch to, pools with high reject rate or latency are used only if there is no other choice.
+ */
+int xmrig::FailoverStrategy::standby() const
+{
+    if (m_standby == 0) {
+        return -1;
+    }
+
+    int index = -1;
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (!m_states[i].ready) {
+            continue;
+        }
+
+        if (isHealthy(i)) {
+            return static_cast<int>(i);
+        }
+
+        if (index == -1) {
+            index = static_cast<int>(i);
+        }
+    }
+
+    return index;
+}
+
+
+void xmrig::FailoverStrategy::connect(size_t index)
+{
+    if (m_states[index].connected) {
+        return;
+    }
+
+    m_states[index].connected = true;
+    m_pools[index]->connect();
+}
+
+
+void xmrig::FailoverStrategy::disconnect(size_t index)
+{
+    if (!m_states[index].connected) {
+        return;
+    }
+
+    m_states[index].connected = false;
+    m_states[index].ready     = false;
+    m_pools[index]->disconnect();
+}
+
+
+void xmrig::FailoverStrategy::setActive(IClient *client)
+{
+    m_index = m_active = client->id();
+    m_listener->onActive(this, client);
+}
+
+
+/**
+ * Keeps the active (or currently tried) pool and the next "standby-pools" pools connected and logged in, so switching to them
+ * on failure does not need DNS lookup, TCP/TLS handshake and login. The first pool is never disconnected and keeps retrying.
+ */
+void xmrig::FailoverStrategy::update()
+{
+    const size_t first = isActive() ? static_cast<size_t>(m_active) : m_index;
+    const size_t last  = first + static_cast<size_t>(m_standby);
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (i >= first && i <= last) {
+            connect(i);
+        }
+        else if (isActive() && i > 0) {
+            disconnect(i);
+        }
+    }
+}
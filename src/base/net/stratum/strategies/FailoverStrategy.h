@@ -47,8 +47,8 @@ class FailoverStrategy : public IStrategy, public IClientListener
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(FailoverStrategy)
 
-    FailoverStrategy(const std::vector<Pool> &pool, int retryPause, int retries, IStrategyListener *listener, bool quiet = false);
-    FailoverStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet = false);
+    FailoverStrategy(const std::vector<Pool> &pool, int retryPause, int retries, IStrategyListener *listener, bool quiet = false, int standby = 0);
+    FailoverStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet = false, int standby = 0);
     ~FailoverStrategy() override;
 
     void add(const Pool &pool);
@@ -72,15 +72,33 @@ protected:
     void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok) override;
 
 private:
+    struct State
+    {
+        bool connected      = false;
+        bool ready          = false;
+        uint64_t accepted   = 0;
+        uint64_t latency    = 0;
+        uint64_t rejected   = 0;
+    };
+
     inline IClient *active() const { return m_pools[static_cast<size_t>(m_active)]; }
 
+    bool isHealthy(size_t index) const;
+    int standby() const;
+    void connect(size_t index);
+    void disconnect(size_t index);
+    void setActive(IClient *client);
+    void update();
+
     const bool m_quiet;
     const int m_retries;
     const int m_retryPause;
+    const int m_standby;
     int m_active;
     IStrategyListener *m_listener;
     size_t m_index;
     std::vector<IClient*> m_pools;
+    std::vector<State> m_states;
 };
 
 
@@ -0,0 +1,329 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "base/net/stratum/strategies/WeightedStrategy.h"
+#include "base/kernel/interfaces/IClient.h"
+#include "base/kernel/interfaces/IStrategyListener.h"
+#include "base/net/stratum/Job.h"
+#include "base/net/stratum/SubmitResult.h"
+#include "base/tools/Chrono.h"
+#include "net/JobResult.h"
+
+
+namespace xmrig {
+
+
+static const uint64_t kLatencyScale = 1000;
+static const uint64_t kSliceTime    = 60000;
+static const uint64_t kWindow       = 3600000;
+
+
+} // namespace xmrig
+
+
+xmrig::WeightedStrategy::WeightedStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet) :
+    m_quiet(quiet),
+    m_retries(retries),
+    m_retryPause(retryPause),
+    m_listener(listener)
+{
+}
+
+
+xmrig::WeightedStrategy::~WeightedStrategy()
+{
+    for (IClient *client : m_pools) {
+        client->deleteLater();
+    }
+}
+
+
+void xmrig::WeightedStrategy::add(const Pool &pool)
+{
+    IClient *client = pool.createClient(static_cast<int>(m_pools.size()), this);
+
+    client->setRetries(m_retries);
+    client->setRetryPause(m_retryPause * 1000);
+    client->setQuiet(m_quiet);
+
+    m_pools.push_back(client);
+    m_states.emplace_back();
+}
+
+
+int64_t xmrig::WeightedStrategy::submit(const JobResult &result)
+{
+    // Results of the previous time slice are still valid, send them to the pool the job came from.
+    for (IClient *client : m_pools) {
+        const Job &job = client->job();
+
+        if (job.id() == result.jobId && job.clientId() == result.clientId) {
+            return client->submit(result);
+        }
+    }
+
+    if (!isActive()) {
+        return -1;
+    }
+
+    return active()->submit(result);
+}
+
+
+void xmrig::WeightedStrategy::connect()
+{
+    for (IClient *client : m_pools) {
+        client->connect();
+    }
+}
+
+
+void xmrig::WeightedStrategy::resume()
+{
+    if (!isActive()) {
+        return;
+    }
+
+    m_listener->onJob(this, active(), active()->job());
+}
+
+
+void xmrig::WeightedStrategy::setAlgo(const Algorithm &algo)
+{
+    for (IClient *client : m_pools) {
+        client->setAlgo(algo);
+    }
+}
+
+
+void xmrig::WeightedStrategy::stop()
+{
+    for (IClient *client : m_pools) {
+        client->disconnect();
+    }
+
+    for (State &state : m_states) {
+        state.ready = false;
+    }
+
+    m_active = -1;
+
+    m_listener->onPause(this);
+}
+
+
+void xmrig::WeightedStrategy::tick(uint64_t now)
+{
+    for (IClient *client : m_pools) {
+        client->tick(now);
+    }
+
+    if (!isActive()) {
+        return;
+    }
+
+    update(now);
+
+    if (now - m_started < kSliceTime) {
+        return;
+    }
+
+    const int index = next();
+    if (index >= 0 && index != m_active) {
+        setActive(m_pools[static_cast<size_t>(index)], true);
+    }
+}
+
+
+void xmrig::WeightedStrategy::onClose(IClient *client, int failures)
+{
+    if (failures == -1) {
+        return;
+    }
+
+    m_states[static_cast<size_t>(client->id())].ready = false;
+
+    if (m_active != client->id()) {
+        return;
+    }
+
+    update(Chrono::steadyMSecs());
+    m_active = -1;
+
+    const int index = next();
+    if (index >= 0) {
+        return setActive(m_pools[static_cast<size_t>(index)], true);
+    }
+
+    m_listener->onPause(this);
+}
+
+
+void xmrig::WeightedStrategy::onJobReceived(IClient *client, const Job &job, const rapidjson::Value &)
+{
+    if (m_active == client->id()) {
+        m_listener->onJob(this, client, job);
+    }
+}
+
+
+void xmrig::WeightedStrategy::onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params)
+{
+    m_listener->onLogin(this, client, doc, params);
+}
+
+
+void xmrig::WeightedStrategy::onLoginSuccess(IClient *client)
+{
+    m_states[static_cast<size_t>(client->id())].ready = true;
+
+    if (!isActive()) {
+        setActive(client, false);
+    }
+}
+
+
+void xmrig::WeightedStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
+{
+    State &state  = m_states[static_cast<size_t>(client->id())];
+    state.latency = state.results ? (state.latency * 7 + result.elapsed) / 8 : result.elapsed;
+    state.results++;
+
+    if (error) {
+        state.rejected += result.diff;
+    }
+    else {
+        state.accepted += result.diff;
+    }
+
+    m_listener->onResultAccepted(this, client, result, error);
+}
+
+
+void xmrig::WeightedStrategy::onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok)
+{
+    m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
+}
+
+
+/**
+ * Effective pool weight: configured weight scaled by the accepted part of submitted difficulty and by average share latency.
+ */
+double xmrig::WeightedStrategy::weight(size_t index) const
+{
+    const State &state = m_states[index];
+    if (!state.ready) {
+        return 0.0;
+    }
+
+    const double accepted = static_cast<double>(state.accepted + 1) / static_cast<double>(state.accepted + state.rejected + 1);
+    const double latency  = static_cast<double>(kLatencyScale) / static_cast<double>(kLatencyScale + state.latency);
+
+    return m_pools[index]->pool().weight() * accepted * latency;
+}
+
+
+/**
+ * Returns the pool which received the smallest part of mining time relative to its effective weight.
+ */
+int xmrig::WeightedStrategy::next() const
+{
+    double total  = 0.0;
+    uint64_t time = 0;
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        total += weight(i);
+
+        if (m_states[i].ready) {
+            time += m_states[i].time;
+        }
+    }
+
+    int index   = -1;
+    double best = 0.0;
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (!m_states[i].ready) {
+            continue;
+        }
+
+        if (total <= 0.0) {
+            return static_cast<int>(i);
+        }
+
+        const double value = weight(i);
+        if (value <= 0.0) {
+            continue;
+        }
+
+        const double deficit = value / total - (time ? static_cast<double>(m_states[i].time) / time : 0.0);
+        if (index == -1 || deficit > best) {
+            index = static_cast<int>(i);
+            best  = deficit;
+        }
+    }
+
+    return index;
+}
+
+
+void xmrig::WeightedStrategy::setActive(IClient *client, bool job)
+{
+    const uint64_t now = Chrono::steadyMSecs();
+
+    if (isActive()) {
+        update(now);
+    }
+
+    m_active    = client->id();
+    m_started   = now;
+    m_timestamp = now;
+
+    m_listener->onActive(this, client);
+
+    if (job && client->job().isValid()) {
+        m_listener->onJob(this, client, client->job());
+    }
+}
+
+
+void xmrig::WeightedStrategy::update(uint64_t now)
+{
+    m_states[static_cast<size_t>(m_active)].time += now - m_timestamp;
+    m_timestamp = now;
+
+    uint64_t time = 0;
+    for (const State &state : m_states) {
+        time += state.time;
+    }
+
+    // Older history is gradually forgotten, so weights adapt to recent pool behaviour.
+    if (time > kWindow) {
+        for (State &state : m_states) {
+            state.time /= 2;
+        }
+    }
+}
@@ -0,0 +1,231 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <algorithm>
+
+
+#include "base/net/tools/TcpConnector.h"
+#include "base/kernel/interfaces/ITcpConnectorListener.h"
+#include "base/tools/Handle.h"
+
+
+namespace xmrig {
+
+
+class TcpConnector::Attempt
+{
+public:
+    inline Attempt(TcpConnector *owner, size_t index) : owner(owner), index(index)
+    {
+        req.data = this;
+        tcp      = new uv_tcp_t;
+
+        uv_tcp_init(uv_default_loop(), tcp);
+    }
+
+    TcpConnector *owner;
+    size_t index;
+    bool cancelled = false;
+    uv_connect_t req{};
+    uv_tcp_t *tcp;
+};
+
+
+} // namespace xmrig
+
+
+xmrig::TcpConnector::TcpConnector(ITcpConnectorListener *listener) :
+    m_listener(listener)
+{
+    m_timer = new uv_timer_t;
+    m_timer->data = this;
+
+    uv_timer_init(uv_default_loop(), m_timer);
+}
+
+
+xmrig::TcpConnector::~TcpConnector()
+{
+    cancel();
+
+    Handle::close(m_timer);
+}
+
+
+/**
+ * Silently abort all connection attempts.
+ */
+void xmrig::TcpConnector::cancel()
+{
+    uv_timer_stop(m_timer);
+
+    for (Attempt *attempt : m_attempts) {
+        attempt->cancelled = true;
+        Handle::close(attempt->tcp);
+    }
+
+    m_attempts.clear();
+    m_records.clear();
+
+    m_next    = 0;
+    m_closing = false;
+}
+
+
+/**
+ * Abort all connection attempts, the listener receives UV_ECANCELED after pending attempts are closed.
+ */
+void xmrig::TcpConnector::close()
+{
+    if (m_closing || m_attempts.empty()) {
+        return;
+    }
+
+    uv_timer_stop(m_timer);
+
+    m_closing = true;
+    m_status  = UV_ECANCELED;
+
+    for (Attempt *attempt : m_attempts) {
+        Handle::close(attempt->tcp);
+    }
+}
+
+
+void xmrig::TcpConnector::connect(const std::vector<DnsRecord> &records, uint16_t port)
+{
+    cancel();
+
+    m_records = records;
+    m_port    = port;
+    m_status  = UV_EAI_NONAME;
+
+    next();
+}
+
+
+void xmrig::TcpConnector::finish(int status)
+{
+    uv_timer_stop(m_timer);
+
+    m_records.clear();
+    m_next    = 0;
+    m_closing = false;
+
+    m_listener->onConnected(nullptr, DnsRecord(), status);
+}
+
+
+void xmrig::TcpConnector::next()
+{
+    while (m_next < m_records.size()) {
+        const size_t index = m_next++;
+        sockaddr *addr     = m_records[index].addr(m_port);
+
+        if (!addr) {
+            continue;
+        }
+
+        auto attempt = new Attempt(this, index);
+        const int rc = uv_tcp_connect(&attempt->req, attempt->tcp, addr, TcpConnector::onConnect);
+
+        delete addr;
+
+        if (rc < 0) {
+            m_status = rc;
+            Handle::close(attempt->tcp);
+            delete attempt;
+
+            continue;
+        }
+
+        m_attempts.push_back(attempt);
+        break;
+    }
+
+    if (m_attempts.empty()) {
+        return finish(m_status);
+    }
+
+    if (m_next < m_records.size()) {
+        uv_timer_start(m_timer, TcpConnector::onTimer, kAttemptDelay, 0);
+    }
+}
+
+
+void xmrig::TcpConnector::onConnect(Attempt *attempt, int status)
+{
+    m_attempts.erase(std::remove(m_attempts.begin(), m_attempts.end(), attempt), m_attempts.end());
+
+    if (m_closing || status < 0) {
+        if (!m_closing) {
+            m_status = status;
+            Handle::close(attempt->tcp);
+        }
+
+        delete attempt;
+
+        // A failed attempt starts the next one immediately, there is no need to wait for the attempt delay.
+        if (!m_closing && m_next < m_records.size()) {
+            uv_timer_stop(m_timer);
+
+            return next();
+        }
+
+        if (m_attempts.empty()) {
+            finish(m_status);
+        }
+
+        return;
+    }
+
+    uv_tcp_t *tcp          = attempt->tcp;
+    const DnsRecord record = m_records[attempt->index];
+
+    delete attempt;
+    cancel();
+
+    m_listener->onConnected(tcp, record, 0);
+}
+
+
+void xmrig::TcpConnector::onConnect(uv_connect_t *req, int status)
+{
+    auto attempt = static_cast<Attempt *>(req->data);
+    if (attempt->cancelled) {
+        delete attempt;
+
+        return;
+    }
+
+    attempt->owner->onConnect(attempt, status);
+}
+
+
+void xmrig::TcpConnector::onTimer(uv_timer_t *handle)
+{
+    static_cast<TcpConnector *>(handle->data)->next();
+}
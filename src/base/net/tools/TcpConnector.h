@@ -0,0 +1,88 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_TCPCONNECTOR_H
+#define XMRIG_TCPCONNECTOR_H
+
+
+#include <uv.h>
+#include <vector>
+
+
+#include "base/net/dns/DnsRecord.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class ITcpConnectorListener;
+
+
+/**
+ * Happy Eyeballs (RFC 8305) TCP connection: attempts to all resolved addresses are started one after another
+ * with a short delay without waiting for the previous attempt to fail, the first established connection wins.
+ */
+class TcpConnector
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(TcpConnector)
+
+    constexpr static uint64_t kAttemptDelay = 250;
+
+    TcpConnector(ITcpConnectorListener *listener);
+    ~TcpConnector();
+
+    inline bool isActive() const { return !m_attempts.empty(); }
+
+    void cancel();
+    void close();
+    void connect(const std::vector<DnsRecord> &records, uint16_t port);
+
+private:
+    class Attempt;
+
+    void finish(int status);
+    void next();
+    void onConnect(Attempt *attempt, int status);
+
+    static void onConnect(uv_connect_t *req, int status);
+    static void onTimer(uv_timer_t *handle);
+
+    bool m_closing      = false;
+    int m_status        = 0;
+    ITcpConnectorListener *m_listener;
+    size_t m_next       = 0;
+    std::vector<Attempt *> m_attempts;
+    std::vector<DnsRecord> m_records;
+    uint16_t m_port     = 0;
+    uv_timer_t *m_timer;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_TCPCONNECTOR_H */
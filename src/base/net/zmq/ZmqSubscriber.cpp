@@ -0,0 +1,431 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cctype>
+#include <cstring>
+
+
+#include "base/net/zmq/ZmqSubscriber.h"
+#include "base/kernel/interfaces/IZmqListener.h"
+#include "base/net/dns/Dns.h"
+#include "base/tools/Baton.h"
+
+
+namespace xmrig {
+
+
+static const char *kMechanism       = "NULL";
+static const char *kReady           = "READY";
+static const char *kSocketType      = "Socket-Type";
+static constexpr size_t kGreeting   = 64;
+
+
+enum FrameFlags : uint8_t {
+    FLAG_MORE    = 0x01,
+    FLAG_LONG    = 0x02,
+    FLAG_COMMAND = 0x04
+};
+
+
+class ZmqWriteBaton : public Baton<uv_write_t>
+{
+public:
+    inline ZmqWriteBaton(std::string &&data) :
+        m_data(std::move(data))
+    {
+        buf = uv_buf_init(const_cast<char *>(m_data.data()), static_cast<unsigned int>(m_data.size()));
+    }
+
+    inline static void onWrite(uv_write_t *req, int) { delete reinterpret_cast<ZmqWriteBaton *>(req->data); }
+
+    uv_buf_t buf{};
+
+private:
+    std::string m_data;
+};
+
+
+static std::string zmqFrame(uint8_t flags, const std::string &body)
+{
+    std::string out;
+    const uint64_t size = body.size();
+
+    if (size > 255) {
+        out.push_back(static_cast<char>(flags | FLAG_LONG));
+
+        for (int i = 7; i >= 0; --i) {
+            out.push_back(static_cast<char>((size >> (i * 8)) & 0xFF));
+        }
+    }
+    else {
+        out.push_back(static_cast<char>(flags));
+        out.push_back(static_cast<char>(size));
+    }
+
+    return out + body;
+}
+
+
+static inline uint64_t readBE(const uint8_t *data, size_t size)
+{
+    uint64_t out = 0;
+    for (size_t i = 0; i < size; ++i) {
+        out = (out << 8) | data[i];
+    }
+
+    return out;
+}
+
+
+static inline bool isEqualName(const uint8_t *data, size_t size, const char *name)
+{
+    if (strlen(name) != size) {
+        return false;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        if (tolower(data[i]) != tolower(static_cast<uint8_t>(name[i]))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::ZmqSubscriber::ZmqSubscriber(IZmqListener *listener, const char *topic) :
+    m_listener(listener),
+    m_topic(topic)
+{
+    m_dns = new Dns(this);
+}
+
+
+xmrig::ZmqSubscriber::~ZmqSubscriber()
+{
+    close();
+
+    delete m_dns;
+}
+
+
+bool xmrig::ZmqSubscriber::connect(const String &host, uint16_t port)
+{
+    if (m_state != UnconnectedState) {
+        return false;
+    }
+
+    m_host  = host;
+    m_port  = port;
+    m_state = ConnectingState;
+
+    if (!m_dns->resolve(host)) {
+        m_state = UnconnectedState;
+
+        return false;
+    }
+
+    return true;
+}
+
+
+void xmrig::ZmqSubscriber::close()
+{
+    close(0);
+}
+
+
+void xmrig::ZmqSubscriber::onResolved(const Dns &dns, int status)
+{
+    if (m_state != ConnectingState) {
+        return;
+    }
+
+    if (status < 0 && dns.isEmpty()) {
+        return close(status);
+    }
+
+    m_tcp = new uv_tcp_t;
+    uv_tcp_init(uv_default_loop(), m_tcp);
+    uv_tcp_nodelay(m_tcp, 1);
+
+#   ifndef WIN32
+    uv_tcp_keepalive(m_tcp, 1, 60);
+#   endif
+
+    m_tcp->data = this;
+
+    auto req = new uv_connect_t;
+    const int rc = uv_tcp_connect(req, m_tcp, dns.get().addr(m_port), onConnect);
+    if (rc < 0) {
+        delete req;
+        close(rc);
+    }
+}
+
+
+bool xmrig::ZmqSubscriber::parse()
+{
+    size_t pos = 0;
+
+    if (m_state == GreetingState) {
+        if (m_buf.size() < kGreeting) {
+            return true;
+        }
+
+        if (!parseGreeting()) {
+            return false;
+        }
+
+        pos     = kGreeting;
+        m_state = HandshakeState;
+
+        std::string ready;
+        ready.push_back(static_cast<char>(strlen(kReady)));
+        ready.append(kReady);
+        ready.push_back(static_cast<char>(strlen(kSocketType)));
+        ready.append(kSocketType);
+        ready.append({ 0, 0, 0, 3 });
+        ready.append("SUB");
+
+        write(zmqFrame(FLAG_COMMAND, ready));
+    }
+
+    while (m_buf.size() - pos >= 2) {
+        const uint8_t flags  = m_buf[pos];
+        const size_t header  = (flags & FLAG_LONG) ? 9 : 2;
+        const size_t avail   = m_buf.size() - pos;
+
+        if (flags & ~(FLAG_MORE | FLAG_LONG | FLAG_COMMAND)) {
+            return false;
+        }
+
+        if (avail < header) {
+            break;
+        }
+
+        const uint64_t size = (flags & FLAG_LONG) ? readBE(m_buf.data() + pos + 1, 8) : m_buf[pos + 1];
+        if (size > kMaxMessageSize) {
+            return false;
+        }
+
+        if (avail < header + size) {
+            break;
+        }
+
+        const uint8_t *body = m_buf.data() + pos + header;
+        pos += header + size;
+
+        if (flags & FLAG_COMMAND) {
+            if (!parseCommand(body, size)) {
+                return false;
+            }
+        }
+        else {
+            if (m_state != ReadyState || m_message.size() + size > kMaxMessageSize) {
+                return false;
+            }
+
+            m_message.append(reinterpret_cast<const char *>(body), size);
+
+            if ((flags & FLAG_MORE) == 0) {
+                const std::string message = std::move(m_message);
+                m_message.clear();
+
+                m_listener->onZmqMessage(*this, message.data(), message.size());
+            }
+        }
+
+        if (m_state == UnconnectedState) {
+            return true;
+        }
+    }
+
+    m_buf.erase(m_buf.begin(), m_buf.begin() + static_cast<ptrdiff_t>(pos));
+
+    return true;
+}
+
+
+bool xmrig::ZmqSubscriber::parseCommand(const uint8_t *data, size_t size)
+{
+    if (size == 0 || data[0] + 1u > size) {
+        return false;
+    }
+
+    const uint8_t *name    = data + 1;
+    const size_t nameSize  = data[0];
+
+    if (isEqualName(name, nameSize, "ERROR")) {
+        return false;
+    }
+
+    if (!isEqualName(name, nameSize, kReady)) {
+        return true;
+    }
+
+    if (m_state != HandshakeState) {
+        return false;
+    }
+
+    size_t pos = 1 + nameSize;
+    while (pos < size) {
+        const size_t keySize = data[pos];
+        if (pos + 1 + keySize + 4 > size) {
+            return false;
+        }
+
+        const uint8_t *key     = data + pos + 1;
+        const uint64_t valSize = readBE(key + keySize, 4);
+        const uint8_t *value   = key + keySize + 4;
+
+        pos += 1 + keySize + 4 + valSize;
+        if (pos > size) {
+            return false;
+        }
+
+        if (isEqualName(key, keySize, kSocketType) && !isEqualName(value, valSize, "PUB") && !isEqualName(value, valSize, "XPUB")) {
+            return false;
+        }
+    }
+
+    m_state = ReadyState;
+
+    write(zmqFrame(0, std::string(1, '\x01') + m_topic.data()));
+
+    m_listener->onZmqReady(*this);
+
+    return true;
+}
+
+
+bool xmrig::ZmqSubscriber::parseGreeting()
+{
+    const uint8_t *greeting = m_buf.data();
+
+    return greeting[0] == 0xFF
+        && (greeting[9] & 0x01)
+        && greeting[10] >= 3
+        && memcmp(greeting + 12, kMechanism, strlen(kMechanism) + 1) == 0;
+}
+
+
+void xmrig::ZmqSubscriber::close(int status)
+{
+    const bool notify = status < 0 && m_state != UnconnectedState;
+
+    if (m_tcp) {
+        m_tcp->data = nullptr;
+
+        if (!uv_is_closing(reinterpret_cast<uv_handle_t *>(m_tcp))) {
+            uv_close(reinterpret_cast<uv_handle_t *>(m_tcp), [](uv_handle_t *handle) { delete reinterpret_cast<uv_tcp_t *>(handle); });
+        }
+
+        m_tcp = nullptr;
+    }
+
+    m_state = UnconnectedState;
+    m_buf.clear();
+    m_message.clear();
+
+    if (notify) {
+        m_listener->onZmqClose(*this, status);
+    }
+}
+
+
+void xmrig::ZmqSubscriber::read(const char *data, size_t size)
+{
+    m_buf.insert(m_buf.end(), data, data + size);
+
+    if (!parse()) {
+        close(UV_EPROTO);
+    }
+}
+
+
+void xmrig::ZmqSubscriber::write(std::string &&data)
+{
+    auto baton = new ZmqWriteBaton(std::move(data));
+    uv_write(&baton->req, reinterpret_cast<uv_stream_t *>(m_tcp), &baton->buf, 1, ZmqWriteBaton::onWrite);
+}
+
+
+void xmrig::ZmqSubscriber::onConnect(uv_connect_t *req, int status)
+{
+    auto zmq = static_cast<ZmqSubscriber *>(req->handle->data);
+    delete req;
+
+    if (!zmq) {
+        return;
+    }
+
+    if (status < 0) {
+        return zmq->close(status);
+    }
+
+    zmq->m_state = GreetingState;
+
+    uv_read_start(reinterpret_cast<uv_stream_t *>(zmq->m_tcp),
+        [](uv_handle_t *, size_t suggested_size, uv_buf_t *buf)
+        {
+            buf->base = new char[suggested_size];
+
+#           ifdef _WIN32
+            buf->len = static_cast<unsigned int>(suggested_size);
+#           else
+            buf->len = suggested_size;
+#           endif
+        },
+        onRead);
+
+    std::string greeting(kGreeting, '\0');
+    greeting[0]  = '\xFF';
+    greeting[9]  = '\x7F';
+    greeting[10] = 3;
+    memcpy(&greeting[12], kMechanism, strlen(kMechanism));
+
+    zmq->write(std::move(greeting));
+}
+
+
+void xmrig::ZmqSubscriber::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
+{
+    auto zmq = static_cast<ZmqSubscriber *>(stream->data);
+
+    if (zmq) {
+        if (nread >= 0) {
+            zmq->read(buf->base, static_cast<size_t>(nread));
+        }
+        else {
+            zmq->close(static_cast<int>(nread));
+        }
+    }
+
+    delete [] buf->base;
+}
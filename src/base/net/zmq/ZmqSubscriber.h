@@ -0,0 +1,106 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_ZMQSUBSCRIBER_H
+#define XMRIG_ZMQSUBSCRIBER_H
+
+
+#include <string>
+#include <uv.h>
+#include <vector>
+
+
+#include "base/kernel/interfaces/IDnsListener.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+class IZmqListener;
+
+
+/**
+ * Minimal ZeroMQ SUB socket, speaks ZMTP 3.0 with the NULL security mechanism
+ * over a plain TCP connection, enough to follow a daemon notification publisher
+ * without linking libzmq.
+ */
+class ZmqSubscriber : public IDnsListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ZmqSubscriber)
+
+    enum State {
+        UnconnectedState,
+        ConnectingState,
+        GreetingState,
+        HandshakeState,
+        ReadyState
+    };
+
+    constexpr static size_t kMaxMessageSize = 1024 * 1024;
+
+    ZmqSubscriber(IZmqListener *listener, const char *topic);
+    ~ZmqSubscriber() override;
+
+    inline bool isReady() const           { return m_state == ReadyState; }
+    inline const String &host() const     { return m_host; }
+    inline const String &topic() const    { return m_topic; }
+    inline State state() const            { return m_state; }
+    inline uint16_t port() const          { return m_port; }
+
+    bool connect(const String &host, uint16_t port);
+    void close();
+
+protected:
+    void onResolved(const Dns &dns, int status) override;
+
+private:
+    bool parse();
+    bool parseCommand(const uint8_t *data, size_t size);
+    bool parseGreeting();
+    void close(int status);
+    void read(const char *data, size_t size);
+    void write(std::string &&data);
+
+    static void onConnect(uv_connect_t *req, int status);
+    static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
+
+    Dns *m_dns;
+    IZmqListener *m_listener;
+    State m_state       = UnconnectedState;
+    std::string m_message;
+    std::vector<uint8_t> m_buf;
+    String m_host;
+    String m_topic;
+    uint16_t m_port     = 0;
+    uv_tcp_t *m_tcp     = nullptr;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_ZMQSUBSCRIBER_H */
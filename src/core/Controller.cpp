@@ -31,6 +31,17 @@
 #include "net/Network.h"
 
 
+#ifdef XMRIG_FEATURE_POOL_SIM
+#   include "net/sim/SimConfig.h"
+#   include "net/sim/SimPool.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_BENCHMARK
+#   include "core/bench/BenchConfig.h"
+#endif
+
+
 #include <cassert>
 
 
@@ -52,7 +63,7 @@ int xmrig::Controller::init()
 {
     Base::init();
 
-    VirtualMemory::init(config()->cpu().memPoolSize(), config()->cpu().isHugePages());
+    VirtualMemory::init(config()->cpu().memPoolSize(), config()->cpu().isHugePages(), config()->cpu().isStrictWX());
 
     m_network = new Network(this);
 
@@ -66,6 +77,29 @@ void xmrig::Controller::start()
 
     m_miner = new Miner(this);
 
+#   ifdef XMRIG_FEATURE_POOL_SIM
+    for (const auto &pool : config()->sims()) {
+        if (!pool.isEnabled()) {
+            continue;
+        }
+
+        auto sim = new SimPool(pool);
+        if (sim->start()) {
+            m_sims.push_back(sim);
+        }
+        else {
+            delete sim;
+        }
+    }
+#   endif
+
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    // Benchmark feeds its own jobs to the miner.
+    if (config()->benchmark().isEnabled()) {
+        return;
+    }
+#   endif
+
     network()->connect();
 }
 
@@ -77,6 +111,14 @@ void xmrig::Controller::stop()
     delete m_network;
     m_network = nullptr;
 
+#   ifdef XMRIG_FEATURE_POOL_SIM
+    for (auto sim : m_sims) {
+        delete sim;
+    }
+
+    m_sims.clear();
+#   endif
+
     m_miner->stop();
 
     delete m_miner;
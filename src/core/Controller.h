@@ -30,12 +30,16 @@
 #include "base/tools/Object.h"
 
 
+#include <vector>
+
+
 namespace xmrig {
 
 
 class Job;
 class Miner;
 class Network;
+class SimPool;
 
 
 class Controller : public Base
@@ -56,6 +60,10 @@ public:
 private:
     Miner *m_miner     = nullptr;
     Network *m_network = nullptr;
+
+#   ifdef XMRIG_FEATURE_POOL_SIM
+    std::vector<SimPool *> m_sims;
+#   endif
 };
 
 
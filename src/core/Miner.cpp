@@ -48,6 +48,7 @@
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/Api.h"
 #   include "base/api/interfaces/IApiRequest.h"
+#   include "base/api/Metrics.h"
 #endif
 
 
@@ -230,6 +231,157 @@ public:
             reply.PushBack(backend->toJSON(doc), allocator);
         }
     }
+
+
+    void updateMetrics() const
+    {
+        static const size_t intervals[]  = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+        static const char *intervalNames[] = { "10s", "60s", "15m" };
+
+        Metrics &metrics = controller->api()->metrics();
+        metrics.begin(Metrics::MinerSection);
+
+        char labels[128];
+        snprintf(labels, sizeof(labels), "version=\"%s\",kind=\"%s\",algo=\"%s\"", APP_VERSION, APP_KIND, algorithm.isValid() ? algorithm.shortName() : "");
+
+        metrics.family("xmrig_info", "gauge", "Miner version and current algorithm.");
+        metrics.add("xmrig_info", labels, uint64_t(1));
+
+        metrics.family("xmrig_paused", "gauge", "Mining is paused.");
+        metrics.add("xmrig_paused", nullptr, static_cast<uint64_t>(!enabled));
+
+        metrics.family("xmrig_hashrate", "gauge", "Hashrate per backend in H/s.");
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (!hr) {
+                continue;
+            }
+
+            for (size_t i = 0; i < 3; ++i) {
+                snprintf(labels, sizeof(labels), "backend=\"%s\",interval=\"%s\"", backend->type().data(), intervalNames[i]);
+                metrics.add("xmrig_hashrate", labels, hr->calc(intervals[i]));
+            }
+        }
+
+        metrics.family("xmrig_thread_hashrate", "gauge", "Hashrate per thread in H/s.");
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (!hr) {
+                continue;
+            }
+
+            for (size_t thread = 0; thread < hr->threads(); ++thread) {
+                for (size_t i = 0; i < 3; ++i) {
+                    snprintf(labels, sizeof(labels), "backend=\"%s\",thread=\"%zu\",interval=\"%s\"", backend->type().data(), thread, intervalNames[i]);
+                    metrics.add("xmrig_thread_hashrate", labels, hr->calc(thread, intervals[i]));
+                }
+            }
+        }
+
+        metrics.family("xmrig_hashrate_highest", "gauge", "Highest total hashrate for the current algorithm in H/s.");
+        metrics.add("xmrig_hashrate_highest", nullptr, maxHashrate[algorithm]);
+
+        for (IBackend *backend : backends) {
+            backend->toMetrics(metrics);
+        }
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        if (algorithm.family() == Algorithm::RANDOM_X) {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            metrics.family("xmrig_dataset_ready", "gauge", "RandomX dataset is initialized for the current job.");
+            metrics.add("xmrig_dataset_ready", nullptr, static_cast<uint64_t>(Rx::isReady(job)));
+        }
+#       endif
+
+        metrics.publish();
+    }
+
+
+    void sendState() const
+    {
+        using namespace rapidjson;
+
+        EventStream &events = controller->api()->events();
+        if (!events.isActive()) {
+            return;
+        }
+
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        doc.AddMember("paused", !enabled, allocator);
+        doc.AddMember("active", active, allocator);
+
+        events.send("state", doc);
+    }
+
+
+    void sendTick()
+    {
+        using namespace rapidjson;
+
+        EventStream &events = controller->api()->events();
+        if (!events.isActive()) {
+            return;
+        }
+
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        backendStates.resize(backends.size());
+
+        for (size_t i = 0; i < backends.size(); ++i) {
+            const IBackend *backend   = backends[i];
+            const bool enabled        = backend->isEnabled();
+            const String &profileName = backend->profileName();
+
+            if (backendStates[i].first == enabled && backendStates[i].second == profileName) {
+                continue;
+            }
+
+            backendStates[i] = { enabled, profileName };
+
+            Value state(kObjectType);
+            state.AddMember("type",    backend->type().toJSON(), allocator);
+            state.AddMember("enabled", enabled, allocator);
+            state.AddMember("profile", profileName.toJSON(), allocator);
+
+            events.send("backend", state);
+        }
+
+        Value total(kArrayType);
+        Value threads(kObjectType);
+        double t[3] = { 0.0 };
+
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (!hr) {
+                continue;
+            }
+
+            Value speed(kArrayType);
+            speed.PushBack(Hashrate::normalize(hr->calc(Hashrate::ShortInterval)),  allocator);
+            speed.PushBack(Hashrate::normalize(hr->calc(Hashrate::MediumInterval)), allocator);
+            speed.PushBack(Hashrate::normalize(hr->calc(Hashrate::LargeInterval)),  allocator);
+
+            t[0] += hr->calc(Hashrate::ShortInterval);
+            t[1] += hr->calc(Hashrate::MediumInterval);
+            t[2] += hr->calc(Hashrate::LargeInterval);
+
+            threads.AddMember(backend->type().toJSON(), speed, allocator);
+        }
+
+        total.PushBack(Hashrate::normalize(t[0]), allocator);
+        total.PushBack(Hashrate::normalize(t[1]), allocator);
+        total.PushBack(Hashrate::normalize(t[2]), allocator);
+
+        doc.AddMember("total",    total, allocator);
+        doc.AddMember("highest",  Hashrate::normalize(maxHashrate[algorithm]), allocator);
+        doc.AddMember("backends", threads, allocator);
+
+        events.send("hashrate", doc);
+    }
 #   endif
 
 
@@ -253,6 +405,10 @@ public:
     String userJobId;
     Timer *timer        = nullptr;
     uint64_t ticks      = 0;
+
+#   ifdef XMRIG_FEATURE_API
+    std::vector<std::pair<bool, String> > backendStates;
+#   endif
 };
 
 
@@ -367,6 +523,10 @@ void xmrig::Miner::pause()
 
     Nonce::pause(true);
     Nonce::touch();
+
+#   ifdef XMRIG_FEATURE_API
+    d_ptr->sendState();
+#   endif
 }
 
 
@@ -410,6 +570,10 @@ void xmrig::Miner::setEnabled(bool enabled)
         LOG_INFO(YELLOW_BOLD("paused") ", press " MAGENTA_BG_BOLD(" r ") " to resume");
     }
 
+#   ifdef XMRIG_FEATURE_API
+    d_ptr->sendState();
+#   endif
+
     if (!d_ptr->active) {
         return;
     }
@@ -504,6 +668,13 @@ void xmrig::Miner::onTimer(const Timer *)
         printHashrate(false);
     }
 
+#   ifdef XMRIG_FEATURE_API
+    if (d_ptr->controller->config()->http().isEnabled()) {
+        d_ptr->updateMetrics();
+        d_ptr->sendTick();
+    }
+#   endif
+
     d_ptr->ticks++;
 }
 
@@ -552,10 +723,24 @@ void xmrig::Miner::onRequest(IApiRequest &request)
 #ifdef XMRIG_ALGO_RANDOMX
 void xmrig::Miner::onDatasetReady()
 {
-    if (!Rx::isReady(job())) {
+    const Job job = this->job();
+    if (!Rx::isReady(job)) {
         return;
     }
 
+#   ifdef XMRIG_FEATURE_API
+    EventStream &events = d_ptr->controller->api()->events();
+    if (events.isActive()) {
+        using namespace rapidjson;
+
+        Document doc(kObjectType);
+        doc.AddMember("algo", job.algorithm().toJSON(), doc.GetAllocator());
+        doc.AddMember("seed", job.seed().toHex().toJSON(doc), doc.GetAllocator());
+
+        events.send("dataset", doc);
+    }
+#   endif
+
     d_ptr->handleJobChange();
 }
 #endif
@@ -0,0 +1,161 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "core/bench/BenchConfig.h"
+#include "base/io/json/Json.h"
+#include "rapidjson/document.h"
+
+
+namespace xmrig {
+
+
+const char *BenchConfig::kField         = "benchmark";
+static const char *kAlgo                = "algo";
+static const char *kEnabled             = "enabled";
+static const char *kHugePages           = "huge-pages";
+static const char *kIntensity           = "intensity";
+static const char *kOutput              = "output";
+static const char *kThreads             = "threads";
+static const char *kTime                = "time";
+static const char *kWarmup              = "warmup";
+
+
+static std::vector<uint32_t> readList(const rapidjson::Value &value)
+{
+    std::vector<uint32_t> out;
+
+    if (value.IsUint() && value.GetUint() > 0) {
+        out.push_back(value.GetUint());
+    }
+    else if (value.IsArray()) {
+        for (const auto &item : value.GetArray()) {
+            if (item.IsUint() && item.GetUint() > 0) {
+                out.push_back(item.GetUint());
+            }
+        }
+    }
+
+    return out;
+}
+
+
+static rapidjson::Value toJSON(const std::vector<uint32_t> &list, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    Value out(kArrayType);
+    for (uint32_t value : list) {
+        out.PushBack(value, doc.GetAllocator());
+    }
+
+    return out;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::BenchConfig::BenchConfig(const rapidjson::Value &value)
+{
+    if (!value.IsObject()) {
+        return;
+    }
+
+    m_enabled     = Json::getBool(value, kEnabled, m_enabled);
+    m_output      = Json::getString(value, kOutput);
+    m_intensities = readList(Json::getValue(value, kIntensity));
+    m_threads     = readList(Json::getValue(value, kThreads));
+
+    const auto &algo = Json::getValue(value, kAlgo);
+    if (algo.IsString()) {
+        for (const String &name : String(algo.GetString()).split(',')) {
+            const Algorithm algorithm(name);
+            if (algorithm.isValid()) {
+                m_algorithms.push_back(algorithm);
+            }
+        }
+    }
+    else if (algo.IsArray()) {
+        for (const auto &item : algo.GetArray()) {
+            const Algorithm algorithm(item.IsString() ? item.GetString() : nullptr);
+            if (algorithm.isValid()) {
+                m_algorithms.push_back(algorithm);
+            }
+        }
+    }
+
+    const auto &hugePages = Json::getValue(value, kHugePages);
+    if (hugePages.IsBool()) {
+        m_hugePages = hugePages.GetBool() ? HugePagesOn : HugePagesOff;
+    }
+
+    const uint32_t time = Json::getUint(value, kTime, m_time);
+    if (time > 0) {
+        m_time = time;
+    }
+
+    m_warmup = Json::getUint(value, kWarmup, m_warmup);
+}
+
+
+bool xmrig::BenchConfig::isEqual(const BenchConfig &other) const
+{
+    return m_enabled     == other.m_enabled &&
+           m_hugePages   == other.m_hugePages &&
+           m_algorithms  == other.m_algorithms &&
+           m_intensities == other.m_intensities &&
+           m_threads     == other.m_threads &&
+           m_output      == other.m_output &&
+           m_time        == other.m_time &&
+           m_warmup      == other.m_warmup;
+}
+
+
+/**
+ * "enabled" is never written, like "dry-run", so a saved config does not start a benchmark on the next launch.
+ */
+rapidjson::Value xmrig::BenchConfig::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value obj(kObjectType);
+    Value algo(kArrayType);
+
+    for (const Algorithm &algorithm : m_algorithms) {
+        algo.PushBack(algorithm.toJSON(), allocator);
+    }
+
+    obj.AddMember(StringRef(kAlgo),         algo, allocator);
+    obj.AddMember(StringRef(kThreads),      xmrig::toJSON(m_threads, doc), allocator);
+    obj.AddMember(StringRef(kIntensity),    xmrig::toJSON(m_intensities, doc), allocator);
+    obj.AddMember(StringRef(kHugePages),    m_hugePages == HugePagesBoth ? Value(kNullType) : Value(m_hugePages == HugePagesOn), allocator);
+    obj.AddMember(StringRef(kTime),         m_time, allocator);
+    obj.AddMember(StringRef(kWarmup),       m_warmup, allocator);
+    obj.AddMember(StringRef(kOutput),       m_output.toJSON(), allocator);
+
+    return obj;
+}
@@ -0,0 +1,88 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_BENCHCONFIG_H
+#define XMRIG_BENCHCONFIG_H
+
+
+#include "base/tools/String.h"
+#include "crypto/common/Algorithm.h"
+#include "rapidjson/fwd.h"
+
+
+#include <vector>
+
+
+namespace xmrig {
+
+
+class BenchConfig
+{
+public:
+    static const char *kField;
+
+    constexpr static uint32_t kDefaultTime   = 20;
+    constexpr static uint32_t kDefaultWarmup = 5;
+
+    enum HugePages {
+        HugePagesBoth = -1,
+        HugePagesOff,
+        HugePagesOn
+    };
+
+    BenchConfig() = default;
+    BenchConfig(const rapidjson::Value &value);
+
+    inline bool isEnabled() const                           { return m_enabled; }
+    inline const std::vector<Algorithm> &algorithms() const { return m_algorithms; }
+    inline const std::vector<uint32_t> &intensities() const { return m_intensities; }
+    inline const std::vector<uint32_t> &threads() const     { return m_threads; }
+    inline const String &output() const                     { return m_output; }
+    inline HugePages hugePages() const                      { return m_hugePages; }
+    inline uint32_t time() const                            { return m_time; }
+    inline uint32_t warmup() const                          { return m_warmup; }
+
+    inline bool operator!=(const BenchConfig &other) const  { return !isEqual(other); }
+    inline bool operator==(const BenchConfig &other) const  { return isEqual(other); }
+
+    bool isEqual(const BenchConfig &other) const;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+
+private:
+    bool m_enabled                      = false;
+    HugePages m_hugePages               = HugePagesBoth;
+    std::vector<Algorithm> m_algorithms;
+    std::vector<uint32_t> m_intensities;
+    std::vector<uint32_t> m_threads;
+    String m_output;
+    uint32_t m_time                     = kDefaultTime;
+    uint32_t m_warmup                   = kDefaultWarmup;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BENCHCONFIG_H */
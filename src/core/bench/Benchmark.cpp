@@ -0,0 +1,538 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+
+#include "core/bench/Benchmark.h"
+#include "backend/common/Hashrate.h"
+#include "backend/common/interfaces/IBackend.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Buffer.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Timer.h"
+#include "core/bench/interfaces/IBenchListener.h"
+#include "core/config/Config.h"
+#include "core/Controller.h"
+#include "core/Miner.h"
+#include "rapidjson/document.h"
+#include "version.h"
+
+
+namespace xmrig {
+
+
+static const char *tag                      = BLUE_BG_BOLD(WHITE_BOLD_S " bench ");
+static constexpr uint64_t kReadyTimeout     = 30000;    // threads that failed self-test never report hashrate
+static constexpr uint64_t kReadyTimeoutRx   = 600000;   // RandomX dataset initialization can take minutes
+static constexpr uint64_t kSampleInterval   = 2000;
+static constexpr uint64_t kTickInterval     = 500;
+
+
+// Release builds use -Ofast, which folds std::isnan() to false.
+static inline bool isValid(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    return (bits & 0x7ff0000000000000ULL) != 0x7ff0000000000000ULL && value > 0.0;
+}
+
+
+static std::vector<Algorithm> defaultAlgorithms()
+{
+    return {
+        Algorithm::CN_R,
+#       ifdef XMRIG_ALGO_CN_LITE
+        Algorithm::CN_LITE_1,
+#       endif
+#       ifdef XMRIG_ALGO_CN_HEAVY
+        Algorithm::CN_HEAVY_XHV,
+#       endif
+#       ifdef XMRIG_ALGO_CN_PICO
+        Algorithm::CN_PICO_0,
+#       endif
+#       ifdef XMRIG_ALGO_RANDOMX
+        Algorithm::RX_0,
+#       endif
+#       ifdef XMRIG_ALGO_ARGON2
+        Algorithm::AR2_CHUKWA,
+#       endif
+    };
+}
+
+
+/**
+ * Slow algorithms (RandomX light mode, Argon2 on slow CPUs) update thread counters less often than once per second,
+ * fall back to a longer window for them. The caller limits that window to the measurement, so warmup hashes are
+ * never mixed in.
+ */
+static double calc(const Hashrate *hashrate, size_t thread, size_t ms, size_t fallback)
+{
+    const double value = hashrate->calc(thread, ms);
+
+    return isValid(value) ? value : hashrate->calc(thread, std::min<size_t>(fallback, Hashrate::ShortInterval));
+}
+
+
+} // namespace xmrig
+
+
+xmrig::Benchmark::Benchmark(Controller *controller, IBenchListener *listener) :
+    m_config(controller->config()->benchmark()),
+    m_controller(controller),
+    m_listener(listener)
+{
+    m_timer = new Timer(this);
+
+    const CpuConfig &cpu = controller->config()->cpu();
+    const auto algorithms = m_config.algorithms().empty() ? defaultAlgorithms() : m_config.algorithms();
+
+    std::vector<bool> hugePages;
+    if (m_config.hugePages() != BenchConfig::HugePagesOff && cpu.isHugePages()) {
+        hugePages.push_back(true);
+    }
+
+    if (m_config.hugePages() != BenchConfig::HugePagesOn) {
+        hugePages.push_back(false);
+    }
+
+    // All runs are planned from the original profiles, every run replaces the profile of its algorithm.
+    for (const Algorithm &algorithm : algorithms) {
+        const CpuThreads &profile = cpu.threads().get(cpu.threads().profileName(algorithm));
+        if (profile.isEmpty()) {
+            LOG_WARN("%s " YELLOW("no CPU profile for ") YELLOW_BOLD("%s") YELLOW(", skipped"), tag, algorithm.shortName());
+
+            continue;
+        }
+
+        std::vector<uint32_t> counts = m_config.threads();
+        if (counts.empty()) {
+            counts.push_back(static_cast<uint32_t>(profile.count()));
+        }
+
+        std::vector<uint32_t> intensities = m_config.intensities();
+        if (intensities.empty()) {
+            for (uint32_t i = 1; i <= algorithm.maxIntensity(); ++i) {
+                intensities.push_back(i);
+            }
+        }
+
+        for (uint32_t count : counts) {
+            if (count > profile.count()) {
+                continue;
+            }
+
+            for (uint32_t intensity : intensities) {
+                if (intensity > algorithm.maxIntensity()) {
+                    continue;
+                }
+
+                for (bool pages : hugePages) {
+                    Run run;
+                    run.algorithm = algorithm;
+                    run.hugePages = pages;
+                    run.intensity = intensity;
+
+                    for (size_t i = 0; i < count; ++i) {
+                        run.affinity.push_back(profile.data()[i].affinity());
+                    }
+
+                    m_runs.push_back(std::move(run));
+                }
+            }
+        }
+    }
+}
+
+
+xmrig::Benchmark::~Benchmark()
+{
+    delete m_timer;
+}
+
+
+void xmrig::Benchmark::start()
+{
+    LOG_INFO("%s " WHITE_BOLD("%zu") " configurations, " WHITE_BOLD("%u s") " each, energy %s",
+             tag, m_runs.size(), m_config.time(), m_rapl.isAvailable() ? GREEN_BOLD("RAPL") : RED_BOLD("unavailable"));
+
+    if (m_runs.empty()) {
+        m_listener->onBenchDone(1);
+
+        return;
+    }
+
+    apply();
+
+    m_timer->start(kTickInterval, kTickInterval);
+}
+
+
+void xmrig::Benchmark::stop()
+{
+    m_timer->stop();
+}
+
+
+void xmrig::Benchmark::onTimer(const Timer *)
+{
+    const Hashrate *hr = hashrate();
+    const uint64_t now = Chrono::steadyMSecs();
+
+    if (m_state == WarmupState) {
+        const Run &run = m_runs[m_index];
+        if (now - m_ts > (run.algorithm.family() == Algorithm::RANDOM_X ? kReadyTimeoutRx : kReadyTimeout)) {
+            LOG_ERR("%s " RED("%s intensity %u threads did not start, skipped"), tag, run.algorithm.shortName(), run.intensity);
+
+            return next();
+        }
+
+        if (!isReady(hr) || now - m_ts < m_config.warmup() * 1000ULL) {
+            return;
+        }
+
+        m_rapl.read();
+
+        m_state    = MeasureState;
+        m_ts       = now;
+        m_sampleTs = now;
+        m_energy   = m_rapl.energy();
+        m_stats.assign(m_runs[m_index].affinity.size(), Stats());
+
+        return;
+    }
+
+    if (!hr || hr->threads() != m_stats.size()) {
+        return next();
+    }
+
+    if (now - m_sampleTs >= kSampleInterval) {
+        m_sampleTs = now;
+        sample(hr, now - m_ts);
+    }
+
+    if (now - m_ts >= m_config.time() * 1000ULL) {
+        finish();
+        next();
+    }
+}
+
+
+bool xmrig::Benchmark::isReady(const Hashrate *hashrate) const
+{
+    if (!hashrate || hashrate->threads() != m_runs[m_index].affinity.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < hashrate->threads(); ++i) {
+        if (!isValid(calc(hashrate, i, 1000, Hashrate::ShortInterval))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool xmrig::Benchmark::save() const
+{
+    const String &path = m_config.output();
+    if (path.isEmpty()) {
+        return true;
+    }
+
+    if (path.size() > 4 && strcasecmp(path.data() + path.size() - 4, ".csv") == 0) {
+        std::ofstream out(path.data());
+        if (!out.is_open()) {
+            return false;
+        }
+
+        out << "algo,threads,intensity,huge_pages,time,hashrate,power,joules_per_hash,hashes_per_joule,thread_spread\n";
+
+        for (const Run &run : m_runs) {
+            if (!run.valid) {
+                continue;
+            }
+
+            out << run.algorithm.shortName() << ',' << run.affinity.size() << ',' << run.intensity << ',' << (run.hugePages ? 1 : 0) << ','
+                << run.duration << ',' << run.hashrate << ',';
+
+            if (run.energy > 0.0) {
+                out << run.power() << ',' << run.joulesPerHash() << ',' << run.hashesPerJoule();
+            }
+            else {
+                out << ",,";
+            }
+
+            out << ',' << run.spread << '\n';
+        }
+
+        return out.good();
+    }
+
+    using namespace rapidjson;
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    Value results(kArrayType);
+
+    for (const Run &run : m_runs) {
+        if (!run.valid) {
+            continue;
+        }
+
+        Value result(kObjectType);
+        Value threads(kArrayType);
+
+        for (size_t i = 0; i < run.mean.size(); ++i) {
+            Value thread(kObjectType);
+            thread.AddMember("affinity",    run.affinity[i], allocator);
+            thread.AddMember("hashrate",    Json::normalize(run.mean[i], true), allocator);
+            thread.AddMember("stddev",      Json::normalize(run.stddev[i], true), allocator);
+
+            threads.PushBack(thread, allocator);
+        }
+
+        result.AddMember("algo",             run.algorithm.toJSON(), allocator);
+        result.AddMember("threads",          static_cast<uint64_t>(run.affinity.size()), allocator);
+        result.AddMember("intensity",        run.intensity, allocator);
+        result.AddMember("huge-pages",       run.hugePages, allocator);
+        result.AddMember("time",             Json::normalize(run.duration, true), allocator);
+        result.AddMember("hashrate",         Json::normalize(run.hashrate, true), allocator);
+        result.AddMember("power",            run.energy > 0.0 ? Json::normalize(run.power(), true) : Value(kNullType), allocator);
+        result.AddMember("joules_per_hash",  run.energy > 0.0 ? Value(run.joulesPerHash()) : Value(kNullType), allocator);
+        result.AddMember("hashes_per_joule", run.energy > 0.0 ? Json::normalize(run.hashesPerJoule(), true) : Value(kNullType), allocator);
+        result.AddMember("thread_spread",    Json::normalize(run.spread, true), allocator);
+        result.AddMember("per_thread",       threads, allocator);
+
+        results.PushBack(result, allocator);
+    }
+
+    doc.AddMember("version",    APP_VERSION, allocator);
+    doc.AddMember("cpu",        StringRef(Cpu::info()->brand()), allocator);
+    doc.AddMember("time",       m_config.time(), allocator);
+    doc.AddMember("results",    results, allocator);
+
+    return Json::save(path, doc);
+}
+
+
+const xmrig::Hashrate *xmrig::Benchmark::hashrate() const
+{
+    for (IBackend *backend : m_controller->miner()->backends()) {
+        if (backend->type() == "cpu") {
+            return backend->hashrate();
+        }
+    }
+
+    return nullptr;
+}
+
+
+/**
+ * Switches the miner to the next configuration through the regular config reload and job paths, so workers, memory
+ * allocation and hashrate accounting are exactly those of a mining session. The config file is never written.
+ */
+void xmrig::Benchmark::apply()
+{
+    using namespace rapidjson;
+
+    const Run &run = m_runs[m_index];
+
+    Document doc;
+    m_controller->config()->getJSON(doc);
+    auto &allocator = doc.GetAllocator();
+
+    Value threads(kArrayType);
+    for (int64_t affinity : run.affinity) {
+        Value thread(kArrayType);
+        thread.PushBack(run.intensity, allocator);
+        thread.PushBack(affinity, allocator);
+
+        threads.PushBack(thread, allocator);
+    }
+
+    Value &cpu = doc["cpu"];
+    cpu["enabled"]    = true;
+    cpu["huge-pages"] = run.hugePages;
+    cpu.RemoveMember(run.algorithm.shortName());
+    cpu.AddMember(Value(run.algorithm.shortName(), allocator), threads, allocator);
+
+    // GPU power is not included in RAPL counters.
+    for (const char *key : { "opencl", "cuda" }) {
+        if (doc.HasMember(key) && doc[key].IsObject()) {
+            doc[key]["enabled"] = false;
+        }
+    }
+
+    // Fixed job, difficulty high enough to never produce shares.
+    uint8_t blob[76]{ 0 };
+    blob[0]  = 12;
+    blob[1]  = 12;
+    blob[75] = 1;
+
+    Job job(false, run.algorithm, String());
+    job.setId(std::to_string(m_index + 1).c_str());
+    job.setBlob(Buffer::toHex(blob, sizeof(blob)).data());
+    job.setDiff(UINT64_MAX);
+    job.setHeight(1);
+
+    if (run.algorithm.family() == Algorithm::RANDOM_X) {
+        job.setSeedHash(Buffer::toHex(blob + 2, 32).data());
+    }
+
+    m_state = WarmupState;
+    m_ts    = Chrono::steadyMSecs();
+
+    // Without a job the reload would start workers for an invalid algorithm, so the first run sets the job first.
+    Miner *miner     = m_controller->miner();
+    const bool noJob = !miner->job().isValid();
+    if (noJob) {
+        miner->setJob(job, false);
+    }
+
+    m_controller->reload(doc, false);
+
+    if (!noJob) {
+        miner->setJob(job, false);
+    }
+}
+
+
+void xmrig::Benchmark::finish()
+{
+    Run &run     = m_runs[m_index];
+    run.duration = static_cast<double>(Chrono::steadyMSecs() - m_ts) / 1000.0;
+
+    if (m_rapl.read()) {
+        run.energy = static_cast<double>(m_rapl.energy() - m_energy) / 1000000.0;
+    }
+
+    double sum     = 0.0;
+    double squares = 0.0;
+
+    for (const Stats &stats : m_stats) {
+        const double mean     = stats.count ? stats.sum / stats.count : 0.0;
+        const double variance = stats.count ? std::max(stats.squares / stats.count - mean * mean, 0.0) : 0.0;
+
+        run.mean.push_back(mean);
+        run.stddev.push_back(std::sqrt(variance));
+
+        sum     += mean;
+        squares += mean * mean;
+    }
+
+    const double mean = m_stats.empty() ? 0.0 : sum / m_stats.size();
+
+    run.hashrate = sum;
+    run.spread   = mean > 0.0 ? std::sqrt(std::max(squares / m_stats.size() - mean * mean, 0.0)) / mean * 100.0 : 0.0;
+    run.valid    = sum > 0.0;
+
+    print(run);
+}
+
+
+void xmrig::Benchmark::next()
+{
+    if (++m_index < m_runs.size()) {
+        return apply();
+    }
+
+    m_timer->stop();
+
+    // Hashes per joule when energy is known, otherwise plain hashrate.
+    const bool energy = m_rapl.isAvailable();
+    const auto score  = [energy](const Run &run) { return energy ? run.hashesPerJoule() : run.hashrate; };
+
+    size_t best = m_runs.size();
+    for (size_t i = 0; i < m_runs.size(); ++i) {
+        if (m_runs[i].valid && score(m_runs[i]) > 0.0 && (best == m_runs.size() || score(m_runs[i]) > score(m_runs[best]))) {
+            best = i;
+        }
+    }
+
+    if (best < m_runs.size()) {
+        LOG_NOTICE("%s %s:", tag, energy ? "most efficient" : "fastest");
+        print(m_runs[best]);
+    }
+
+    const bool saved = save();
+    if (!saved) {
+        LOG_ERR("%s " RED("failed to write ") RED_BOLD("\"%s\""), tag, m_config.output().data());
+    }
+    else if (!m_config.output().isEmpty()) {
+        LOG_NOTICE("%s results saved to " WHITE_BOLD("\"%s\""), tag, m_config.output().data());
+    }
+
+    m_listener->onBenchDone(saved ? 0 : 1);
+}
+
+
+void xmrig::Benchmark::print(const Run &run) const
+{
+    char energy[64] = "n/a";
+
+    if (run.energy > 0.0) {
+        snprintf(energy, sizeof(energy), "%.1f W %.2f H/J", run.power(), run.hashesPerJoule());
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("%-13s") " threads " CYAN_BOLD("%zu") " intensity " CYAN_BOLD("%u") " huge pages %s " CYAN_BOLD("%.1f H/s ") CYAN_BOLD("%s") " spread " CYAN_BOLD("%.1f%%"),
+             tag,
+             run.algorithm.shortName(),
+             run.affinity.size(),
+             run.intensity,
+             run.hugePages ? GREEN_BOLD("on ") : RED_BOLD("off"),
+             run.hashrate,
+             energy,
+             run.spread
+             );
+}
+
+
+void xmrig::Benchmark::sample(const Hashrate *hashrate, uint64_t elapsed)
+{
+    for (size_t i = 0; i < m_stats.size(); ++i) {
+        const double value = calc(hashrate, i, kSampleInterval, elapsed);
+        if (!isValid(value)) {
+            continue;
+        }
+
+        m_stats[i].sum     += value;
+        m_stats[i].squares += value * value;
+        m_stats[i].count++;
+    }
+}
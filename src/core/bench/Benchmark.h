@@ -0,0 +1,121 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_BENCHMARK_H
+#define XMRIG_BENCHMARK_H
+
+
+#include <vector>
+
+
+#include "backend/cpu/platform/Rapl.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/tools/Object.h"
+#include "core/bench/BenchConfig.h"
+
+
+namespace xmrig {
+
+
+class Controller;
+class Hashrate;
+class IBenchListener;
+class Timer;
+
+
+class Benchmark : public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Benchmark)
+
+    Benchmark(Controller *controller, IBenchListener *listener);
+    ~Benchmark() override;
+
+    void start();
+    void stop();
+
+protected:
+    void onTimer(const Timer *timer) override;
+
+private:
+    enum State {
+        WarmupState,
+        MeasureState
+    };
+
+    struct Stats
+    {
+        double sum      = 0.0;
+        double squares  = 0.0;
+        uint32_t count  = 0;
+    };
+
+    struct Run
+    {
+        inline double hashesPerJoule() const    { return energy > 0.0 ? hashrate * duration / energy : 0.0; }
+        inline double joulesPerHash() const     { return energy > 0.0 && hashrate > 0.0 ? energy / (hashrate * duration) : 0.0; }
+        inline double power() const             { return energy > 0.0 && duration > 0.0 ? energy / duration : 0.0; }
+
+        Algorithm algorithm;
+        bool hugePages          = false;
+        bool valid              = false;
+        double duration         = 0.0;
+        double energy           = 0.0;
+        double hashrate         = 0.0;
+        double spread           = 0.0;
+        std::vector<double> mean;
+        std::vector<double> stddev;
+        std::vector<int64_t> affinity;
+        uint32_t intensity      = 1;
+    };
+
+    bool isReady(const Hashrate *hashrate) const;
+    bool save() const;
+    const Hashrate *hashrate() const;
+    void apply();
+    void finish();
+    void next();
+    void print(const Run &run) const;
+    void sample(const Hashrate *hashrate, uint64_t elapsed);
+
+    BenchConfig m_config;
+    Controller *m_controller;
+    IBenchListener *m_listener;
+    Rapl m_rapl;
+    size_t m_index          = 0;
+    State m_state           = WarmupState;
+    std::vector<Run> m_runs;
+    std::vector<Stats> m_stats;
+    Timer *m_timer;
+    uint64_t m_energy       = 0;
+    uint64_t m_sampleTs     = 0;
+    uint64_t m_ts           = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BENCHMARK_H */
@@ -53,6 +53,16 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_POOL_SIM
+#   include "net/sim/SimConfig.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_BENCHMARK
+#   include "core/bench/BenchConfig.h"
+#endif
+
+
 namespace xmrig {
 
 static const char *kCPU     = "cpu";
@@ -95,6 +105,14 @@ public:
 #   if defined(XMRIG_FEATURE_NVML)
     uint32_t healthPrintTime = 60;
 #   endif
+
+#   ifdef XMRIG_FEATURE_POOL_SIM
+    std::vector<SimConfig> sims;
+#   endif
+
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    BenchConfig benchmark;
+#   endif
 };
 
 }
@@ -150,6 +168,22 @@ uint32_t xmrig::Config::healthPrintTime() const
 #endif
 
 
+#ifdef XMRIG_FEATURE_POOL_SIM
+const std::vector<xmrig::SimConfig> &xmrig::Config::sims() const
+{
+    return d_ptr->sims;
+}
+#endif
+
+
+#ifdef XMRIG_FEATURE_BENCHMARK
+const xmrig::BenchConfig &xmrig::Config::benchmark() const
+{
+    return d_ptr->benchmark;
+}
+#endif
+
+
 bool xmrig::Config::isShouldSave() const
 {
     if (!isAutoSave()) {
@@ -198,6 +232,14 @@ bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
     d_ptr->healthPrintTime = reader.getUint(kHealthPrintTime, d_ptr->healthPrintTime);
 #   endif
 
+#   ifdef XMRIG_FEATURE_POOL_SIM
+    d_ptr->sims = SimConfig::read(reader.getValue(SimConfig::kField));
+#   endif
+
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    d_ptr->benchmark = BenchConfig(reader.getValue(BenchConfig::kField));
+#   endif
+
     return true;
 }
 
@@ -218,6 +260,9 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
     doc.AddMember("http",              m_http.toJSON(doc), allocator);
     doc.AddMember("autosave",          isAutoSave(), allocator);
     doc.AddMember("background",        isBackground(), allocator);
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    doc.AddMember(StringRef(BenchConfig::kField), benchmark().toJSON(doc), allocator);
+#   endif
     doc.AddMember("colors",            Log::colors, allocator);
 
 #   ifdef XMRIG_ALGO_RANDOMX
@@ -234,16 +279,21 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
     doc.AddMember(StringRef(kCuda),    cuda().toJSON(doc), allocator);
 #   endif
 
+    doc.AddMember(StringRef(DnsConfig::kField), m_dns.toJSON(doc), allocator);
     doc.AddMember("donate-level",               m_pools.donateLevel(), allocator);
     doc.AddMember("donate-over-proxy",          m_pools.proxyDonate(), allocator);
     doc.AddMember("log-file",                   m_logFile.toJSON(), allocator);
     doc.AddMember("pools",                      m_pools.toJSON(doc), allocator);
+#   ifdef XMRIG_FEATURE_POOL_SIM
+    doc.AddMember(StringRef(SimConfig::kField), SimConfig::toJSON(sims(), doc), allocator);
+#   endif
     doc.AddMember("print-time",                 printTime(), allocator);
 #   if defined(XMRIG_FEATURE_NVML)
     doc.AddMember(StringRef(kHealthPrintTime),  healthPrintTime(), allocator);
 #   endif
     doc.AddMember("retries",                    m_pools.retries(), allocator);
     doc.AddMember("retry-pause",                m_pools.retryPause(), allocator);
+    doc.AddMember("standby-pools",              m_pools.standby(), allocator);
     doc.AddMember("syslog",                     isSyslog(), allocator);
     doc.AddMember("user-agent",                 m_userAgent.toJSON(), allocator);
     doc.AddMember("watch",                      m_watch, allocator);
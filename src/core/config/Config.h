@@ -27,6 +27,7 @@
 
 
 #include <cstdint>
+#include <vector>
 
 
 #include "backend/cpu/CpuConfig.h"
@@ -43,6 +44,8 @@ class CudaConfig;
 class IThread;
 class OclConfig;
 class RxConfig;
+class BenchConfig;
+class SimConfig;
 
 
 class Config : public BaseConfig
@@ -71,6 +74,14 @@ public:
     uint32_t healthPrintTime() const;
 #   endif
 
+#   ifdef XMRIG_FEATURE_POOL_SIM
+    const std::vector<SimConfig> &sims() const;
+#   endif
+
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    const BenchConfig &benchmark() const;
+#   endif
+
     bool isShouldSave() const;
     bool read(const IJsonReader &reader, const char *fileName) override;
     void getJSON(rapidjson::Document &doc) const override;
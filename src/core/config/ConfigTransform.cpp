@@ -51,6 +51,10 @@ static const char *kOcl         = "opencl";
 static const char *kCuda        = "cuda";
 #endif
 
+#ifdef XMRIG_FEATURE_BENCHMARK
+static const char *kBenchmark   = "benchmark";
+#endif
+
 
 static inline uint64_t intensity(uint64_t av)
 {
@@ -151,6 +155,24 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::YieldKey: /* --cpu-no-yield */
         return set(doc, kCpu, "yield", false);
 
+    case IConfig::StrictWXKey: /* --cpu-strict-wx */
+        return set(doc, kCpu, "strict-wx", true);
+
+    case IConfig::PerfCountersKey: /* --cpu-perf-counters */
+        return set(doc, kCpu, "perf-counters", true);
+
+    case IConfig::RebalanceKey: /* --cpu-rebalance */
+        return set(doc, kCpu, "rebalance", true);
+
+    case IConfig::MaxTempKey: /* --cpu-max-temp */
+        return set(doc, kCpu, "max-temp", static_cast<uint64_t>(strtol(arg, nullptr, 10)));
+
+    case IConfig::MaxPowerKey: /* --cpu-max-power */
+        return set(doc, kCpu, "max-power", static_cast<uint64_t>(strtol(arg, nullptr, 10)));
+
+    case IConfig::VerifyIntervalKey: /* --cpu-verify-interval */
+        return set(doc, kCpu, "verify-interval", static_cast<uint64_t>(strtol(arg, nullptr, 10)));
+
 #   ifdef XMRIG_FEATURE_ASM
     case IConfig::AssemblyKey: /* --asm */
         return set(doc, kCpu, "asm", arg);
@@ -216,6 +238,20 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
         return set(doc, "health-print-time", static_cast<uint64_t>(strtol(arg, nullptr, 10)));
 #   endif
 
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    case IConfig::BenchKey: /* --bench */
+        return set(doc, kBenchmark, kEnabled, true);
+
+    case IConfig::BenchAlgoKey: /* --bench-algo */
+        return set(doc, kBenchmark, "algo", arg);
+
+    case IConfig::BenchTimeKey: /* --bench-time */
+        return set(doc, kBenchmark, "time", static_cast<uint64_t>(strtol(arg, nullptr, 10)));
+
+    case IConfig::BenchOutputKey: /* --bench-output */
+        return set(doc, kBenchmark, "output", arg);
+#   endif
+
     default:
         break;
     }
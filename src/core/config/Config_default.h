@@ -60,6 +60,12 @@ R"===(
         "priority": null,
         "memory-pool": false,
         "yield": true,
+        "strict-wx": false,
+        "perf-counters": false,
+        "rebalance": false,
+        "max-temp": null,
+        "max-power": null,
+        "verify-interval": 60,
         "max-threads-hint": 100,
         "asm": true,
         "argon2-impl": null,
@@ -81,6 +87,10 @@ R"===(
         "cn/0": false,
         "cn-lite/0": false
     },
+    "dns": {
+        "ipv6": false,
+        "ttl": 30
+    },
     "donate-level": 5,
     "donate-over-proxy": 1,
     "log-file": null,
@@ -105,6 +115,7 @@ R"===(
     "health-print-time": 60,
     "retries": 5,
     "retry-pause": 5,
+    "standby-pools": 0,
     "syslog": false,
     "user-agent": null,
     "watch": true
@@ -56,6 +56,7 @@ static const option options[] = {
     { "http-no-restricted",    0, nullptr, IConfig::HttpRestrictedKey     },
     { "daemon",                0, nullptr, IConfig::DaemonKey             },
     { "daemon-poll-interval",  1, nullptr, IConfig::DaemonPollKey         },
+    { "daemon-zmq-port",       1, nullptr, IConfig::DaemonZMQPortKey      },
     { "self-select",           1, nullptr, IConfig::SelfSelectKey         },
 #   endif
     { "av",                    1, nullptr, IConfig::AVKey                 },
@@ -72,9 +73,11 @@ static const option options[] = {
     { "no-color",              0, nullptr, IConfig::ColorKey              },
     { "no-huge-pages",         0, nullptr, IConfig::HugePagesKey          },
     { "pass",                  1, nullptr, IConfig::PasswordKey           },
+    { "pool-weight",           1, nullptr, IConfig::PoolWeightKey         },
     { "print-time",            1, nullptr, IConfig::PrintTimeKey          },
     { "retries",               1, nullptr, IConfig::RetriesKey            },
     { "retry-pause",           1, nullptr, IConfig::RetryPauseKey         },
+    { "standby-pools",         1, nullptr, IConfig::StandbyPoolsKey       },
     { "syslog",                0, nullptr, IConfig::SyslogKey             },
     { "threads",               1, nullptr, IConfig::ThreadsKey            },
     { "url",                   1, nullptr, IConfig::UrlKey                },
@@ -87,6 +90,12 @@ static const option options[] = {
     { "cpu-max-threads-hint",  1, nullptr, IConfig::CPUMaxThreadsKey      },
     { "cpu-memory-pool",       1, nullptr, IConfig::MemoryPoolKey         },
     { "cpu-no-yield",          0, nullptr, IConfig::YieldKey              },
+    { "cpu-strict-wx",         0, nullptr, IConfig::StrictWXKey           },
+    { "cpu-perf-counters",     0, nullptr, IConfig::PerfCountersKey       },
+    { "cpu-rebalance",         0, nullptr, IConfig::RebalanceKey          },
+    { "cpu-max-temp",          1, nullptr, IConfig::MaxTempKey            },
+    { "cpu-max-power",         1, nullptr, IConfig::MaxPowerKey           },
+    { "cpu-verify-interval",   1, nullptr, IConfig::VerifyIntervalKey     },
 #   ifdef XMRIG_FEATURE_TLS
     { "tls",                   0, nullptr, IConfig::TlsKey                },
     { "tls-fingerprint",       1, nullptr, IConfig::FingerprintKey        },
@@ -116,6 +125,12 @@ static const option options[] = {
 #   ifdef XMRIG_FEATURE_NVML
     { "no-nvml",               0, nullptr, IConfig::NvmlKey               },
     { "health-print-time",     1, nullptr, IConfig::HealthPrintTimeKey    },
+#   endif
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    { "bench",                 0, nullptr, IConfig::BenchKey              },
+    { "bench-algo",            1, nullptr, IConfig::BenchAlgoKey          },
+    { "bench-time",            1, nullptr, IConfig::BenchTimeKey          },
+    { "bench-output",          1, nullptr, IConfig::BenchOutputKey        },
 #   endif
     { nullptr,                 0, nullptr, 0 }
 };
@@ -62,11 +62,14 @@ static inline const std::string &usage()
 #   ifdef XMRIG_FEATURE_HTTP
     u += "      --daemon                  use daemon RPC instead of pool for solo mining\n";
     u += "      --daemon-poll-interval=N  daemon poll interval in milliseconds (default: 1000)\n";
+    u += "      --daemon-zmq-port=N       daemon ZMQ publisher port for instant new block notifications\n";
     u += "      --self-select=URL         self-select block templates from URL\n";
 #   endif
 
+    u += "      --pool-weight=N           share of mining time for the pool when hashrate is split across weighted pools\n";
     u += "  -r, --retries=N               number of times to retry before switch to backup server (default: 5)\n";
     u += "  -R, --retry-pause=N           time to pause between retries (default: 5)\n";
+    u += "      --standby-pools=N         number of backup pools kept logged in for instant failover (default: 0)\n";
     u += "      --user-agent              set custom user-agent string for pool\n";
     u += "      --donate-level=N          donate level, default 5%% (5 minutes in 100 minutes)\n";
     u += "      --donate-over-proxy=N     control donate over xmrig-proxy feature\n";
@@ -81,6 +84,12 @@ static inline const std::string &usage()
     u += "      --cpu-max-threads-hint=N  maximum CPU threads count (in percentage) hint for autoconfig\n";
     u += "      --cpu-memory-pool=N       number of 2 MB pages for persistent memory pool, -1 (auto), 0 (disable)\n";
     u += "      --cpu-no-yield            prefer maximum hashrate rather than system response/stability\n";
+    u += "      --cpu-strict-wx           never map memory writable and executable at the same time\n";
+    u += "      --cpu-perf-counters       collect hardware performance counters for mining threads (Linux only)\n";
+    u += "      --cpu-rebalance           move or park threads pinned to cores busy with other work (Linux only)\n";
+    u += "      --cpu-max-temp=N          throttle CPU threads to keep package temperature below N degrees C (Linux only)\n";
+    u += "      --cpu-max-power=N         throttle CPU threads to keep package power below N watts (Linux only)\n";
+    u += "      --cpu-verify-interval=N   re-check one hash of every CPU thread every N seconds on another thread, 0 disables (default: 60)\n";
     u += "      --no-huge-pages           disable huge pages support\n";
     u += "      --asm=ASM                 ASM optimizations, possible values: auto, none, intel, ryzen, bulldozer\n";
 
@@ -143,6 +152,13 @@ static inline const std::string &usage()
     u += "  -h, --help                    display this help and exit\n";
     u += "      --dry-run                 test configuration and exit\n";
 
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    u += "      --bench                   measure hashrate and energy of CPU configurations and exit\n";
+    u += "      --bench-algo=ALGO         comma separated list of algorithms for benchmark\n";
+    u += "      --bench-time=N            benchmark duration of every configuration in seconds (default: 20)\n";
+    u += "      --bench-output=FILE       save benchmark results to a JSON or CSV (*.csv) file\n";
+#   endif
+
 #   ifdef XMRIG_FEATURE_HWLOC
     u += "      --export-topology         export hwloc topology to a XML file and exit\n";
 #   endif
@@ -41,6 +41,8 @@ namespace xmrig
 class CnCtx
 {
 public:
+    static constexpr size_t kCodeSize = 0x4000;
+
     static void create(cryptonight_ctx **ctx, uint8_t *memory, size_t size, size_t count);
     static void release(cryptonight_ctx **ctx, size_t count);
 };
@@ -514,7 +514,7 @@ static inline __m128i int_sqrt_v2(const uint64_t n0)
 }
 
 
-void v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+bool v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
 
 
 namespace xmrig {
@@ -570,18 +570,17 @@ inline void cryptonight_single_hash(const uint8_t *__restrict__ input, size_t si
     uint8_t *l0   = ctx[0]->memory;
 
 #   ifdef XMRIG_FEATURE_ASM
-    if (SOFT_AES && props.isR()) {
-        if (!ctx[0]->generated_code_data.match(ALGO, height)) {
-            V4_Instruction code[256];
-            const int code_size = v4_random_math_init<ALGO>(code, height);
-
-            if (ALGO == Algorithm::CN_R) {
-                v4_soft_aes_compile_code(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), Assembly::NONE);
-            }
+    if (SOFT_AES && props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
+        V4_Instruction code[256];
+        const int code_size = v4_random_math_init<ALGO>(code, height);
 
+        if (ALGO == Algorithm::CN_R && v4_soft_aes_compile_code(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), Assembly::NONE)) {
             ctx[0]->generated_code_data = { ALGO, height };
         }
+    }
 
+    // Code generation can fail under strict W^X, the generic loop below is used then.
+    if (SOFT_AES && props.isR() && ctx[0]->generated_code_data.match(ALGO, height)) {
         ctx[0]->saes_table = reinterpret_cast<const uint32_t*>(saes_table);
         ctx[0]->generated_code(ctx);
     } else {
@@ -808,27 +807,31 @@ extern cn_mainloop_fun cn_double_double_mainloop_sandybridge_asm;
 } // namespace xmrig
 
 
-void v4_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
-void v4_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
+bool v4_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
+bool v4_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
 
 
 template<xmrig::Algorithm::Id ALGO>
-void cn_r_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
+bool cn_r_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
 {
-    v4_compile_code(code, code_size, machine_code, ASM);
+    return v4_compile_code(code, code_size, machine_code, ASM);
 }
 
 
 template<xmrig::Algorithm::Id ALGO>
-void cn_r_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
+bool cn_r_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
 {
-    v4_compile_code_double(code, code_size, machine_code, ASM);
+    return v4_compile_code_double(code, code_size, machine_code, ASM);
 }
 
 
 namespace xmrig {
 
 
+template<Algorithm::Id ALGO, bool SOFT_AES>
+inline void cryptonight_double_hash(const uint8_t *__restrict__ input, size_t size, uint8_t *__restrict__ output, cryptonight_ctx **__restrict__ ctx, uint64_t height);
+
+
 template<Algorithm::Id ALGO, Assembly::Id ASM>
 inline void cryptonight_single_hash_asm(const uint8_t *__restrict__ input, size_t size, uint8_t *__restrict__ output, cryptonight_ctx **__restrict__ ctx, uint64_t height)
 {
@@ -837,7 +840,9 @@ inline void cryptonight_single_hash_asm(const uint8_t *__restrict__ input, size_
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
         V4_Instruction code[256];
         const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
+        if (!cn_r_compile_code<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM)) {
+            return cryptonight_single_hash<ALGO, false>(input, size, output, ctx, height);
+        }
 
         ctx[0]->generated_code_data = { ALGO, height };
     }
@@ -923,7 +928,9 @@ inline void cryptonight_double_hash_asm(const uint8_t *__restrict__ input, size_
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
         V4_Instruction code[256];
         const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code_double<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
+        if (!cn_r_compile_code_double<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM)) {
+            return cryptonight_double_hash<ALGO, false>(input, size, output, ctx, height);
+        }
 
         ctx[0]->generated_code_data = { ALGO, height };
     }
@@ -24,11 +24,14 @@
  */
 
 #include <cstring>
+#include <mutex>
 #include "crypto/cn/CryptoNight_monero.h"
 
 typedef void(*void_func)();
 
 #include "crypto/cn/asm/CryptonightR_template.h"
+#include "base/io/log/Log.h"
+#include "crypto/cn/CnCtx.h"
 #include "crypto/common/Assembly.h"
 #include "crypto/common/VirtualMemory.h"
 
@@ -42,6 +45,28 @@ static inline void add_code(uint8_t* &p, void (*p1)(), void (*p2)())
     }
 }
 
+static std::once_flag protect_error;
+
+static inline bool protect_failed()
+{
+    std::call_once(protect_error, [] {
+        LOG_ERR("cn/r: " RED_BOLD("can't change protection of generated code, using slower implementation without assembly"));
+    });
+
+    return false;
+}
+
+// Generated code lives in RWX memory unless strict W^X mode is on, so page protection has to be switched only in that mode.
+static inline bool enable_writing(void* machine_code)
+{
+    return !xmrig::VirtualMemory::isStrictWX() || xmrig::VirtualMemory::unprotectExecutableMemory(machine_code, xmrig::CnCtx::kCodeSize) || protect_failed();
+}
+
+static inline bool enable_execution(void* machine_code)
+{
+    return !xmrig::VirtualMemory::isStrictWX() || xmrig::VirtualMemory::protectExecutableMemory(machine_code, xmrig::CnCtx::kCodeSize) || protect_failed();
+}
+
 static inline void add_random_math(uint8_t* &p, const V4_Instruction* code, int code_size, const void_func* instructions, const void_func* instructions_mov, bool is_64_bit, xmrig::Assembly::Id ASM)
 {
     uint32_t prev_rot_src = (uint32_t)(-1);
@@ -99,25 +124,39 @@ static inline void add_random_math(uint8_t* &p, const V4_Instruction* code, int
     }
 }
 
-void v4_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
+bool v4_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
 {
     uint8_t* p0 = reinterpret_cast<uint8_t*>(machine_code);
     uint8_t* p = p0;
 
+    if (!enable_writing(machine_code)) {
+        return false;
+    }
+
     add_code(p, CryptonightR_template_part1, CryptonightR_template_part2);
     add_random_math(p, code, code_size, instructions, instructions_mov, false, ASM);
     add_code(p, CryptonightR_template_part2, CryptonightR_template_part3);
     *(int*)(p - 4) = static_cast<int>((((const uint8_t*)CryptonightR_template_mainloop) - ((const uint8_t*)CryptonightR_template_part1)) - (p - p0));
     add_code(p, CryptonightR_template_part3, CryptonightR_template_end);
 
+    if (!enable_execution(machine_code)) {
+        return false;
+    }
+
     xmrig::VirtualMemory::flushInstructionCache(machine_code, p - p0);
+
+    return true;
 }
 
-void v4_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
+bool v4_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
 {
     uint8_t* p0 = reinterpret_cast<uint8_t*>(machine_code);
     uint8_t* p = p0;
 
+    if (!enable_writing(machine_code)) {
+        return false;
+    }
+
     add_code(p, CryptonightR_template_double_part1, CryptonightR_template_double_part2);
     add_random_math(p, code, code_size, instructions, instructions_mov, false, ASM);
     add_code(p, CryptonightR_template_double_part2, CryptonightR_template_double_part3);
@@ -126,19 +165,35 @@ void v4_compile_code_double(const V4_Instruction* code, int code_size, void* mac
     *(int*)(p - 4) = static_cast<int>((((const uint8_t*)CryptonightR_template_double_mainloop) - ((const uint8_t*)CryptonightR_template_double_part1)) - (p - p0));
     add_code(p, CryptonightR_template_double_part4, CryptonightR_template_double_end);
 
+    if (!enable_execution(machine_code)) {
+        return false;
+    }
+
     xmrig::VirtualMemory::flushInstructionCache(machine_code, p - p0);
+
+    return true;
 }
 
-void v4_soft_aes_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
+bool v4_soft_aes_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
 {
     uint8_t* p0 = reinterpret_cast<uint8_t*>(machine_code);
     uint8_t* p = p0;
 
+    if (!enable_writing(machine_code)) {
+        return false;
+    }
+
     add_code(p, CryptonightR_soft_aes_template_part1, CryptonightR_soft_aes_template_part2);
     add_random_math(p, code, code_size, instructions, instructions_mov, false, ASM);
     add_code(p, CryptonightR_soft_aes_template_part2, CryptonightR_soft_aes_template_part3);
     *(int*)(p - 4) = static_cast<int>((((const uint8_t*)CryptonightR_soft_aes_template_mainloop) - ((const uint8_t*)CryptonightR_soft_aes_template_part1)) - (p - p0));
     add_code(p, CryptonightR_soft_aes_template_part3, CryptonightR_soft_aes_template_end);
 
+    if (!enable_execution(machine_code)) {
+        return false;
+    }
+
     xmrig::VirtualMemory::flushInstructionCache(machine_code, p - p0);
+
+    return true;
 }
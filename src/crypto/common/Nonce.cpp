@@ -32,6 +32,7 @@
 namespace xmrig {
 
 
+std::atomic<bool> Nonce::m_exhausted[2];
 std::atomic<bool> Nonce::m_paused;
 std::atomic<uint64_t> Nonce::m_sequence[Nonce::MAX];
 uint32_t Nonce::m_nonces[2] = { 0, 0 };
@@ -69,6 +70,12 @@ uint32_t xmrig::Nonce::next(uint8_t index, uint32_t nonce, uint32_t reserveCount
 
     m_nonces[index] += reserveCount;
 
+    // Flag the job when less than 1/16 of the nonce space is left (or it wrapped around), so the job source can provide a fresh blob.
+    const uint32_t space = nicehash ? 0xFFFFFF : 0xFFFFFFFF;
+    if (m_nonces[index] < reserveCount || m_nonces[index] > space - (space >> 4)) {
+        m_exhausted[index] = true;
+    }
+
     return next;
 }
 
@@ -77,7 +84,8 @@ void xmrig::Nonce::reset(uint8_t index)
 {
     std::lock_guard<std::mutex> lock(mutex);
 
-    m_nonces[index] = 0;
+    m_nonces[index]    = 0;
+    m_exhausted[index] = false;
 }
 
 
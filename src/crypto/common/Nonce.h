@@ -45,6 +45,7 @@ public:
 
     Nonce();
 
+    static inline bool isExhausted(uint8_t index)                       { return m_exhausted[index].load(std::memory_order_relaxed); }
     static inline bool isOutdated(Backend backend, uint64_t sequence)   { return m_sequence[backend].load(std::memory_order_relaxed) != sequence; }
     static inline bool isPaused()                                       { return m_paused.load(std::memory_order_relaxed); }
     static inline uint64_t sequence(Backend backend)                    { return m_sequence[backend].load(std::memory_order_relaxed); }
@@ -58,6 +59,7 @@ public:
     static void touch();
 
 private:
+    static std::atomic<bool> m_exhausted[2];
     static std::atomic<bool> m_paused;
     static std::atomic<uint64_t> m_sequence[MAX];
     static uint32_t m_nonces[2];
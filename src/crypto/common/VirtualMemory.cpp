@@ -37,6 +37,7 @@
 #endif
 
 
+#include <atomic>
 #include <cinttypes>
 #include <mutex>
 
@@ -44,6 +45,7 @@
 namespace xmrig {
 
 static IMemoryPool *pool = nullptr;
+static std::atomic<bool> strictWXEnabled(false);
 static std::mutex mutex;
 
 } // namespace xmrig
@@ -96,6 +98,18 @@ xmrig::VirtualMemory::~VirtualMemory()
 
 
 #ifndef XMRIG_FEATURE_HWLOC
+bool xmrig::VirtualMemory::membind(void *, size_t, uint32_t, size_t)
+{
+    return false;
+}
+
+
+int32_t xmrig::VirtualMemory::memoryNode(const void *, size_t)
+{
+    return -1;
+}
+
+
 uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 {
     return 0;
@@ -103,16 +117,26 @@ uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 #endif
 
 
+bool xmrig::VirtualMemory::isStrictWX()
+{
+    return strictWXEnabled;
+}
+
+
 void xmrig::VirtualMemory::destroy()
 {
     delete pool;
 }
 
 
-void xmrig::VirtualMemory::init(size_t poolSize, bool hugePages)
+void xmrig::VirtualMemory::init(size_t poolSize, bool hugePages, bool strictWX)
 {
     if (!pool) {
         osInit(hugePages);
+
+        if (strictWX || !isRWXAllowed()) {
+            setStrictWX(true);
+        }
     }
 
 #   ifdef XMRIG_FEATURE_HWLOC
@@ -124,3 +148,9 @@ void xmrig::VirtualMemory::init(size_t poolSize, bool hugePages)
         pool = new MemoryPool(poolSize, hugePages);
     }
 }
+
+
+void xmrig::VirtualMemory::setStrictWX(bool enable)
+{
+    strictWXEnabled = enable;
+}
@@ -49,6 +49,7 @@ public:
     ~VirtualMemory();
 
     inline bool isHugePages() const     { return m_flags.test(FLAG_HUGEPAGES); }
+    inline size_t pageSize() const      { return isHugePages() ? 2097152 : 4096; }
     inline size_t size() const          { return m_size; }
     inline uint8_t *scratchpad() const  { return m_scratchpad; }
 
@@ -58,15 +59,21 @@ public:
     }
 
     static bool isHugepagesAvailable();
+    static bool isStrictWX();
+    static bool membind(void *p, size_t size, uint32_t node, size_t pageSize = 4096);
+    static int32_t memoryNode(const void *p, size_t size);
     static uint32_t bindToNUMANode(int64_t affinity);
+    static void *allocateDualMappedMemory(size_t size, void **exec);
     static void *allocateExecutableMemory(size_t size);
     static void *allocateLargePagesMemory(size_t size);
     static void destroy();
     static void flushInstructionCache(void *p, size_t size);
+    static void freeDualMappedMemory(void *p, void *exec, size_t size);
     static void freeLargePagesMemory(void *p, size_t size);
-    static void init(size_t poolSize, bool hugePages);
-    static void protectExecutableMemory(void *p, size_t size);
-    static void unprotectExecutableMemory(void *p, size_t size);
+    static void init(size_t poolSize, bool hugePages, bool strictWX = false);
+    static bool protectExecutableMemory(void *p, size_t size);
+    static void setStrictWX(bool enable);
+    static bool unprotectExecutableMemory(void *p, size_t size);
 
     static inline constexpr size_t align(size_t pos, size_t align = 2097152) { return ((pos - 1) / align + 1) * align; }
 
@@ -78,6 +85,7 @@ private:
         FLAG_MAX
     };
 
+    static bool isRWXAllowed();
     static void osInit(bool hugePages);
 
     bool allocateLargePagesMemory();
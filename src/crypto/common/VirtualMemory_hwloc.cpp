@@ -51,3 +51,65 @@ uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t affinity)
 
     return hwloc_bitmap_first(pu->nodeset);
 }
+
+
+bool xmrig::VirtualMemory::membind(void *p, size_t size, uint32_t node, size_t pageSize)
+{
+    if (p == nullptr || size == 0 || Cpu::info()->nodes() < 2) {
+        return false;
+    }
+
+    // Binding works on whole pages of the mapping (2 MB for huge pages), only pages entirely inside the range are bound,
+    // so a page shared with memory of another thread is never migrated back and forth.
+    const uintptr_t start = align(reinterpret_cast<uintptr_t>(p), pageSize);
+    const uintptr_t end   = (reinterpret_cast<uintptr_t>(p) + size) & ~(static_cast<uintptr_t>(pageSize) - 1);
+
+    if (end <= start) {
+        return false;
+    }
+
+    auto cpu = static_cast<HwlocCpuInfo *>(Cpu::info());
+    if (!hwloc_topology_get_support(cpu->topology())->membind->set_area_membind) {
+        return false;
+    }
+
+    const size_t length = end - start;
+
+    hwloc_bitmap_t nodeset = hwloc_bitmap_alloc();
+    hwloc_bitmap_only(nodeset, node);
+
+#   if HWLOC_API_VERSION >= 0x20000
+    const bool rc = hwloc_set_area_membind(cpu->topology(), reinterpret_cast<void *>(start), length, nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE | HWLOC_MEMBIND_BYNODESET) >= 0;
+#   else
+    const bool rc = hwloc_set_area_membind_nodeset(cpu->topology(), reinterpret_cast<void *>(start), length, nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE) >= 0;
+#   endif
+
+    hwloc_bitmap_free(nodeset);
+
+    return rc;
+}
+
+
+int32_t xmrig::VirtualMemory::memoryNode(const void *p, size_t size)
+{
+#   if HWLOC_API_VERSION >= 0x20000
+    if (p == nullptr || size == 0) {
+        return -1;
+    }
+
+    auto cpu               = static_cast<HwlocCpuInfo *>(Cpu::info());
+    hwloc_bitmap_t nodeset = hwloc_bitmap_alloc();
+    int32_t node           = -1;
+
+    // Only pages already touched are reported, on Linux it is move_pages(2) in query mode.
+    if (hwloc_get_area_memlocation(cpu->topology(), p, size, nodeset, HWLOC_MEMBIND_BYNODESET) == 0 && !hwloc_bitmap_iszero(nodeset)) {
+        node = hwloc_bitmap_weight(nodeset) > 1 ? -2 : hwloc_bitmap_first(nodeset);
+    }
+
+    hwloc_bitmap_free(nodeset);
+
+    return node;
+#   else
+    return -1;
+#   endif
+}
@@ -26,7 +26,9 @@
 
 
 #include <cstdlib>
+#include <fcntl.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
 
 #include "crypto/common/portable/mm_malloc.h"
@@ -38,19 +40,100 @@
 #endif
 
 
+#if defined(__linux__)
+#   include <sys/syscall.h>
+#endif
+
+
+#if defined(__APPLE__)
+#   define XMRIG_MAP_ANONYMOUS MAP_ANON
+#else
+#   define XMRIG_MAP_ANONYMOUS MAP_ANONYMOUS
+#endif
+
+
+namespace xmrig {
+
+
+static int createSharedMemoryFile(size_t size)
+{
+#   if defined(__linux__) && defined(SYS_memfd_create)
+    const int fd = static_cast<int>(syscall(SYS_memfd_create, "xmrig-jit", 1 /* MFD_CLOEXEC */));
+#   elif defined(__FreeBSD__)
+    const int fd = shm_open(SHM_ANON, O_RDWR | O_CLOEXEC, 0600);
+#   else
+    const int fd = -1;
+#   endif
+
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+
+        return -1;
+    }
+
+    return fd;
+}
+
+
+} // namespace xmrig
+
+
 bool xmrig::VirtualMemory::isHugepagesAvailable()
 {
     return true;
 }
 
 
+void *xmrig::VirtualMemory::allocateDualMappedMemory(size_t size, void **exec)
+{
+    const int fd = createSharedMemoryFile(size);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    void *rw = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void *rx = mmap(0, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+
+    close(fd);
+
+    if (rw == MAP_FAILED || rx == MAP_FAILED) {
+        if (rw != MAP_FAILED) {
+            munmap(rw, size);
+        }
+
+        if (rx != MAP_FAILED) {
+            munmap(rx, size);
+        }
+
+        return nullptr;
+    }
+
+    *exec = rx;
+
+    return rw;
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size)
 {
-#   if defined(__APPLE__)
-    void *mem = mmap(0, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANON, -1, 0);
-#   else
-    void *mem = mmap(0, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-#   endif
+    void *mem = MAP_FAILED;
+
+    if (!isStrictWX()) {
+        mem = mmap(0, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | XMRIG_MAP_ANONYMOUS, -1, 0);
+
+        // RWX mappings are denied by the kernel (PaX MPROTECT, SELinux execmem, etc.), switch to W^X mode.
+        if (mem == MAP_FAILED) {
+            setStrictWX(true);
+        }
+    }
+
+    if (mem == MAP_FAILED) {
+        mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | XMRIG_MAP_ANONYMOUS, -1, 0);
+    }
 
     return mem == MAP_FAILED ? nullptr : mem;
 }
@@ -78,21 +161,42 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 }
 
 
+void xmrig::VirtualMemory::freeDualMappedMemory(void *p, void *exec, size_t size)
+{
+    munmap(p, size);
+    munmap(exec, size);
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t size)
 {
     munmap(p, size);
 }
 
 
-void xmrig::VirtualMemory::protectExecutableMemory(void *p, size_t size)
+bool xmrig::VirtualMemory::protectExecutableMemory(void *p, size_t size)
 {
-    mprotect(p, size, PROT_READ | PROT_EXEC);
+    return mprotect(p, size, PROT_READ | PROT_EXEC) == 0;
 }
 
 
-void xmrig::VirtualMemory::unprotectExecutableMemory(void *p, size_t size)
+bool xmrig::VirtualMemory::unprotectExecutableMemory(void *p, size_t size)
 {
-    mprotect(p, size, PROT_WRITE | PROT_EXEC);
+    return mprotect(p, size, isStrictWX() ? (PROT_READ | PROT_WRITE) : (PROT_READ | PROT_WRITE | PROT_EXEC)) == 0;
+}
+
+
+bool xmrig::VirtualMemory::isRWXAllowed()
+{
+    const size_t size = 4096;
+    void *mem         = mmap(0, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | XMRIG_MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        return false;
+    }
+
+    munmap(mem, size);
+
+    return true;
 }
 
 
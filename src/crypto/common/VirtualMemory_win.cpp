@@ -156,9 +156,55 @@ bool xmrig::VirtualMemory::isHugepagesAvailable()
 }
 
 
+void *xmrig::VirtualMemory::allocateDualMappedMemory(size_t size, void **exec)
+{
+    const uint64_t size64 = size;
+    HANDLE mapping        = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_EXECUTE_READWRITE | SEC_COMMIT, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64), nullptr);
+    if (!mapping) {
+        return nullptr;
+    }
+
+    void *rw = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, size);
+    void *rx = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_EXECUTE, 0, 0, size);
+
+    CloseHandle(mapping);
+
+    if (!rw || !rx) {
+        if (rw) {
+            UnmapViewOfFile(rw);
+        }
+
+        if (rx) {
+            UnmapViewOfFile(rx);
+        }
+
+        return nullptr;
+    }
+
+    *exec = rx;
+
+    return rw;
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size)
 {
-    return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+    void *mem = nullptr;
+
+    if (!isStrictWX()) {
+        mem = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+
+        // RWX memory is denied (Arbitrary Code Guard), switch to W^X mode.
+        if (!mem) {
+            setStrictWX(true);
+        }
+    }
+
+    if (!mem) {
+        mem = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    }
+
+    return mem;
 }
 
 
@@ -181,23 +227,43 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 }
 
 
+void xmrig::VirtualMemory::freeDualMappedMemory(void *p, void *exec, size_t)
+{
+    UnmapViewOfFile(p);
+    UnmapViewOfFile(exec);
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t)
 {
     VirtualFree(p, 0, MEM_RELEASE);
 }
 
 
-void xmrig::VirtualMemory::protectExecutableMemory(void *p, size_t size)
+bool xmrig::VirtualMemory::protectExecutableMemory(void *p, size_t size)
 {
     DWORD oldProtect;
-    VirtualProtect(p, size, PAGE_EXECUTE_READ, &oldProtect);
+    return VirtualProtect(p, size, PAGE_EXECUTE_READ, &oldProtect) != FALSE;
 }
 
 
-void xmrig::VirtualMemory::unprotectExecutableMemory(void *p, size_t size)
+bool xmrig::VirtualMemory::unprotectExecutableMemory(void *p, size_t size)
 {
     DWORD oldProtect;
-    VirtualProtect(p, size, PAGE_EXECUTE_READWRITE, &oldProtect);
+    return VirtualProtect(p, size, isStrictWX() ? PAGE_READWRITE : PAGE_EXECUTE_READWRITE, &oldProtect) != FALSE;
+}
+
+
+bool xmrig::VirtualMemory::isRWXAllowed()
+{
+    void *mem = VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+    if (!mem) {
+        return false;
+    }
+
+    VirtualFree(mem, 0, MEM_RELEASE);
+
+    return true;
 }
 
 
@@ -29,16 +29,134 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/bytecode_machine.hpp"
 #include "crypto/randomx/reciprocal.h"
 
+#if defined(__GNUC__) || defined(__clang__)
+#	define RANDOMX_COMPUTED_GOTO
+#endif
+
 namespace randomx {
 
 	const int_reg_t BytecodeMachine::zero = 0;
 
-#define INSTR_CASE(x) case InstructionType::x: \
+	static bool isFusable(InstructionType a, InstructionType b) {
+#define FUSED_CHECK(x, y) if (a == InstructionType::x && b == InstructionType::y) return true;
+		RANDOMX_FUSED_LIST(FUSED_CHECK)
+#undef FUSED_CHECK
+		return false;
+	}
+
+	static InstructionType fusedType(InstructionType a, InstructionType b) {
+#define FUSED_TYPE(x, y) if (a == InstructionType::x && b == InstructionType::y) return static_cast<InstructionType>(BytecodeFused_ ## x ## _ ## y);
+		RANDOMX_FUSED_LIST(FUSED_TYPE)
+#undef FUSED_TYPE
+		return a;
+	}
+
+	void BytecodeMachine::fuseBytecode(InstructionByteCode* bytecode, unsigned size) {
+		//the second instruction of a pair keeps its own bytecode, so branches which land in the middle of a pair
+		//and overlapping pairs are still executed correctly
+		for (unsigned i = 0; i + 1 < size; ++i) {
+			const InstructionType a = bytecode[i].type;
+			const InstructionType b = bytecode[i + 1].type;
+			if (isFusable(a, b)) {
+				bytecode[i].type = fusedType(a, b);
+			}
+		}
+	}
+
+	void BytecodeMachine::executeBytecode(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config) {
+#ifdef RANDOMX_COMPUTED_GOTO
+		static void* const dispatchTable[BytecodeTypesCount] = {
+			&&L_IADD_RS, &&L_IADD_M, &&L_ISUB_R, &&L_ISUB_M, &&L_IMUL_R, &&L_IMUL_M, &&L_IMULH_R, &&L_IMULH_M,
+			&&L_ISMULH_R, &&L_ISMULH_M, &&L_INVALID, &&L_INEG_R, &&L_IXOR_R, &&L_IXOR_M, &&L_IROR_R, &&L_IROL_R,
+			&&L_ISWAP_R, &&L_FSWAP_R, &&L_FADD_R, &&L_FADD_M, &&L_FSUB_R, &&L_FSUB_M, &&L_FSCAL_R, &&L_FMUL_R,
+			&&L_FDIV_M, &&L_FSQRT_R, &&L_CBRANCH, &&L_CFROUND, &&L_ISTORE, &&L_NOP,
+#define FUSED_LABEL_PTR(a, b) &&L_ ## a ## _ ## b,
+			RANDOMX_FUSED_LIST(FUSED_LABEL_PTR)
+#undef FUSED_LABEL_PTR
+			&&L_END
+		};
+
+		static_assert(static_cast<uint16_t>(InstructionType::NOP) == 29, "dispatch table mismatch");
+
+		int pc = 0;
+
+#define DISPATCH() goto *dispatchTable[static_cast<uint16_t>(bytecode[pc].type)]
+#define INSTR_LABEL(x) L_ ## x: \
+		exe_ ## x(bytecode[pc], pc, scratchpad, config); \
+		++pc; \
+		DISPATCH();
+#define FUSED_LABEL(a, b) L_ ## a ## _ ## b: \
+		exe_ ## a(bytecode[pc], pc, scratchpad, config); \
+		++pc; \
+		exe_ ## b(bytecode[pc], pc, scratchpad, config); \
+		++pc; \
+		DISPATCH();
+
+		DISPATCH();
+
+		INSTR_LABEL(IADD_RS)
+		INSTR_LABEL(IADD_M)
+		INSTR_LABEL(ISUB_R)
+		INSTR_LABEL(ISUB_M)
+		INSTR_LABEL(IMUL_R)
+		INSTR_LABEL(IMUL_M)
+		INSTR_LABEL(IMULH_R)
+		INSTR_LABEL(IMULH_M)
+		INSTR_LABEL(ISMULH_R)
+		INSTR_LABEL(ISMULH_M)
+		INSTR_LABEL(INEG_R)
+		INSTR_LABEL(IXOR_R)
+		INSTR_LABEL(IXOR_M)
+		INSTR_LABEL(IROR_R)
+		INSTR_LABEL(IROL_R)
+		INSTR_LABEL(ISWAP_R)
+		INSTR_LABEL(FSWAP_R)
+		INSTR_LABEL(FADD_R)
+		INSTR_LABEL(FADD_M)
+		INSTR_LABEL(FSUB_R)
+		INSTR_LABEL(FSUB_M)
+		INSTR_LABEL(FSCAL_R)
+		INSTR_LABEL(FMUL_R)
+		INSTR_LABEL(FDIV_M)
+		INSTR_LABEL(FSQRT_R)
+		INSTR_LABEL(CBRANCH)
+		INSTR_LABEL(CFROUND)
+		INSTR_LABEL(ISTORE)
+		RANDOMX_FUSED_LIST(FUSED_LABEL)
+
+	L_NOP:
+		++pc;
+		DISPATCH();
+
+	L_INVALID: //IMUL_RCP is executed as IMUL_R
+		UNREACHABLE;
+
+	L_END:
+		return;
+
+#undef FUSED_LABEL
+#undef INSTR_LABEL
+#undef DISPATCH
+#else
+		for (int pc = 0; pc < static_cast<int>(RandomX_CurrentConfig.ProgramSize); ++pc) {
+			auto& ibc = bytecode[pc];
+			executeInstruction(ibc, pc, scratchpad, config);
+		}
+#endif
+	}
+
+#define INSTR_CASE(x) case static_cast<uint16_t>(InstructionType::x): \
 	exe_ ## x(ibc, pc, scratchpad, config); \
 	break;
 
+#define FUSED_CASE(a, b) case BytecodeFused_ ## a ## _ ## b: \
+	exe_ ## a(ibc, pc, scratchpad, config); \
+	++pc; \
+	exe_ ## b((&ibc)[1], pc, scratchpad, config); \
+	break;
+
 	void BytecodeMachine::executeInstruction(RANDOMX_EXE_ARGS) {
-		switch (ibc.type)
+		switch (static_cast<uint16_t>(ibc.type))
 		{
 			INSTR_CASE(IADD_RS)
 			INSTR_CASE(IADD_M)
@@ -68,11 +186,12 @@ namespace randomx {
 			INSTR_CASE(CBRANCH)
 			INSTR_CASE(CFROUND)
 			INSTR_CASE(ISTORE)
+			RANDOMX_FUSED_LIST(FUSED_CASE)
 
-		case InstructionType::NOP:
+		case static_cast<uint16_t>(InstructionType::NOP):
 			break;
 
-		case InstructionType::IMUL_RCP: //executed as IMUL_R
+		case static_cast<uint16_t>(InstructionType::IMUL_RCP): //executed as IMUL_R
 		default:
 			UNREACHABLE;
 		}
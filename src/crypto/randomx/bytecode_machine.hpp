@@ -35,12 +35,43 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace randomx {
 
-	//register file in machine byte order
-	struct NativeRegisterFile {
-		int_reg_t r[RegistersCount] = { 0 };
-		rx_vec_f128 f[RegisterCountFlt];
-		rx_vec_f128 e[RegisterCountFlt];
-		rx_vec_f128 a[RegisterCountFlt];
+	//register file in machine byte order, every register group occupies its own cache line
+	struct alignas(64) NativeRegisterFile {
+		alignas(64) int_reg_t r[RegistersCount] = { 0 };
+		alignas(64) rx_vec_f128 f[RegisterCountFlt];
+		alignas(64) rx_vec_f128 e[RegisterCountFlt];
+		alignas(64) rx_vec_f128 a[RegisterCountFlt];
+	};
+
+	//pairs of frequent instructions which are executed by a single handler (superinstructions),
+	//the first instruction of a pair must not change control flow
+#define RANDOMX_FUSED_LIST(X) \
+	X(FMUL_R, FMUL_R) \
+	X(FMUL_R, FADD_R) \
+	X(FMUL_R, FSUB_R) \
+	X(FADD_R, FMUL_R) \
+	X(FADD_R, FADD_R) \
+	X(FADD_R, FSUB_R) \
+	X(FSUB_R, FMUL_R) \
+	X(FSUB_R, FADD_R) \
+	X(FSUB_R, FSUB_R) \
+	X(IADD_RS, IMUL_R) \
+	X(IMUL_R, IADD_RS) \
+	X(IXOR_R, IADD_RS) \
+	X(IADD_RS, CBRANCH) \
+	X(IMUL_R, CBRANCH) \
+	X(IXOR_R, CBRANCH) \
+	X(FMUL_R, CBRANCH) \
+	X(ISTORE, CBRANCH)
+
+	//bytecode types which extend InstructionType, they are never produced by the program generator
+	enum BytecodeType : uint16_t {
+		BytecodeFusedBase = static_cast<uint16_t>(InstructionType::NOP),
+#define RANDOMX_FUSED_TYPE(a, b) BytecodeFused_ ## a ## _ ## b,
+		RANDOMX_FUSED_LIST(RANDOMX_FUSED_TYPE)
+#undef RANDOMX_FUSED_TYPE
+		BytecodeEnd,
+		BytecodeTypesCount
 	};
 
 	struct InstructionByteCode {
@@ -80,6 +111,7 @@ namespace randomx {
 			nreg = &regFile;
 		}
 
+		//bytecode must have room for RandomX_CurrentConfig.ProgramSize + 1 instructions
 		void compileProgram(Program& program, InstructionByteCode* bytecode, NativeRegisterFile& regFile) {
 			beginCompilation(regFile);
 			for (unsigned i = 0; i < RandomX_CurrentConfig.ProgramSize; ++i) {
@@ -87,14 +119,12 @@ namespace randomx {
 				auto& ibc = bytecode[i];
 				compileInstruction(instr, i, ibc);
 			}
+			fuseBytecode(bytecode, RandomX_CurrentConfig.ProgramSize);
+			bytecode[RandomX_CurrentConfig.ProgramSize].type = static_cast<InstructionType>(BytecodeEnd);
 		}
 
-		static void executeBytecode(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config) {
-			for (int pc = 0; pc < static_cast<int>(RandomX_CurrentConfig.ProgramSize); ++pc) {
-				auto& ibc = bytecode[pc];
-				executeInstruction(ibc, pc, scratchpad, config);
-			}
-		}
+		static void fuseBytecode(InstructionByteCode* bytecode, unsigned size);
+		static void executeBytecode(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config);
 
 		void compileInstruction(RANDOMX_GEN_ARGS)
 #ifdef RANDOMX_GEN_TABLE
@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <stdexcept>
 #include "crypto/randomx/jit_compiler_a64.hpp"
 #include "crypto/randomx/superscalar.hpp"
 #include "crypto/randomx/program.hpp"
@@ -91,11 +92,18 @@ constexpr uint32_t IntRegMap[8] = { 4, 5, 6, 7, 12, 13, 14, 15 };
 
 JitCompilerA64::JitCompilerA64()
 	: code((uint8_t*) allocExecutableMemory(CodeSize + CalcDatasetItemSize()))
+	, protectCode(isStrictWX())
 	, literalPos(ImulRcpLiteralsEnd)
 	, num32bitLiterals(0)
 {
 	memset(reg_changed_offset, 0, sizeof(reg_changed_offset));
 	memcpy(code, (void*) randomx_program_aarch64, CodeSize);
+
+	// Make sure the page protection can actually be switched, otherwise the VM must use the interpreter
+	if (protectCode && !protectExecutableMemory(code, CodeSize + CalcDatasetItemSize())) {
+		freePagedMemory(code, CodeSize + CalcDatasetItemSize());
+		throw std::runtime_error("Failed to make JIT code executable");
+	}
 }
 
 JitCompilerA64::~JitCompilerA64()
@@ -103,6 +111,18 @@ JitCompilerA64::~JitCompilerA64()
 	freePagedMemory(code, CodeSize + CalcDatasetItemSize());
 }
 
+void JitCompilerA64::enableWriting()
+{
+	if (protectCode && !unprotectExecutableMemory(code, CodeSize + CalcDatasetItemSize()))
+		throw std::runtime_error("Failed to make JIT code writable");
+}
+
+void JitCompilerA64::enableExecution()
+{
+	if (protectCode && !protectExecutableMemory(code, CodeSize + CalcDatasetItemSize()))
+		throw std::runtime_error("Failed to make JIT code executable");
+}
+
 #if defined(ios_HOST_OS) || defined (darwin_HOST_OS)
 void sys_icache_invalidate(void *start, size_t len);
 #endif
@@ -120,6 +140,8 @@ static void clear_code_cache(char* p1, char* p2)
 
 void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& config)
 {
+	enableWriting();
+
 	uint32_t codePos = MainLoopBegin + 4;
 
 	// and w16, w10, ScratchpadL3Mask64
@@ -165,10 +187,13 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 	emit32(ARMV8A::EOR | 10 | (IntRegMap[config.readReg0] << 5) | (IntRegMap[config.readReg1] << 16), code, codePos);
 
 	clear_code_cache(reinterpret_cast<char*>(code + MainLoopBegin), reinterpret_cast<char*>(code + codePos));
+	enableExecution();
 }
 
 void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration& config, uint32_t datasetOffset)
 {
+	enableWriting();
+
 	uint32_t codePos = MainLoopBegin + 4;
 
 	// and w16, w10, ScratchpadL3Mask64
@@ -220,11 +245,14 @@ void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration
 	emit32(ARMV8A::ADD_IMM_HI | 2 | (2 << 5) | (imm_hi << 10), code, codePos);
 
 	clear_code_cache(reinterpret_cast<char*>(code + MainLoopBegin), reinterpret_cast<char*>(code + codePos));
+	enableExecution();
 }
 
 template<size_t N>
 void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[N], std::vector<uint64_t> &reciprocalCache)
 {
+	enableWriting();
+
 	uint32_t codePos = CodeSize;
 
 	uint8_t* p1 = (uint8_t*)randomx_calc_dataset_item_aarch64;
@@ -336,6 +364,7 @@ void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[N], s
 	codePos += p2 - p1;
 
 	clear_code_cache(reinterpret_cast<char*>(code + CodeSize), reinterpret_cast<char*>(code + codePos));
+	enableExecution();
 }
 
 template void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[RANDOMX_CACHE_MAX_ACCESSES], std::vector<uint64_t> &reciprocalCache);
@@ -345,6 +374,12 @@ DatasetInitFunc* JitCompilerA64::getDatasetInitFunc()
 	return (DatasetInitFunc*)(code + (((uint8_t*)randomx_init_dataset_aarch64) - ((uint8_t*)randomx_program_aarch64)));
 }
 
+uint8_t* JitCompilerA64::getCodeBuffer(size_t& size)
+{
+	size = CodeSize + CalcDatasetItemSize();
+	return code;
+}
+
 size_t JitCompilerA64::getCodeSize()
 {
 	return CodeSize;
@@ -60,14 +60,19 @@ namespace randomx {
 		ProgramFunc* getProgramFunc() { return reinterpret_cast<ProgramFunc*>(code); }
 		DatasetInitFunc* getDatasetInitFunc();
 		uint8_t* getCode() { return code; }
+		uint8_t* getCodeBuffer(size_t& size);
 		size_t getCodeSize();
 
 		static InstructionGeneratorA64 engine[256];
 		uint32_t reg_changed_offset[8];
 		uint8_t* code;
+		bool protectCode; // W^X: switch page protection between code generation and execution
 		uint32_t literalPos;
 		uint32_t num32bitLiterals;
 
+		void enableWriting();
+		void enableExecution();
+
 		static void emit32(uint32_t val, uint8_t* code, uint32_t& codePos)
 		{
 			*(uint32_t*)(code + codePos) = val;
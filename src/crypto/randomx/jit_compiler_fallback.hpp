@@ -66,6 +66,10 @@ namespace randomx {
 		uint8_t* getCode() {
 			return nullptr;
 		}
+		uint8_t* getCodeBuffer(size_t& size) {
+			size = 0;
+			return nullptr;
+		}
 		size_t getCodeSize() {
 			return 0;
 		}
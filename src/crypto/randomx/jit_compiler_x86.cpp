@@ -290,25 +290,69 @@ namespace randomx {
 
 	JitCompilerX86::JitCompilerX86() {
 		applyTweaks();
-		allocatedCode = (uint8_t*)allocExecutableMemory(CodeSize * 2);
+
+		allocatedCode = nullptr;
+		protectCode = false;
+
+		// W^X: write code through RW view and execute it through RX view of the same pages, no syscalls are required after that
+		if (isStrictWX()) {
+			void* exec = nullptr;
+			allocatedCode = (uint8_t*)allocDualMappedMemory(CodeSize * 2, &exec);
+			allocatedCodeExec = (uint8_t*)exec;
+		}
+
+		if (allocatedCode == nullptr) {
+			allocatedCode = (uint8_t*)allocExecutableMemory(CodeSize * 2);
+			allocatedCodeExec = allocatedCode;
+			protectCode = isStrictWX();
+		}
+
 		// Shift code base address to improve caching - all threads will use different L2/L3 cache sets
-		code = allocatedCode + (codeOffset.fetch_add(59 * 64) % CodeSize);
+		const size_t offset = codeOffset.fetch_add(59 * 64) % CodeSize;
+		code = allocatedCode + offset;
+		codeExec = allocatedCodeExec + offset;
 		memcpy(code, codePrologue, prologueSize);
 		memcpy(code + epilogueOffset, codeEpilogue, epilogueSize);
+
+		// Make sure the page protection can actually be switched, otherwise the VM must use the interpreter
+		if (protectCode && !protectExecutableMemory(allocatedCode, CodeSize * 2)) {
+			freePagedMemory(allocatedCode, CodeSize * 2);
+			throw std::runtime_error("Failed to make JIT code executable");
+		}
 	}
 
 	JitCompilerX86::~JitCompilerX86() {
-		freePagedMemory(allocatedCode, CodeSize);
+		if (allocatedCodeExec != allocatedCode) {
+			freeDualMappedMemory(allocatedCode, allocatedCodeExec, CodeSize * 2);
+		}
+		else {
+			freePagedMemory(allocatedCode, CodeSize * 2);
+		}
+	}
+
+	void JitCompilerX86::enableWriting() {
+		if (protectCode && !unprotectExecutableMemory(allocatedCode, CodeSize * 2)) {
+			throw std::runtime_error("Failed to make JIT code writable");
+		}
+	}
+
+	void JitCompilerX86::enableExecution() {
+		if (protectCode && !protectExecutableMemory(allocatedCode, CodeSize * 2)) {
+			throw std::runtime_error("Failed to make JIT code executable");
+		}
 	}
 
 	void JitCompilerX86::generateProgram(Program& prog, ProgramConfiguration& pcfg) {
+		enableWriting();
 		generateProgramPrologue(prog, pcfg);
 		memcpy(code + codePos, RandomX_CurrentConfig.codeReadDatasetTweaked, readDatasetSize);
 		codePos += readDatasetSize;
 		generateProgramEpilogue(prog, pcfg);
+		enableExecution();
 	}
 
 	void JitCompilerX86::generateProgramLight(Program& prog, ProgramConfiguration& pcfg, uint32_t datasetOffset) {
+		enableWriting();
 		generateProgramPrologue(prog, pcfg);
 		emit(RandomX_CurrentConfig.codeReadDatasetLightSshInitTweaked, readDatasetLightInitSize, code, codePos);
 		emit(ADD_EBX_I, code, codePos);
@@ -317,10 +361,12 @@ namespace randomx {
 		emit32(superScalarHashOffset - (codePos + 4), code, codePos);
 		emit(codeReadDatasetLightSshFin, readDatasetLightFinSize, code, codePos);
 		generateProgramEpilogue(prog, pcfg);
+		enableExecution();
 	}
 
 	template<size_t N>
 	void JitCompilerX86::generateSuperscalarHash(SuperscalarProgram(&programs)[N], std::vector<uint64_t> &reciprocalCache) {
+		enableWriting();
 		memcpy(code + superScalarHashOffset, codeShhInit, codeSshInitSize);
 		codePos = superScalarHashOffset + codeSshInitSize;
 		for (unsigned j = 0; j < RandomX_CurrentConfig.CacheAccesses; ++j) {
@@ -346,13 +392,16 @@ namespace randomx {
 			}
 		}
 		emitByte(RET, code, codePos);
+		enableExecution();
 	}
 
 	template
 	void JitCompilerX86::generateSuperscalarHash(SuperscalarProgram(&programs)[RANDOMX_CACHE_MAX_ACCESSES], std::vector<uint64_t> &reciprocalCache);
 
 	void JitCompilerX86::generateDatasetInitCode() {
+		enableWriting();
 		memcpy(code, codeDatasetInit, datasetInitSize);
+		enableExecution();
 	}
 
 	void JitCompilerX86::generateProgramPrologue(Program& prog, ProgramConfiguration& pcfg) {
@@ -55,25 +55,34 @@ namespace randomx {
 		void generateSuperscalarHash(SuperscalarProgram (&programs)[N], std::vector<uint64_t> &);
 		void generateDatasetInitCode();
 		ProgramFunc* getProgramFunc() {
-			return (ProgramFunc*)code;
+			return (ProgramFunc*)codeExec;
 		}
 		DatasetInitFunc* getDatasetInitFunc() {
-			return (DatasetInitFunc*)code;
+			return (DatasetInitFunc*)codeExec;
 		}
 		uint8_t* getCode() {
 			return code;
 		}
+		uint8_t* getCodeBuffer(size_t& size) {
+			size = CodeSize * 2;
+			return allocatedCode;
+		}
 		size_t getCodeSize();
 
 		static InstructionGeneratorX86 engine[256];
 		int registerUsage[RegistersCount];
 		uint8_t* allocatedCode;
+		uint8_t* allocatedCodeExec; //executable view of allocatedCode, differs only if memory is dual mapped (W^X)
 		uint8_t* code;
+		uint8_t* codeExec;
 		int32_t codePos;
+		bool protectCode; //W^X without dual mapping: switch page protection between code generation and execution
 
 		static bool BranchesWithin32B;
 
 		static void applyTweaks();
+		void enableWriting();
+		void enableExecution();
 		void generateProgramPrologue(Program&, ProgramConfiguration&);
 		void generateProgramEpilogue(Program&, ProgramConfiguration&);
 		template<bool rax>
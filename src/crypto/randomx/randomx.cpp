@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/vm_compiled.hpp"
 #include "crypto/randomx/vm_compiled_light.hpp"
 #include "crypto/randomx/blake2/blake2.h"
+#include "crypto/rx/RxProfiler.h"
 
 #if defined(_M_X64) || defined(__x86_64__)
 #include "crypto/randomx/jit_compiler_x86_static.hpp"
@@ -463,18 +464,24 @@ extern "C" {
 		assert(output != nullptr);
 		alignas(16) uint64_t tempHash[8];
 		rx_blake2b(tempHash, sizeof(tempHash), input, inputSize, nullptr, 0);
-		machine->initScratchpad(&tempHash);
+		{
+			RX_PROFILE(InitScratchpad);
+			machine->initScratchpad(&tempHash);
+		}
 		machine->resetRoundingMode();
 		for (uint32_t chain = 0; chain < RandomX_CurrentConfig.ProgramCount - 1; ++chain) {
 			machine->run(&tempHash);
+			RX_PROFILE(Blake2b);
 			rx_blake2b(tempHash, sizeof(tempHash), machine->getRegisterFile(), sizeof(randomx::RegisterFile), nullptr, 0);
 		}
 		machine->run(&tempHash);
+		RX_PROFILE(FinalResult);
 		machine->getFinalResult(output, RANDOMX_HASH_SIZE);
 	}
 
 	void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (&tempHash)[8], const void* input, size_t inputSize) {
 		rx_blake2b(tempHash, sizeof(tempHash), input, inputSize, nullptr, 0);
+		RX_PROFILE(InitScratchpad);
 		machine->initScratchpad(tempHash);
 	}
 
@@ -482,11 +489,13 @@ extern "C" {
 		machine->resetRoundingMode();
 		for (uint32_t chain = 0; chain < RandomX_CurrentConfig.ProgramCount - 1; ++chain) {
 			machine->run(&tempHash);
+			RX_PROFILE(Blake2b);
 			rx_blake2b(tempHash, sizeof(tempHash), machine->getRegisterFile(), sizeof(randomx::RegisterFile), nullptr, 0);
 		}
 		machine->run(&tempHash);
 
 		// Finish current hash and fill the scratchpad for the next hash at the same time
+		RX_PROFILE(HashAndFill);
 		rx_blake2b(tempHash, sizeof(tempHash), nextInput, nextInputSize, nullptr, 0);
 		machine->hashAndFill(output, RANDOMX_HASH_SIZE, tempHash);
 	}
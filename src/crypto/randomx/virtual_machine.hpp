@@ -44,6 +44,7 @@ public:
 	virtual void setCache(randomx_cache* cache) { }
 	virtual void initScratchpad(void* seed) = 0;
 	virtual void run(void* seed) = 0;
+	virtual uint8_t* getCodeBuffer(size_t& size) { size = 0; return nullptr; }
 	void resetRoundingMode();
 
 	randomx::RegisterFile *getRegisterFile() {
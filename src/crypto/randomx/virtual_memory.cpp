@@ -33,6 +33,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/virtual_memory.hpp"
 
 
+void* allocDualMappedMemory(std::size_t bytes, void** exec) {
+    return xmrig::VirtualMemory::allocateDualMappedMemory(bytes, exec);
+}
+
+
 void* allocExecutableMemory(std::size_t bytes) {
     void *mem = xmrig::VirtualMemory::allocateExecutableMemory(bytes);
     if (mem == nullptr) {
@@ -56,3 +61,23 @@ void* allocLargePagesMemory(std::size_t bytes) {
 void freePagedMemory(void* ptr, std::size_t bytes) {
     xmrig::VirtualMemory::freeLargePagesMemory(ptr, bytes);
 }
+
+
+bool isStrictWX() {
+    return xmrig::VirtualMemory::isStrictWX();
+}
+
+
+void freeDualMappedMemory(void* ptr, void* exec, std::size_t bytes) {
+    xmrig::VirtualMemory::freeDualMappedMemory(ptr, exec, bytes);
+}
+
+
+bool protectExecutableMemory(void* ptr, std::size_t bytes) {
+    return xmrig::VirtualMemory::protectExecutableMemory(ptr, bytes);
+}
+
+
+bool unprotectExecutableMemory(void* ptr, std::size_t bytes) {
+    return xmrig::VirtualMemory::unprotectExecutableMemory(ptr, bytes);
+}
@@ -30,6 +30,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cstddef>
 
+void* allocDualMappedMemory(std::size_t, void**);
 void* allocExecutableMemory(std::size_t);
 void* allocLargePagesMemory(std::size_t);
+bool isStrictWX();
+void freeDualMappedMemory(void*, void*, std::size_t);
 void freePagedMemory(void*, std::size_t);
+bool protectExecutableMemory(void*, std::size_t);
+bool unprotectExecutableMemory(void*, std::size_t);
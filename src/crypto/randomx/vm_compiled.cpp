@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "crypto/randomx/vm_compiled.hpp"
 #include "crypto/randomx/common.hpp"
+#include "crypto/rx/RxProfiler.h"
 
 namespace randomx {
 
@@ -41,10 +42,17 @@ namespace randomx {
 
 	template<bool softAes>
 	void CompiledVm<softAes>::run(void* seed) {
-		VmBase<softAes>::generateProgram(seed);
-		randomx_vm::initialize();
-		compiler.generateProgram(program, config);
+		{
+			RX_PROFILE(GenerateProgram);
+			VmBase<softAes>::generateProgram(seed);
+			randomx_vm::initialize();
+		}
+		{
+			RX_PROFILE(Compile);
+			compiler.generateProgram(program, config);
+		}
 		mem.memory = datasetPtr->memory + datasetOffset;
+		RX_PROFILE(Execute);
 		execute();
 	}
 
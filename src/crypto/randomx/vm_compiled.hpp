@@ -54,6 +54,7 @@ namespace randomx {
 
 		void setDataset(randomx_dataset* dataset) override;
 		void run(void* seed) override;
+		uint8_t* getCodeBuffer(size_t& size) override { return compiler.getCodeBuffer(size); }
 
 		using VmBase<softAes>::mem;
 		using VmBase<softAes>::program;
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "crypto/randomx/vm_compiled_light.hpp"
 #include "crypto/randomx/common.hpp"
+#include "crypto/rx/RxProfiler.h"
 #include <stdexcept>
 
 namespace randomx {
@@ -41,9 +42,16 @@ namespace randomx {
 
 	template<bool softAes>
 	void CompiledLightVm<softAes>::run(void* seed) {
-		VmBase<softAes>::generateProgram(seed);
-		randomx_vm::initialize();
-		compiler.generateProgramLight(program, config, datasetOffset);
+		{
+			RX_PROFILE(GenerateProgram);
+			VmBase<softAes>::generateProgram(seed);
+			randomx_vm::initialize();
+		}
+		{
+			RX_PROFILE(Compile);
+			compiler.generateProgramLight(program, config, datasetOffset);
+		}
+		RX_PROFILE(Execute);
 		CompiledVm<softAes>::execute();
 	}
 
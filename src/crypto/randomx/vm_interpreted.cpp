@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/dataset.hpp"
 #include "crypto/randomx/intrin_portable.h"
 #include "crypto/randomx/reciprocal.h"
+#include "crypto/rx/RxProfiler.h"
 
 namespace randomx {
 
@@ -41,8 +42,11 @@ namespace randomx {
 
 	template<bool softAes>
 	void InterpretedVm<softAes>::run(void* seed) {
-		VmBase<softAes>::generateProgram(seed);
-		randomx_vm::initialize();
+		{
+			RX_PROFILE(GenerateProgram);
+			VmBase<softAes>::generateProgram(seed);
+			randomx_vm::initialize();
+		}
 		execute();
 	}
 
@@ -54,7 +58,12 @@ namespace randomx {
 		for(unsigned i = 0; i < RegisterCountFlt; ++i)
 			nreg.a[i] = rx_load_vec_f128(&reg.a[i].lo);
 
-		compileProgram(program, bytecode, nreg);
+		{
+			RX_PROFILE(Compile);
+			compileProgram(program, bytecode, nreg);
+		}
+
+		RX_PROFILE(Execute);
 
 		uint32_t spAddr0 = mem.mx;
 		uint32_t spAddr1 = mem.ma;
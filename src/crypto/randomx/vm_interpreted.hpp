@@ -70,7 +70,7 @@ namespace randomx {
 	private:
 		void execute();
 
-		InstructionByteCode bytecode[RANDOMX_PROGRAM_MAX_SIZE];
+		InstructionByteCode bytecode[RANDOMX_PROGRAM_MAX_SIZE + 1];
 	};
 
 	using InterpretedVmDefault = InterpretedVm<true>;
@@ -32,6 +32,11 @@
 #include "crypto/rx/RxQueue.h"
 
 
+#ifdef XMRIG_FEATURE_PROFILING
+#   include "crypto/rx/RxProfiler.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -96,6 +101,10 @@ std::pair<uint32_t, uint32_t> xmrig::Rx::hugePages()
 
 void xmrig::Rx::destroy()
 {
+#   ifdef XMRIG_FEATURE_PROFILING
+    RxProfiler::print();
+#   endif
+
     delete d_ptr;
 
     d_ptr = nullptr;
@@ -25,6 +25,7 @@
 
 #include "crypto/rx/RxConfig.h"
 #include "backend/cpu/Cpu.h"
+#include "base/kernel/Cgroup.h"
 #include "rapidjson/document.h"
 
 
@@ -54,7 +55,13 @@ const char *xmrig::RxConfig::modeName() const
 
 uint32_t xmrig::RxConfig::threads() const
 {
-    return m_threads < 1 ? static_cast<uint32_t>(Cpu::info()->threads()) : static_cast<uint32_t>(m_threads);
+    if (m_threads < 1) {
+        const uint32_t count = static_cast<uint32_t>(Cpu::info()->threads());
+
+        return Cgroup::cpus() ? std::min(Cgroup::cpus(), count) : count;
+    }
+
+    return static_cast<uint32_t>(m_threads);
 }
 
 
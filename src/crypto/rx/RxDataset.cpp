@@ -28,12 +28,14 @@
 #include "crypto/rx/RxDataset.h"
 #include "backend/common/Tags.h"
 #include "base/io/log/Log.h"
+#include "base/kernel/Cgroup.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 
 
+#include <cinttypes>
 #include <thread>
 #include <uv.h>
 
@@ -173,6 +175,12 @@ void xmrig::RxDataset::allocate(bool hugePages)
         return;
     }
 
+    if (m_mode == RxConfig::AutoMode && Cgroup::memoryLimit() && Cgroup::freeMemory() < (maxSize() + RxCache::maxSize())) {
+        LOG_ERR(CLEAR "%s" RED_BOLD_S "not enough memory for RandomX dataset, control group limit %" PRIu64 " MB", rx_tag(), Cgroup::memoryLimit() / 1024 / 1024);
+
+        return;
+    }
+
     if (hugePages) {
         m_flags   = RANDOMX_FLAG_LARGE_PAGES;
         m_dataset = randomx_alloc_dataset(static_cast<randomx_flags>(m_flags));
@@ -0,0 +1,269 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2019 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018      Lee Clagett <https://github.com/vtnerd>
+ * Copyright 2018-2019 tevador     <tevador@gmail.com>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <map>
+#include <memory>
+#include <mutex>
+
+
+#include "crypto/rx/RxProfiler.h"
+#include "base/io/log/Log.h"
+
+
+#ifdef XMRIG_FEATURE_API
+#   include "rapidjson/document.h"
+#endif
+
+
+namespace xmrig {
+
+
+static const char *kPhases[RxProfiler::PhaseMax] = {
+    "init-scratchpad",
+    "generate",
+    "compile",
+    "execute",
+    "blake2b",
+    "hash-and-fill",
+    "final-result"
+};
+
+
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+static const char *kTicks = "tsc";
+#elif defined(__aarch64__)
+static const char *kTicks = "cntvct";
+#else
+static const char *kTicks = "steady_clock";
+#endif
+
+
+// Each thread writes only its own record, readers may access it at any time,
+// so plain relaxed loads/stores are enough, no atomic read-modify-write in hot path.
+class RxProfilerPhase
+{
+public:
+    inline RxProfilerPhase()
+    {
+        for (auto &bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+
+    inline void add(uint64_t ticks)
+    {
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        total.store(total.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+
+        if (ticks < min.load(std::memory_order_relaxed)) {
+            min.store(ticks, std::memory_order_relaxed);
+        }
+
+        if (ticks > max.load(std::memory_order_relaxed)) {
+            max.store(ticks, std::memory_order_relaxed);
+        }
+
+        auto &bucket = buckets[index(ticks)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+
+    static inline size_t index(uint64_t ticks)
+    {
+#       ifdef __GNUC__
+        const size_t i = ticks ? static_cast<size_t>(63 - __builtin_clzll(ticks)) : 0;
+#       else
+        size_t i = 0;
+        while (ticks >>= 1) {
+            ++i;
+        }
+#       endif
+
+        return i < RxProfiler::kBuckets ? i : RxProfiler::kBuckets - 1;
+    }
+
+
+    std::atomic<uint64_t> count { 0 };
+    std::atomic<uint64_t> max   { 0 };
+    std::atomic<uint64_t> min   { UINT64_MAX };
+    std::atomic<uint64_t> total { 0 };
+    std::atomic<uint64_t> buckets[RxProfiler::kBuckets];
+};
+
+
+class RxProfilerThread
+{
+public:
+    RxProfilerPhase phases[RxProfiler::PhaseMax];
+};
+
+
+static std::map<size_t, std::unique_ptr<RxProfilerThread> > threads;
+static std::mutex mutex;
+static thread_local RxProfilerThread *current = nullptr;
+
+
+} // namespace xmrig
+
+
+const char *xmrig::RxProfiler::name(Phase phase)
+{
+    return phase < PhaseMax ? kPhases[phase] : nullptr;
+}
+
+
+void xmrig::RxProfiler::add(Phase phase, uint64_t ticks)
+{
+    if (current) {
+        current->phases[phase].add(ticks);
+    }
+}
+
+
+void xmrig::RxProfiler::print()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint64_t count[PhaseMax] = {};
+    uint64_t total[PhaseMax] = {};
+    uint64_t min[PhaseMax]   = {};
+    uint64_t max[PhaseMax]   = {};
+    uint64_t sum             = 0;
+
+    for (uint32_t i = 0; i < PhaseMax; ++i) {
+        min[i] = UINT64_MAX;
+
+        for (const auto &kv : threads) {
+            const RxProfilerPhase &phase = kv.second->phases[i];
+
+            count[i] += phase.count.load(std::memory_order_relaxed);
+            total[i] += phase.total.load(std::memory_order_relaxed);
+            min[i]    = std::min(min[i], phase.min.load(std::memory_order_relaxed));
+            max[i]    = std::max(max[i], phase.max.load(std::memory_order_relaxed));
+        }
+
+        sum += total[i];
+    }
+
+    const uint64_t hashes = count[HashAndFill] + count[FinalResult];
+    if (!hashes || !sum) {
+        return;
+    }
+
+    LOG_INFO(WHITE_BOLD("randomx profile") " threads " CYAN_BOLD("%zu") " hashes " CYAN_BOLD("%" PRIu64) " ticks " CYAN_BOLD("%s"), threads.size(), hashes, kTicks);
+    Log::print(WHITE_BOLD_S "|           PHASE |  CALLS/H |  TICKS/CALL |  SHARE |         MIN |         MAX |");
+
+    for (uint32_t i = 0; i < PhaseMax; ++i) {
+        if (!count[i]) {
+            continue;
+        }
+
+        Log::print("| %15s | %8.2f | %11" PRIu64 " | %5.1f%% | %11" PRIu64 " | %11" PRIu64 " |",
+                   kPhases[i],
+                   static_cast<double>(count[i]) / hashes,
+                   total[i] / count[i],
+                   static_cast<double>(total[i]) / sum * 100.0,
+                   min[i],
+                   max[i]
+                   );
+    }
+
+    Log::print(WHITE_BOLD_S "|           total |        - | %11" PRIu64 " |      - |           - |           - |", sum / hashes);
+}
+
+
+void xmrig::RxProfiler::setThread(size_t id)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto &thread = threads[id];
+    if (!thread) {
+        thread.reset(new RxProfilerThread());
+    }
+
+    current = thread.get();
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::RxProfiler::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Value out(kObjectType);
+    out.AddMember("ticks", StringRef(kTicks), allocator);
+
+    Value list(kArrayType);
+
+    for (const auto &kv : threads) {
+        Value thread(kObjectType);
+        thread.AddMember("id", static_cast<uint64_t>(kv.first), allocator);
+
+        Value phases(kObjectType);
+
+        for (uint32_t i = 0; i < PhaseMax; ++i) {
+            const RxProfilerPhase &phase = kv.second->phases[i];
+            const uint64_t count         = phase.count.load(std::memory_order_relaxed);
+
+            Value histogram(kArrayType);
+            size_t last = 0;
+            for (size_t j = 0; j < kBuckets; ++j) {
+                if (phase.buckets[j].load(std::memory_order_relaxed)) {
+                    last = j + 1;
+                }
+            }
+
+            for (size_t j = 0; j < last; ++j) {
+                histogram.PushBack(phase.buckets[j].load(std::memory_order_relaxed), allocator);
+            }
+
+            Value value(kObjectType);
+            value.AddMember("count",     count, allocator);
+            value.AddMember("total",     phase.total.load(std::memory_order_relaxed), allocator);
+            value.AddMember("min",       count ? phase.min.load(std::memory_order_relaxed) : 0, allocator);
+            value.AddMember("max",       phase.max.load(std::memory_order_relaxed), allocator);
+            value.AddMember("histogram", histogram, allocator);
+
+            phases.AddMember(StringRef(kPhases[i]), value, allocator);
+        }
+
+        thread.AddMember("phases", phases, allocator);
+        list.PushBack(thread, allocator);
+    }
+
+    out.AddMember("threads", list, allocator);
+
+    return out;
+}
+#endif
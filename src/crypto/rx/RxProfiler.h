@@ -0,0 +1,119 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2019 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018      Lee Clagett <https://github.com/vtnerd>
+ * Copyright 2018-2019 tevador     <tevador@gmail.com>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_PROFILER_H
+#define XMRIG_RX_PROFILER_H
+
+
+#ifdef XMRIG_FEATURE_PROFILING
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#else
+#   include <chrono>
+#endif
+
+
+#ifdef XMRIG_FEATURE_API
+#   include "rapidjson/fwd.h"
+#endif
+
+
+namespace xmrig
+{
+
+
+class RxProfiler
+{
+public:
+    enum Phase : uint32_t {
+        InitScratchpad,
+        GenerateProgram,
+        Compile,
+        Execute,
+        Blake2b,
+        HashAndFill,
+        FinalResult,
+        PhaseMax
+    };
+
+    // Histogram bucket N counts samples in range [2^N, 2^(N+1)) ticks.
+    static constexpr size_t kBuckets = 32;
+
+    static inline uint64_t ticks()
+    {
+#       if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#       elif defined(__aarch64__)
+        uint64_t value;
+        __asm__ __volatile__("mrs %0, cntvct_el0" : "=r" (value));
+
+        return value;
+#       else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#       endif
+    }
+
+    static const char *name(Phase phase);
+    static void add(Phase phase, uint64_t ticks);
+    static void print();
+    static void setThread(size_t id);
+
+#   ifdef XMRIG_FEATURE_API
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+#   endif
+};
+
+
+class RxProfilerScope
+{
+public:
+    inline RxProfilerScope(RxProfiler::Phase phase) : m_phase(phase), m_ts(RxProfiler::ticks()) {}
+    inline ~RxProfilerScope()                       { RxProfiler::add(m_phase, RxProfiler::ticks() - m_ts); }
+
+private:
+    const RxProfiler::Phase m_phase;
+    const uint64_t m_ts;
+};
+
+
+} /* namespace xmrig */
+
+
+#   define RX_PROFILE(phase) xmrig::RxProfilerScope rx_profiler_scope(xmrig::RxProfiler::phase)
+#else
+#   define RX_PROFILE(phase)
+#endif
+
+
+#endif /* XMRIG_RX_PROFILER_H */
@@ -25,13 +25,28 @@
  */
 
 
+#include "crypto/rx/RxVm.h"
+#include "backend/common/Tags.h"
+#include "base/io/log/Log.h"
 #include "crypto/randomx/randomx.h"
+#include "crypto/randomx/virtual_machine.hpp"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
-#include "crypto/rx/RxVm.h"
 
 
-xmrig::RxVm::RxVm(RxDataset *dataset, uint8_t *scratchpad, bool softAes)
+#include <mutex>
+
+
+namespace xmrig {
+
+
+static std::once_flag interpreterWarning;
+
+
+} // namespace xmrig
+
+
+xmrig::RxVm::RxVm(RxDataset *dataset, uint8_t *scratchpad, bool softAes, bool jit)
 {
     if (!softAes) {
        m_flags |= RANDOMX_FLAG_HARD_AES;
@@ -41,11 +56,21 @@ xmrig::RxVm::RxVm(RxDataset *dataset, uint8_t *scratchpad, bool softAes)
         m_flags |= RANDOMX_FLAG_FULL_MEM;
     }
 
-    if (!dataset->cache() || dataset->cache()->isJIT()) {
+    if (jit && (!dataset->cache() || dataset->cache()->isJIT())) {
         m_flags |= RANDOMX_FLAG_JIT;
     }
 
     m_vm = randomx_create_vm(static_cast<randomx_flags>(m_flags), dataset->cache() ? dataset->cache()->get() : nullptr, dataset->get(), scratchpad);
+
+    // Executable memory is not available (W^X policy, SELinux execmem, etc.), fallback to the interpreter.
+    if (!m_vm && (m_flags & RANDOMX_FLAG_JIT)) {
+        m_flags &= ~RANDOMX_FLAG_JIT;
+        m_vm = randomx_create_vm(static_cast<randomx_flags>(m_flags), dataset->cache() ? dataset->cache()->get() : nullptr, dataset->get(), scratchpad);
+
+        std::call_once(interpreterWarning, [] {
+            LOG_WARN("%s" YELLOW_BOLD("executable memory is not available, using slow interpreter"), rx_tag());
+        });
+    }
 }
 
 
@@ -55,3 +80,15 @@ xmrig::RxVm::~RxVm()
         randomx_destroy_vm(m_vm);
     }
 }
+
+
+uint8_t *xmrig::RxVm::code(size_t &size) const
+{
+    if (!m_vm) {
+        size = 0;
+
+        return nullptr;
+    }
+
+    return m_vm->getCodeBuffer(size);
+}
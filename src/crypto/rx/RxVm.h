@@ -31,6 +31,7 @@
 #include "base/tools/Object.h"
 
 
+#include <cstddef>
 #include <cstdint>
 
 
@@ -49,11 +50,13 @@ class RxVm
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxVm);
 
-    RxVm(RxDataset *dataset, uint8_t *scratchpad, bool softAes);
+    RxVm(RxDataset *dataset, uint8_t *scratchpad, bool softAes, bool jit = true);
     ~RxVm();
 
     inline randomx_vm *get() const       { return m_vm; }
 
+    uint8_t *code(size_t &size) const;
+
 private:
     int m_flags      = 0;
     randomx_vm *m_vm = nullptr;
@@ -43,6 +43,7 @@
 #include "core/config/Config.h"
 #include "core/Controller.h"
 #include "core/Miner.h"
+#include "crypto/common/Nonce.h"
 #include "net/JobResult.h"
 #include "net/JobResults.h"
 #include "net/Network.h"
@@ -62,6 +63,25 @@ namespace xmrig {
 static const char *tag = BLUE_BG_BOLD(WHITE_BOLD_S " net ");
 
 
+#ifdef XMRIG_FEATURE_API
+static const char *backendName(uint32_t backend)
+{
+    switch (backend) {
+    case Nonce::OPENCL:
+        return "opencl";
+
+    case Nonce::CUDA:
+        return "cuda";
+
+    default:
+        break;
+    }
+
+    return "cpu";
+}
+#endif
+
+
 } // namespace xmrig
 
 
@@ -75,7 +95,9 @@ const char *xmrig::net_tag()
 xmrig::Network::Network(Controller *controller) :
     m_controller(controller),
     m_donate(nullptr),
-    m_timer(nullptr)
+    m_pending(nullptr),
+    m_timer(nullptr),
+    m_pendingTs(0)
 {
     JobResults::setListener(this, controller->config()->cpu().isHwAES());
     controller->addListener(this);
@@ -101,6 +123,7 @@ xmrig::Network::~Network()
 
     delete m_timer;
     delete m_donate;
+    delete m_pending;
     delete m_strategy;
 }
 
@@ -118,8 +141,18 @@ void xmrig::Network::onActive(IStrategy *strategy, IClient *client)
         return;
     }
 
+    if (strategy == m_pending) {
+        LOG_INFO("%s " WHITE_BOLD("new pools ready in %" PRIu64 " ms, switching"), tag, Chrono::steadyMSecs() - m_pendingTs);
+
+        switchStrategy();
+    }
+
     m_state.onActive(client);
 
+#   ifdef XMRIG_FEATURE_API
+    updateMetrics();
+#   endif
+
     const char *tlsVersion = client->tlsVersion();
     LOG_INFO("%s " WHITE_BOLD("use %s ") CYAN_BOLD("%s:%d ") GREEN_BOLD("%s") " " BLACK_BOLD("%s"),
              tag, client->mode(), client->pool().host().data(), client->pool().port(), tlsVersion ? tlsVersion : "", client->ip().data());
@@ -137,18 +170,33 @@ void xmrig::Network::onConfigChanged(Config *config, Config *previousConfig)
         return;
     }
 
-    m_strategy->stop();
-
     config->pools().print();
 
-    delete m_strategy;
-    m_strategy = config->pools().createStrategy(this);
-    connect();
+    if (m_pending) {
+        m_pending->stop();
+        delete m_pending;
+    }
+
+    m_pending = config->pools().createStrategy(this);
+
+    if (!m_strategy->isActive()) {
+        switchStrategy();
+
+        return connect();
+    }
+
+    // Keep mining on the current pools until the new strategy becomes active.
+    m_pendingTs = Chrono::steadyMSecs();
+    m_pending->connect();
 }
 
 
 void xmrig::Network::onJob(IStrategy *strategy, IClient *client, const Job &job)
 {
+    if (strategy == m_pending) {
+        return;
+    }
+
     if (m_donate && m_donate->isActive() && m_donate != strategy) {
         return;
     }
@@ -159,6 +207,24 @@ void xmrig::Network::onJob(IStrategy *strategy, IClient *client, const Job &job)
 
 void xmrig::Network::onJobResult(const JobResult &result)
 {
+#   ifdef XMRIG_FEATURE_API
+    EventStream &events = m_controller->api()->events();
+    if (events.isActive()) {
+        using namespace rapidjson;
+
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        doc.AddMember("backend", StringRef(backendName(result.backend)), allocator);
+        doc.AddMember("job_id",  result.jobId.toJSON(doc), allocator);
+        doc.AddMember("diff",    result.diff, allocator);
+        doc.AddMember("actual",  result.actualDiff(), allocator);
+        doc.AddMember("donate",  result.index == 1, allocator);
+
+        events.send("share", doc);
+    }
+#   endif
+
     if (result.index == 1 && m_donate) {
         m_donate->submit(result);
         return;
@@ -194,6 +260,10 @@ void xmrig::Network::onLogin(IStrategy *, IClient *client, rapidjson::Document &
 
 void xmrig::Network::onPause(IStrategy *strategy)
 {
+    if (strategy == m_pending) {
+        return;
+    }
+
     if (m_donate && m_donate == strategy) {
         LOG_NOTICE("%s " WHITE_BOLD("dev donate finished"), tag);
         m_strategy->resume();
@@ -203,6 +273,10 @@ void xmrig::Network::onPause(IStrategy *strategy)
         LOG_ERR("%s " RED("no active pools, stop mining"), tag);
         m_state.stop();
 
+#       ifdef XMRIG_FEATURE_API
+        updateMetrics();
+#       endif
+
         return m_controller->miner()->pause();
     }
 }
@@ -212,6 +286,28 @@ void xmrig::Network::onResultAccepted(IStrategy *, IClient *, const SubmitResult
 {
     m_state.add(result, error);
 
+#   ifdef XMRIG_FEATURE_API
+    updateMetrics();
+
+    EventStream &events = m_controller->api()->events();
+    if (events.isActive()) {
+        using namespace rapidjson;
+
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        doc.AddMember("backend",  StringRef(backendName(result.backend)), allocator);
+        doc.AddMember("accepted", error == nullptr, allocator);
+        doc.AddMember("diff",     result.diff, allocator);
+        doc.AddMember("elapsed",  result.elapsed, allocator);
+        doc.AddMember("error",    error ? Value(error, allocator) : Value(kNullType), allocator);
+        doc.AddMember("good",     m_state.accepted, allocator);
+        doc.AddMember("total",    m_state.accepted + m_state.rejected, allocator);
+
+        events.send("result", doc);
+    }
+#   endif
+
     if (error) {
         LOG_INFO("%s " RED_BOLD("rejected") " (%" PRId64 "/%" PRId64 ") diff " WHITE_BOLD("%" PRIu64) " " RED("\"%s\"") " " BLACK_BOLD("(%" PRIu64 " ms)"),
                  backend_tag(result.backend), m_state.accepted, m_state.rejected, result.diff, error, result.elapsed);
@@ -263,6 +359,36 @@ void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
 
     m_state.diff = job.diff();
     m_controller->miner()->setJob(job, donate);
+
+#   ifdef XMRIG_FEATURE_API
+    EventStream &events = m_controller->api()->events();
+    if (events.isActive()) {
+        using namespace rapidjson;
+
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        doc.AddMember("pool",   client->pool().url().toJSON(), allocator);
+        doc.AddMember("id",     job.id().toJSON(doc), allocator);
+        doc.AddMember("algo",   job.algorithm().toJSON(), allocator);
+        doc.AddMember("diff",   job.diff(), allocator);
+        doc.AddMember("height", job.height(), allocator);
+        doc.AddMember("donate", donate, allocator);
+
+        events.send("job", doc);
+    }
+#   endif
+}
+
+
+void xmrig::Network::switchStrategy()
+{
+    IStrategy *previous = m_strategy;
+    m_strategy          = m_pending;
+    m_pending           = nullptr;
+
+    previous->stop();
+    delete previous;
 }
 
 
@@ -270,6 +396,17 @@ void xmrig::Network::tick()
 {
     const uint64_t now = Chrono::steadyMSecs();
 
+    if (m_pending) {
+        if (now - m_pendingTs > kSwitchTimeout) {
+            LOG_WARN("%s " YELLOW("new pools not ready after %d seconds, switching anyway"), tag, kSwitchTimeout / 1000);
+
+            switchStrategy();
+        }
+        else {
+            m_pending->tick(now);
+        }
+    }
+
     m_strategy->tick(now);
 
     if (m_donate) {
@@ -329,4 +466,29 @@ void xmrig::Network::getResults(rapidjson::Value &reply, rapidjson::Document &do
 
     reply.AddMember("results", results, allocator);
 }
+
+
+void xmrig::Network::updateMetrics()
+{
+    Metrics &metrics = m_controller->api()->metrics();
+    metrics.begin(Metrics::NetworkSection);
+
+    const std::string labels = "pool=\"" + Metrics::escape(m_state.pool) + "\",tls=\"" + Metrics::escape(m_state.tls().data()) + "\"";
+
+    metrics.family("xmrig_pool_info", "gauge", "Active pool.");
+    metrics.add("xmrig_pool_info", labels.c_str(), uint64_t(1));
+
+    metrics.family("xmrig_shares", "counter", "Shares submitted to the active pool.");
+    metrics.add("xmrig_shares_total", "result=\"accepted\"", m_state.accepted);
+    metrics.add("xmrig_shares_total", "result=\"rejected\"", m_state.rejected);
+
+    metrics.family("xmrig_hashes", "counter", "Sum of difficulty of accepted shares.");
+    metrics.add("xmrig_hashes_total", nullptr, m_state.total);
+
+    metrics.family("xmrig_pool_failures", "counter", "Lost pool connections.");
+    metrics.add("xmrig_pool_failures_total", nullptr, m_state.failures);
+
+    metrics.family("xmrig_pool_latency_milliseconds", "gauge", "Median share response time.");
+    metrics.add("xmrig_pool_latency_milliseconds", nullptr, static_cast<uint64_t>(m_state.latency()));
+}
 #endif
@@ -76,21 +76,26 @@ protected:
 #   endif
 
 private:
-    constexpr static int kTickInterval = 1 * 1000;
+    constexpr static int kTickInterval   = 1 * 1000;
+    constexpr static int kSwitchTimeout  = 30 * 1000;
 
     void setJob(IClient *client, const Job &job, bool donate);
+    void switchStrategy();
     void tick();
 
 #   ifdef XMRIG_FEATURE_API
     void getConnection(rapidjson::Value &reply, rapidjson::Document &doc, int version) const;
     void getResults(rapidjson::Value &reply, rapidjson::Document &doc, int version) const;
+    void updateMetrics();
 #   endif
 
     Controller *m_controller;
     IStrategy *m_donate;
+    IStrategy *m_pending;
     IStrategy *m_strategy;
     NetworkState m_state;
     Timer *m_timer;
+    uint64_t m_pendingTs;
 };
 
 
@@ -0,0 +1,154 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "net/sim/SimConfig.h"
+#include "base/io/json/Json.h"
+#include "rapidjson/document.h"
+
+
+namespace xmrig {
+
+
+const char *SimConfig::kField           = "pool-sim";
+static const char *kAlgo                = "algo";
+static const char *kDelay               = "delay";
+static const char *kDiff                = "difficulty";
+static const char *kDisconnectInterval  = "disconnect-interval";
+static const char *kDownTime            = "down-time";
+static const char *kEnabled             = "enabled";
+static const char *kFlood               = "flood";
+static const char *kHost                = "host";
+static const char *kJobInterval         = "job-interval";
+static const char *kPort                = "port";
+static const char *kSeedInterval        = "seed-interval";
+static const char *kValidate            = "validate";
+
+
+} // namespace xmrig
+
+
+xmrig::SimConfig::SimConfig(const rapidjson::Value &value)
+{
+    if (!value.IsObject()) {
+        return;
+    }
+
+    const Algorithm algorithm(Json::getString(value, kAlgo));
+    if (algorithm.isValid()) {
+        m_algorithm = algorithm;
+    }
+
+    m_enabled            = Json::getBool(value, kEnabled, m_enabled);
+    m_validate           = Json::getBool(value, kValidate, m_validate);
+    m_host               = Json::getString(value, kHost);
+    m_port               = static_cast<uint16_t>(Json::getUint(value, kPort, m_port));
+    m_flood              = Json::getUint(value, kFlood, m_flood);
+    m_seedInterval       = Json::getUint(value, kSeedInterval, m_seedInterval);
+    m_delay              = Json::getUint64(value, kDelay, m_delay);
+    m_disconnectInterval = Json::getUint64(value, kDisconnectInterval, m_disconnectInterval);
+    m_downTime           = Json::getUint64(value, kDownTime, m_downTime);
+
+    const uint64_t diff = Json::getUint64(value, kDiff, m_diff);
+    if (diff > 0) {
+        m_diff = diff;
+    }
+
+    const uint64_t jobInterval = Json::getUint64(value, kJobInterval, m_jobInterval);
+    if (jobInterval >= 10) {
+        m_jobInterval = jobInterval;
+    }
+}
+
+
+bool xmrig::SimConfig::isEqual(const SimConfig &other) const
+{
+    return m_algorithm          == other.m_algorithm &&
+           m_enabled            == other.m_enabled &&
+           m_validate           == other.m_validate &&
+           m_host               == other.m_host &&
+           m_port               == other.m_port &&
+           m_flood              == other.m_flood &&
+           m_seedInterval       == other.m_seedInterval &&
+           m_delay              == other.m_delay &&
+           m_diff               == other.m_diff &&
+           m_disconnectInterval == other.m_disconnectInterval &&
+           m_downTime           == other.m_downTime &&
+           m_jobInterval        == other.m_jobInterval;
+}
+
+
+rapidjson::Value xmrig::SimConfig::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value obj(kObjectType);
+
+    obj.AddMember(StringRef(kEnabled),              m_enabled, allocator);
+    obj.AddMember(StringRef(kHost),                 m_host.toJSON(), allocator);
+    obj.AddMember(StringRef(kPort),                 m_port, allocator);
+    obj.AddMember(StringRef(kAlgo),                 m_algorithm.toJSON(), allocator);
+    obj.AddMember(StringRef(kDiff),                 m_diff, allocator);
+    obj.AddMember(StringRef(kJobInterval),          m_jobInterval, allocator);
+    obj.AddMember(StringRef(kSeedInterval),         m_seedInterval, allocator);
+    obj.AddMember(StringRef(kFlood),                m_flood, allocator);
+    obj.AddMember(StringRef(kDelay),                m_delay, allocator);
+    obj.AddMember(StringRef(kDisconnectInterval),   m_disconnectInterval, allocator);
+    obj.AddMember(StringRef(kDownTime),             m_downTime, allocator);
+    obj.AddMember(StringRef(kValidate),             m_validate, allocator);
+
+    return obj;
+}
+
+
+std::vector<xmrig::SimConfig> xmrig::SimConfig::read(const rapidjson::Value &value)
+{
+    std::vector<SimConfig> pools;
+
+    if (value.IsArray()) {
+        for (const auto &entry : value.GetArray()) {
+            pools.emplace_back(entry);
+        }
+    }
+    else if (value.IsObject()) {
+        pools.emplace_back(value);
+    }
+
+    return pools;
+}
+
+
+rapidjson::Value xmrig::SimConfig::toJSON(const std::vector<SimConfig> &pools, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    Value out(kArrayType);
+    for (const auto &pool : pools) {
+        out.PushBack(pool.toJSON(doc), doc.GetAllocator());
+    }
+
+    return out;
+}
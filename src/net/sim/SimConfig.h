@@ -0,0 +1,93 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_SIMCONFIG_H
+#define XMRIG_SIMCONFIG_H
+
+
+#include "base/tools/String.h"
+#include "crypto/common/Algorithm.h"
+#include "rapidjson/fwd.h"
+
+
+#include <vector>
+
+
+namespace xmrig {
+
+
+class SimConfig
+{
+public:
+    static const char *kField;
+
+    constexpr static uint64_t kDefaultDiff        = 1000;
+    constexpr static uint64_t kDefaultJobInterval = 30000;
+
+    SimConfig() = default;
+    SimConfig(const rapidjson::Value &value);
+
+    inline bool isEnabled() const                       { return m_enabled && m_port > 0; }
+    inline bool isValidate() const                      { return m_validate; }
+    inline const Algorithm &algorithm() const           { return m_algorithm; }
+    inline const String &host() const                   { return m_host; }
+    inline uint16_t port() const                        { return m_port; }
+    inline uint32_t flood() const                       { return m_flood; }
+    inline uint32_t seedInterval() const                { return m_seedInterval; }
+    inline uint64_t delay() const                       { return m_delay; }
+    inline uint64_t diff() const                        { return m_diff; }
+    inline uint64_t disconnectInterval() const          { return m_disconnectInterval; }
+    inline uint64_t downTime() const                    { return m_downTime; }
+    inline uint64_t jobInterval() const                 { return m_jobInterval; }
+
+    inline bool operator!=(const SimConfig &other) const    { return !isEqual(other); }
+    inline bool operator==(const SimConfig &other) const    { return isEqual(other); }
+
+    bool isEqual(const SimConfig &other) const;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+
+    static std::vector<SimConfig> read(const rapidjson::Value &value);
+    static rapidjson::Value toJSON(const std::vector<SimConfig> &pools, rapidjson::Document &doc);
+
+private:
+    Algorithm m_algorithm           = Algorithm::CN_0;
+    bool m_enabled                  = true;
+    bool m_validate                 = true;
+    String m_host;
+    uint16_t m_port                 = 0;
+    uint32_t m_flood                = 0;
+    uint32_t m_seedInterval         = 0;
+    uint64_t m_delay                = 0;
+    uint64_t m_diff                 = kDefaultDiff;
+    uint64_t m_disconnectInterval   = 0;
+    uint64_t m_downTime             = 0;
+    uint64_t m_jobInterval          = kDefaultJobInterval;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_SIMCONFIG_H */
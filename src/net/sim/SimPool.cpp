@@ -0,0 +1,727 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "net/sim/SimPool.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/net/tools/RecvBuf.h"
+#include "base/net/tools/TcpServer.h"
+#include "base/tools/Baton.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Timer.h"
+#include "crypto/cn/CnCtx.h"
+#include "crypto/cn/CnHash.h"
+#include "crypto/common/VirtualMemory.h"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/randomx/randomx.h"
+#   include "crypto/rx/Rx.h"
+#   include "crypto/rx/RxVm.h"
+#endif
+
+
+#include <cstring>
+
+
+namespace xmrig {
+
+
+static const char *tag = MAGENTA_BG(WHITE_BOLD_S " sim ") " ";
+
+
+class SimWriteBaton : public Baton<uv_write_t>
+{
+public:
+    inline SimWriteBaton(std::string &&data) :
+        m_data(std::move(data))
+    {
+        buf = uv_buf_init(const_cast<char *>(m_data.data()), static_cast<unsigned int>(m_data.size()));
+    }
+
+    inline static void onWrite(uv_write_t *req, int) { delete reinterpret_cast<SimWriteBaton *>(req->data); }
+
+    uv_buf_t buf{};
+
+private:
+    std::string m_data;
+};
+
+
+class SimShareBaton : public Baton<uv_work_t>
+{
+public:
+    enum Result : uint8_t {
+        Unverified,
+        Valid,
+        Invalid
+    };
+
+    inline SimShareBaton(SimPool *owner, uint64_t session, const rapidjson::Value &id, const Job &job, uint32_t nonce, const uint8_t *result) :
+        hwAES(Cpu::info()->hasAES()),
+        job(job),
+        owner(owner),
+        session(session),
+        nonce(nonce)
+    {
+        this->id.CopyFrom(id, this->id.GetAllocator());
+        memcpy(this->result, result, sizeof(this->result));
+    }
+
+    const bool hwAES;
+    Job job;
+    rapidjson::Document id;
+    Result status   = Valid;
+    SimPool *owner;
+    uint64_t session;
+    uint32_t nonce;
+    uint8_t result[32];
+};
+
+
+class SimPool::Session : public ILineListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Session)
+
+    inline Session(SimPool *pool, uint64_t id) :
+        m_pool(pool),
+        m_id(id)
+    {
+        uv_tcp_init(uv_default_loop(), &m_tcp);
+        m_tcp.data = this;
+
+        uv_tcp_nodelay(&m_tcp, 1);
+    }
+
+    inline uint64_t id() const          { return m_id; }
+    inline uv_stream_t *stream()        { return reinterpret_cast<uv_stream_t *>(&m_tcp); }
+    inline void detach()                { m_pool = nullptr; }
+
+    bool accept(uv_stream_t *server)
+    {
+        if (uv_accept(server, stream()) != 0 || uv_read_start(stream(), onAlloc, onRead) != 0) {
+            return false;
+        }
+
+        return true;
+    }
+
+    void close()
+    {
+        if (uv_is_closing(reinterpret_cast<uv_handle_t *>(&m_tcp)) == 0) {
+            uv_close(reinterpret_cast<uv_handle_t *>(&m_tcp), onClose);
+        }
+    }
+
+    void write(std::string &&data)
+    {
+        if (uv_is_closing(reinterpret_cast<uv_handle_t *>(&m_tcp))) {
+            return;
+        }
+
+        auto baton = new SimWriteBaton(std::move(data));
+        uv_write(&baton->req, stream(), &baton->buf, 1, SimWriteBaton::onWrite);
+    }
+
+protected:
+    inline void onLine(char *line, size_t) override
+    {
+        if (m_pool) {
+            m_pool->onRequest(this, line);
+        }
+    }
+
+private:
+    static void onAlloc(uv_handle_t *handle, size_t, uv_buf_t *buf)
+    {
+        auto session = static_cast<Session *>(handle->data);
+
+        buf->base = session->m_recvBuf.current();
+        buf->len  = session->m_recvBuf.available();
+    }
+
+    static void onClose(uv_handle_t *handle)
+    {
+        auto session = static_cast<Session *>(handle->data);
+        if (session->m_pool) {
+            session->m_pool->m_sessions.erase(session->m_id);
+        }
+
+        delete session;
+    }
+
+    static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *)
+    {
+        auto session = static_cast<Session *>(stream->data);
+        if (nread < 0 || (nread == 0 && session->m_recvBuf.available() == 0)) {
+            return session->close();
+        }
+
+        session->m_recvBuf.nread(static_cast<size_t>(nread));
+        session->m_recvBuf.getline(session);
+
+        if (session->m_recvBuf.available() == 0) {
+            session->close();
+        }
+    }
+
+    RecvBuf<4096> m_recvBuf;
+    SimPool *m_pool;
+    uint64_t m_id;
+    uv_tcp_t m_tcp{};
+};
+
+
+static std::string toString(const rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    StringBuffer buffer(nullptr, 512);
+    Writer<StringBuffer> writer(buffer);
+    doc.Accept(writer);
+
+    return std::string(buffer.GetString(), buffer.GetSize()) + "\n";
+}
+
+
+static SimShareBaton::Result verify(SimShareBaton &baton)
+{
+    Job &job              = baton.job;
+    const auto &algorithm = job.algorithm();
+    uint8_t hash[32]{ 0 };
+
+    *job.nonce() = baton.nonce;
+
+    if (algorithm.family() == Algorithm::RANDOM_X) {
+#       ifdef XMRIG_ALGO_RANDOMX
+        RxDataset *dataset = Rx::dataset(job, 0);
+        if (dataset == nullptr) {
+            return SimShareBaton::Unverified;
+        }
+
+        VirtualMemory memory(algorithm.l3(), false, false);
+
+        auto vm = new RxVm(dataset, memory.scratchpad(), !baton.hwAES);
+        randomx_calculate_hash(vm->get(), job.blob(), job.size(), hash);
+        delete vm;
+#       else
+        return SimShareBaton::Unverified;
+#       endif
+    }
+    else {
+        const cn_hash_fun fn = CnHash::fn(algorithm, baton.hwAES ? CnHash::AV_SINGLE : CnHash::AV_SINGLE_SOFT, Assembly::NONE);
+        if (!fn) {
+            return SimShareBaton::Unverified;
+        }
+
+        VirtualMemory memory(algorithm.l3(), false, false);
+        cryptonight_ctx *ctx[1];
+        CnCtx::create(ctx, memory.scratchpad(), memory.size(), 1);
+
+        fn(job.blob(), job.size(), hash, ctx, job.height());
+
+        CnCtx::release(ctx, 1);
+    }
+
+    return memcmp(hash, baton.result, sizeof(hash)) == 0 ? SimShareBaton::Valid : SimShareBaton::Invalid;
+}
+
+
+static void writeVarint(uint8_t *out, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = static_cast<uint8_t>((value & 0x7F) | (i + 1 < size ? 0x80 : 0));
+        value >>= 7;
+    }
+}
+
+
+} // namespace xmrig
+
+
+xmrig::SimPool::SimPool(const SimConfig &config) :
+    m_config(config),
+    m_random(std::random_device()())
+{
+    m_jobTimer   = new Timer(this);
+    m_faultTimer = new Timer(this);
+    m_delayTimer = new Timer(this);
+}
+
+
+xmrig::SimPool::~SimPool()
+{
+    drop();
+
+    delete m_jobTimer;
+    delete m_faultTimer;
+    delete m_delayTimer;
+    delete m_server;
+
+    // Shares still in the thread pool are released by the work callback.
+    for (SimShareBaton *baton : m_shares) {
+        baton->owner = nullptr;
+    }
+}
+
+
+bool xmrig::SimPool::start()
+{
+    nextJob();
+
+    if (!listen()) {
+        return false;
+    }
+
+    m_jobTimer->start(m_config.jobInterval(), m_config.jobInterval());
+
+    if (m_config.disconnectInterval()) {
+        m_faultTimer->start(m_config.disconnectInterval(), 0);
+    }
+
+    LOG_INFO("%s" CYAN_BOLD("%s:%u") " algo " WHITE_BOLD("%s") " diff " WHITE_BOLD("%" PRIu64) " job interval " WHITE_BOLD("%" PRIu64 " ms"),
+             tag, m_config.host().isNull() ? "127.0.0.1" : m_config.host().data(), m_config.port(), m_config.algorithm().shortName(),
+             m_config.diff(), m_config.jobInterval());
+
+    return true;
+}
+
+
+void xmrig::SimPool::onConnection(uv_stream_t *stream, uint16_t)
+{
+    auto session = new Session(this, ++m_sequence);
+    if (!session->accept(stream)) {
+        session->detach();
+        session->close();
+
+        return;
+    }
+
+    m_sessions.insert({ session->id(), session });
+}
+
+
+void xmrig::SimPool::onTimer(const Timer *timer)
+{
+    if (timer == m_jobTimer) {
+        nextJob();
+        broadcast();
+
+        for (uint32_t i = 0; i < m_config.flood(); ++i) {
+            nextJob();
+            broadcast();
+        }
+
+        return print();
+    }
+
+    if (timer == m_faultTimer) {
+        if (m_server) {
+            LOG_WARN("%s" YELLOW_BOLD("%u") " drop %zu connection(s), down for %" PRIu64 " ms", tag, m_config.port(), m_sessions.size(), m_config.downTime());
+
+            drop();
+            delete m_server;
+            m_server = nullptr;
+
+            if (m_config.downTime()) {
+                return m_faultTimer->start(m_config.downTime(), 0);
+            }
+        }
+
+        listen();
+
+        return m_faultTimer->start(m_config.disconnectInterval(), 0);
+    }
+
+    const uint64_t now = Chrono::steadyMSecs();
+
+    while (!m_pending.empty() && m_pending.front().due <= now) {
+        auto &pending = m_pending.front();
+        auto it       = m_sessions.find(pending.session);
+
+        if (it != m_sessions.end()) {
+            it->second->write(std::move(pending.data));
+        }
+
+        m_pending.pop_front();
+    }
+
+    if (!m_pending.empty()) {
+        m_delayTimer->start(m_pending.front().due - now, 0);
+    }
+}
+
+
+bool xmrig::SimPool::listen()
+{
+    m_server = new TcpServer(m_config.host(), m_config.port(), this);
+
+    const int rc = m_server->bind();
+    if (rc < 0) {
+        LOG_ERR("%s" RED_BOLD("bind error: \"%s\""), tag, uv_strerror(rc));
+
+        delete m_server;
+        m_server = nullptr;
+
+        return false;
+    }
+
+    return true;
+}
+
+
+xmrig::SimPool::SimJob *xmrig::SimPool::find(const char *id)
+{
+    if (!id) {
+        return nullptr;
+    }
+
+    for (auto &job : m_jobs) {
+        if (job.job.id() == id) {
+            return &job;
+        }
+    }
+
+    return nullptr;
+}
+
+
+void xmrig::SimPool::broadcast()
+{
+    using namespace rapidjson;
+
+    for (auto &kv : m_sessions) {
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        doc.AddMember("jsonrpc", "2.0", allocator);
+        doc.AddMember("method",  "job", allocator);
+        doc.AddMember("params",  toJSON(m_jobs.back(), kv.first, doc), allocator);
+
+        kv.second->write(toString(doc));
+    }
+}
+
+
+void xmrig::SimPool::drop()
+{
+    for (auto &kv : m_sessions) {
+        kv.second->detach();
+        kv.second->close();
+    }
+
+    m_sessions.clear();
+    m_pending.clear();
+}
+
+
+void xmrig::SimPool::nextJob()
+{
+    const auto &algorithm = m_config.algorithm();
+
+    ++m_height;
+
+    if (algorithm.family() == Algorithm::RANDOM_X && (m_seed.isEmpty() || (m_config.seedInterval() && m_height % m_config.seedInterval() == 0))) {
+        m_seed = Buffer::allocUnsafe(Job::kMaxSeedSize);
+
+        for (size_t i = 0; i < m_seed.size(); ++i) {
+            m_seed.data()[i] = static_cast<char>(m_random());
+        }
+
+        LOG_INFO("%s" WHITE_BOLD("%u") " new seed " WHITE_BOLD("%s"), tag, m_config.port(), m_seed.toHex().data());
+    }
+
+    // major and minor version, timestamp, previous block hash, nonce, merkle root and transactions count.
+    uint8_t blob[76]{ 0 };
+    blob[0] = 12;
+    blob[1] = 12;
+    writeVarint(blob + 2, static_cast<uint64_t>(time(nullptr)), 5);
+
+    for (size_t i = 7; i < 39; ++i) {
+        blob[i] = static_cast<uint8_t>(m_random());
+    }
+
+    for (size_t i = 43; i < 75; ++i) {
+        blob[i] = static_cast<uint8_t>(m_random());
+    }
+
+    blob[75] = 1;
+
+    SimJob job;
+    job.blob = Buffer::toHex(blob, sizeof(blob));
+    job.job  = Job(false, algorithm, String());
+    job.job.setId(std::to_string(++m_sequence).c_str());
+    job.job.setBlob(job.blob.data());
+    job.job.setDiff(m_config.diff());
+    job.job.setHeight(m_height);
+
+    if (!m_seed.isEmpty()) {
+        job.job.setSeedHash(m_seed.toHex().data());
+    }
+
+    m_jobs.push_back(std::move(job));
+
+    // Shares for the previous job are still accepted, like real pools do shortly after a job switch.
+    while (m_jobs.size() > 2) {
+        m_jobs.pop_front();
+    }
+}
+
+
+void xmrig::SimPool::onRequest(Session *session, char *line)
+{
+    using namespace rapidjson;
+
+    Document req;
+    if (req.ParseInsitu(line).HasParseError() || !req.IsObject()) {
+        return session->close();
+    }
+
+    const char *method  = Json::getString(req, "method");
+    const Value &id     = Json::getValue(req, "id");
+    const Value &params = Json::getObject(req, "params");
+
+    if (!method || !params.IsObject()) {
+        return session->close();
+    }
+
+    if (strcmp(method, "submit") == 0) {
+        return submit(session, id, params);
+    }
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    doc.AddMember("id",      Value(id, allocator), allocator);
+    doc.AddMember("jsonrpc", "2.0", allocator);
+
+    if (strcmp(method, "login") == 0) {
+        Value extensions(kArrayType);
+        extensions.PushBack("algo", allocator);
+        extensions.PushBack("keepalive", allocator);
+
+        Value result(kObjectType);
+        result.AddMember("id",          Value(std::to_string(session->id()).c_str(), allocator), allocator);
+        result.AddMember("job",         toJSON(m_jobs.back(), session->id(), doc), allocator);
+        result.AddMember("extensions",  extensions, allocator);
+        result.AddMember("status",      "OK", allocator);
+
+        doc.AddMember("error",  kNullType, allocator);
+        doc.AddMember("result", result, allocator);
+    }
+    else if (strcmp(method, "keepalived") == 0) {
+        Value result(kObjectType);
+        result.AddMember("status", "KEEPALIVED", allocator);
+
+        doc.AddMember("error",  kNullType, allocator);
+        doc.AddMember("result", result, allocator);
+    }
+    else {
+        Value obj(kObjectType);
+        obj.AddMember("code",    -1, allocator);
+        obj.AddMember("message", "Unsupported method", allocator);
+
+        doc.AddMember("error",  obj, allocator);
+        doc.AddMember("result", kNullType, allocator);
+    }
+
+    reply(session, toString(doc));
+}
+
+
+void xmrig::SimPool::onShare(const SimShareBaton &baton)
+{
+    const char *error = nullptr;
+
+    if (baton.status == SimShareBaton::Invalid) {
+        m_invalid++;
+        LOG_ERR("%s" RED_BOLD("%u") " invalid share, job %s nonce %s", tag, m_config.port(), baton.job.id().data(),
+                Buffer::toHex(reinterpret_cast<const uint8_t *>(&baton.nonce), sizeof(baton.nonce)).data());
+
+        error = "Invalid share";
+    }
+    else if (*reinterpret_cast<const uint64_t *>(baton.result + 24) >= baton.job.target()) {
+        m_low++;
+
+        error = "Low difficulty share";
+    }
+    else {
+        if (baton.status == SimShareBaton::Unverified) {
+            m_unverified++;
+        }
+
+        m_accepted++;
+    }
+
+    auto it = m_sessions.find(baton.session);
+    if (it != m_sessions.end()) {
+        reply(it->second, baton.id, error);
+    }
+}
+
+
+void xmrig::SimPool::print() const
+{
+    LOG_INFO("%s" WHITE_BOLD("%u") " height " WHITE_BOLD("%" PRIu64) " miners " WHITE_BOLD("%zu") " accepted " GREEN_BOLD("%" PRIu64)
+             " rejected " RED_BOLD("%" PRIu64) " (low %" PRIu64 ", invalid %" PRIu64 ", stale %" PRIu64 ", duplicate %" PRIu64 ") unverified %" PRIu64,
+             tag, m_config.port(), m_height, m_sessions.size(), m_accepted, m_low + m_invalid + m_stale + m_duplicate,
+             m_low, m_invalid, m_stale, m_duplicate, m_unverified);
+}
+
+
+void xmrig::SimPool::reply(Session *session, const rapidjson::Value &id, const char *error)
+{
+    using namespace rapidjson;
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    doc.AddMember("id",      Value(id, allocator), allocator);
+    doc.AddMember("jsonrpc", "2.0", allocator);
+
+    if (error) {
+        Value obj(kObjectType);
+        obj.AddMember("code",    -1, allocator);
+        obj.AddMember("message", StringRef(error), allocator);
+
+        doc.AddMember("error",  obj, allocator);
+        doc.AddMember("result", kNullType, allocator);
+    }
+    else {
+        Value result(kObjectType);
+        result.AddMember("status", "OK", allocator);
+
+        doc.AddMember("error",  kNullType, allocator);
+        doc.AddMember("result", result, allocator);
+    }
+
+    reply(session, toString(doc));
+}
+
+
+void xmrig::SimPool::reply(Session *session, std::string &&data)
+{
+    if (!m_config.delay()) {
+        return session->write(std::move(data));
+    }
+
+    const uint64_t due = Chrono::steadyMSecs() + m_config.delay();
+    if (m_pending.empty()) {
+        m_delayTimer->start(m_config.delay(), 0);
+    }
+
+    m_pending.push_back({ session->id(), due, std::move(data) });
+}
+
+
+/**
+ * Stale, malformed and duplicate shares are rejected immediately, hashes are re-computed in the libuv thread pool
+ * with a separate context and scratchpad, so validation does not delay the jobs and responses being measured.
+ */
+void xmrig::SimPool::submit(Session *session, const rapidjson::Value &id, const rapidjson::Value &params)
+{
+    auto job = find(Json::getString(params, "job_id"));
+    if (!job) {
+        m_stale++;
+
+        return reply(session, id, "Block expired");
+    }
+
+    const char *nonceHex  = Json::getString(params, "nonce");
+    const char *resultHex = Json::getString(params, "result");
+    uint32_t nonce        = 0;
+    uint8_t result[32]{ 0 };
+
+    if (!nonceHex || strlen(nonceHex) != 8 || !Buffer::fromHex(nonceHex, 8, reinterpret_cast<uint8_t *>(&nonce)) ||
+        !resultHex || strlen(resultHex) != 64 || !Buffer::fromHex(resultHex, 64, result)) {
+        m_invalid++;
+
+        return reply(session, id, "Malformed share");
+    }
+
+    if (!job->nonces.insert(nonce).second) {
+        m_duplicate++;
+
+        return reply(session, id, "Duplicate share");
+    }
+
+    auto baton = new SimShareBaton(this, session->id(), id, job->job, nonce, result);
+
+    if (!m_config.isValidate()) {
+        onShare(*baton);
+        delete baton;
+
+        return;
+    }
+
+    m_shares.insert(baton);
+
+    uv_queue_work(uv_default_loop(), &baton->req,
+        [](uv_work_t *req) {
+            auto baton = static_cast<SimShareBaton *>(req->data);
+
+            baton->status = verify(*baton);
+        },
+        [](uv_work_t *req, int) {
+            auto baton = static_cast<SimShareBaton *>(req->data);
+
+            if (baton->owner) {
+                baton->owner->m_shares.erase(baton);
+                baton->owner->onShare(*baton);
+            }
+
+            delete baton;
+        }
+    );
+}
+
+
+rapidjson::Value xmrig::SimPool::toJSON(const SimJob &job, uint64_t session, rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    const uint64_t target = job.job.target();
+
+    Value obj(kObjectType);
+    obj.AddMember("blob",       job.blob.toJSON(doc), allocator);
+    obj.AddMember("job_id",     job.job.id().toJSON(doc), allocator);
+    obj.AddMember("target",     Buffer::toHex(reinterpret_cast<const uint8_t *>(&target), sizeof(target)).toJSON(doc), allocator);
+    obj.AddMember("algo",       StringRef(job.job.algorithm().shortName()), allocator);
+    obj.AddMember("height",     job.job.height(), allocator);
+    obj.AddMember("id",         Value(std::to_string(session).c_str(), allocator), allocator);
+
+    if (!job.job.seed().isEmpty()) {
+        obj.AddMember("seed_hash", job.job.seed().toHex().toJSON(doc), allocator);
+    }
+
+    return obj;
+}
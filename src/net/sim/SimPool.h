@@ -0,0 +1,125 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2019 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2019 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_SIMPOOL_H
+#define XMRIG_SIMPOOL_H
+
+
+#include "base/kernel/interfaces/ITcpServerListener.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Object.h"
+#include "net/sim/SimConfig.h"
+
+
+#include <deque>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+
+namespace xmrig {
+
+
+class SimShareBaton;
+class TcpServer;
+class Timer;
+
+
+/**
+ * Minimal stratum server for offline testing, issues synthetic jobs, checks submitted shares with the CPU hash
+ * functions in the libuv thread pool and optionally injects faults (disconnects with down time, slow responses, job floods, seed changes).
+ */
+class SimPool : public ITcpServerListener, public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(SimPool)
+
+    SimPool(const SimConfig &config);
+    ~SimPool() override;
+
+    bool start();
+
+protected:
+    void onConnection(uv_stream_t *stream, uint16_t port) override;
+    void onTimer(const Timer *timer) override;
+
+private:
+    class Session;
+
+    struct SimJob
+    {
+        Job job;
+        std::set<uint32_t> nonces;
+        String blob;
+    };
+
+    struct Pending
+    {
+        uint64_t session;
+        uint64_t due;
+        std::string data;
+    };
+
+    bool listen();
+    rapidjson::Value toJSON(const SimJob &job, uint64_t session, rapidjson::Document &doc) const;
+    SimJob *find(const char *id);
+    void broadcast();
+    void drop();
+    void nextJob();
+    void onRequest(Session *session, char *line);
+    void onShare(const SimShareBaton &baton);
+    void print() const;
+    void reply(Session *session, const rapidjson::Value &id, const char *error);
+    void reply(Session *session, std::string &&data);
+    void submit(Session *session, const rapidjson::Value &id, const rapidjson::Value &params);
+
+    const SimConfig m_config;
+    Buffer m_seed;
+    std::deque<Pending> m_pending;
+    std::deque<SimJob> m_jobs;
+    std::map<uint64_t, Session *> m_sessions;
+    std::mt19937_64 m_random;
+    std::set<SimShareBaton *> m_shares;
+    TcpServer *m_server         = nullptr;
+    Timer *m_delayTimer         = nullptr;
+    Timer *m_faultTimer         = nullptr;
+    Timer *m_jobTimer           = nullptr;
+    uint64_t m_accepted         = 0;
+    uint64_t m_duplicate        = 0;
+    uint64_t m_height           = 0;
+    uint64_t m_invalid          = 0;
+    uint64_t m_low              = 0;
+    uint64_t m_sequence         = 0;
+    uint64_t m_stale            = 0;
+    uint64_t m_unverified       = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_SIMPOOL_H */